@@ -0,0 +1,195 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // a2048board.hpp
+#pragma once
+
+#include "agamesim.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace almondnamespace::game2048
+{
+    enum class Move : std::uint8_t { Left, Right, Up, Down };
+
+    // Sixteen 4-bit exponents (0 = empty, n = tile 2^n); cell (x, y) lives
+    // at bits 4·(4y + x). A whole row is 16 bits, so moves are table lookups.
+    struct Board
+    {
+        std::uint64_t cells = 0;
+        std::uint32_t score = 0;
+        gamesim::SimRng rng{};
+
+        [[nodiscard]] constexpr int exponent(int x, int y) const noexcept { return int((cells >> (4 * (4 * y + x))) & 0xF); }
+        [[nodiscard]] constexpr int value(int x, int y) const noexcept { const int e = exponent(x, y); return e ? 1 << e : 0; }
+
+        friend constexpr bool operator==(const Board&, const Board&) = default;
+    };
+
+    namespace detail
+    {
+        struct RowTables
+        {
+            std::array<std::uint16_t, 65536> left{};
+            std::array<std::uint16_t, 65536> right{};
+            std::array<std::uint32_t, 65536> score{};
+        };
+
+        [[nodiscard]] constexpr std::uint16_t reverse_row(std::uint32_t row) noexcept
+        {
+            return std::uint16_t(((row & 0xF) << 12) | ((row & 0xF0) << 4) | ((row >> 4) & 0xF0) | (row >> 12));
+        }
+
+        inline const RowTables& row_tables()
+        {
+            static const RowTables tables = [] {
+                RowTables t{};
+                for (std::uint32_t row = 0; row < 65536; ++row)
+                {
+                    std::array<std::uint32_t, 4> line{};
+                    int count = 0;
+                    for (int i = 0; i < 4; ++i)
+                        if (const std::uint32_t e = (row >> (4 * i)) & 0xF)
+                            line[std::size_t(count++)] = e;
+
+                    std::array<std::uint32_t, 4> out{};
+                    std::uint32_t gained = 0;
+                    int write = 0;
+                    for (int i = 0; i < count; ++i)
+                    {
+                        std::uint32_t e = line[std::size_t(i)];
+                        if (i + 1 < count && line[std::size_t(i + 1)] == e && e < 15)
+                        {
+                            ++e;
+                            gained += 1u << e;
+                            ++i;
+                        }
+                        out[std::size_t(write++)] = e;
+                    }
+                    t.left[row] = std::uint16_t(out[0] | (out[1] << 4) | (out[2] << 8) | (out[3] << 12));
+                    t.score[row] = gained;
+                }
+                for (std::uint32_t row = 0; row < 65536; ++row)
+                    t.right[row] = reverse_row(t.left[reverse_row(row)]);
+                return t;
+            }();
+            return tables;
+        }
+
+        // Swaps (x, y) with (y, x) for all sixteen nibbles.
+        [[nodiscard]] constexpr std::uint64_t transpose(std::uint64_t x) noexcept
+        {
+            const std::uint64_t a1 = x & 0xF0F00F0FF0F00F0Full;
+            const std::uint64_t a2 = x & 0x0000F0F00000F0F0ull;
+            const std::uint64_t a3 = x & 0x0F0F00000F0F0000ull;
+            const std::uint64_t a = a1 | (a2 << 12) | (a3 >> 12);
+            const std::uint64_t b1 = a & 0xFF00FF0000FF00FFull;
+            const std::uint64_t b2 = a & 0x00FF00FF00000000ull;
+            const std::uint64_t b3 = a & 0x00000000FF00FF00ull;
+            return b1 | (b2 >> 24) | (b3 << 24);
+        }
+
+        // Left/Right on rows as stored; Up/Down on the transposed board.
+        [[nodiscard]] inline std::uint64_t slide(std::uint64_t cells, Move move, std::uint32_t& gained) noexcept
+        {
+            const RowTables& t = row_tables();
+            const bool vertical = move == Move::Up || move == Move::Down;
+            const auto& table = (move == Move::Left || move == Move::Up) ? t.left : t.right;
+            const std::uint64_t src = vertical ? transpose(cells) : cells;
+            std::uint64_t out = 0;
+            for (int r = 0; r < 4; ++r)
+            {
+                const std::uint32_t row = std::uint32_t(src >> (16 * r)) & 0xFFFF;
+                out |= std::uint64_t(table[row]) << (16 * r);
+                gained += t.score[row];
+            }
+            return vertical ? transpose(out) : out;
+        }
+
+        [[nodiscard]] constexpr std::uint64_t empty_mask(std::uint64_t cells) noexcept
+        {
+            // Low bit of each nibble set where the nibble is zero.
+            std::uint64_t x = cells | (cells >> 1);
+            x |= x >> 2;
+            return ~x & 0x1111111111111111ull;
+        }
+    }
+
+    [[nodiscard]] inline bool can_move(const Board& board) noexcept
+    {
+        if (detail::empty_mask(board.cells))
+            return true;
+        std::uint32_t ignored = 0;
+        return detail::slide(board.cells, Move::Left, ignored) != board.cells
+            || detail::slide(board.cells, Move::Up, ignored) != board.cells;
+    }
+
+    // New tile in a random empty cell: a 2 or a 4 with equal odds.
+    inline void spawn_tile(Board& board) noexcept
+    {
+        std::uint64_t empty = detail::empty_mask(board.cells);
+        const int count = std::popcount(empty);
+        if (count == 0)
+            return;
+        for (std::uint32_t skip = board.rng.below(std::uint32_t(count)); skip; --skip)
+            empty &= empty - 1;
+        const int shift = std::countr_zero(empty);
+        board.cells |= std::uint64_t(1 + board.rng.below(2)) << shift;
+    }
+
+    // ─── Rules for gamesim ────────────────────────────────────────
+    // Reward is the merge score of the move; an unchanged board costs
+    // nothing and spawns nothing. Done once no move can change the board.
+    struct Rules
+    {
+        using State = Board;
+        using Action = Move;
+
+        [[nodiscard]] Board reset(std::uint64_t seed) const
+        {
+            Board board{};
+            board.rng = gamesim::SimRng(seed);
+            spawn_tile(board);
+            spawn_tile(board);
+            return board;
+        }
+
+        gamesim::StepResult step(Board& board, Move move) const
+        {
+            std::uint32_t gained = 0;
+            const std::uint64_t next = detail::slide(board.cells, move, gained);
+            if (next == board.cells)
+                return { 0.0f, !can_move(board) };
+            board.cells = next;
+            board.score += gained;
+            spawn_tile(board);
+            return { float(gained), !can_move(board) };
+        }
+
+        [[nodiscard]] std::size_t action_count() const noexcept { return 4; }
+        [[nodiscard]] Move action(std::size_t i) const noexcept { return static_cast<Move>(i & 3); }
+    };
+
+} // namespace almondnamespace::game2048
@@ -33,6 +33,7 @@
 #include "aspritepool.hpp"
 #include "ascene.hpp"
 #include "aimageloader.hpp"
+#include "a2048board.hpp"
 
 #include <algorithm>
 #include <array>
@@ -47,22 +48,6 @@ namespace almondnamespace::game2048
     constexpr int GRID_W = 4;
     constexpr int GRID_H = 4;
 
-    struct GameState {
-        gamecore::grid_t<int> grid;
-        std::mt19937 rng{ std::random_device{}() };
-
-        GameState() : grid(gamecore::make_grid<int>(GRID_W, GRID_H, 0)) {
-            add_tile(); add_tile();
-        }
-        void add_tile() {
-            for (;;) {
-                int x = rng() % GRID_W, y = rng() % GRID_H;
-                auto& cell = grid[gamecore::idx(GRID_W, x, y)];
-                if (cell == 0) { cell = (rng() % 2 + 1) * 2; break; }
-            }
-        }
-    };
-
     // Optional helper if you want to reset game state when leaving/returning
     inline void reset_2048_state() {
         // Nothing persistent besides the static GameState in run_2048;
@@ -78,7 +63,7 @@ namespace almondnamespace::game2048
         void load() override {
             Scene::load();
             setupSprites();
-            state = {};
+            state = rules.reset(std::random_device{}());
             inputConsumed = false;
             gameOver = false;
         }
@@ -91,126 +76,11 @@ namespace almondnamespace::game2048
             if (almondnamespace::input::is_key_down(almondnamespace::input::Key::Escape))
                 return false;
 
-            enum class Direction { Left, Right, Up, Down };
-
-            auto process_line = [](std::array<int, GRID_W> line) {
-                std::array<int, GRID_W> result{};
-                int write = 0;
-
-                std::array<int, GRID_W> compact{};
-                int compactCount = 0;
-                for (int v : line)
-                    if (v != 0)
-                        compact[compactCount++] = v;
-
-                for (int i = 0; i < compactCount; ++i)
-                {
-                    int val = compact[i];
-                    if (i + 1 < compactCount && compact[i + 1] == val)
-                    {
-                        val *= 2;
-                        ++i;
-                    }
-                    result[write++] = val;
-                }
-
-                return result;
-            };
-
-            auto apply_move = [&](Direction dir) {
-                bool moved = false;
-
-                auto update_cell = [&](int x, int y, int value) {
-                    int& cell = state.grid[gamecore::idx(GRID_W, x, y)];
-                    if (cell != value) {
-                        cell = value;
-                        moved = true;
-                    }
-                };
-
-                auto handle_row = [&](int y, bool reverse) {
-                    std::array<int, GRID_W> line{};
-                    for (int x = 0; x < GRID_W; ++x)
-                        line[x] = state.grid[gamecore::idx(GRID_W, x, y)];
-
-                    if (reverse)
-                        std::reverse(line.begin(), line.end());
-
-                    auto merged = process_line(line);
-
-                    if (reverse)
-                        std::reverse(merged.begin(), merged.end());
-
-                    for (int x = 0; x < GRID_W; ++x)
-                        update_cell(x, y, merged[x]);
-                };
-
-                auto handle_column = [&](int x, bool reverse) {
-                    std::array<int, GRID_H> line{};
-                    for (int y = 0; y < GRID_H; ++y)
-                        line[y] = state.grid[gamecore::idx(GRID_W, x, y)];
-
-                    if (reverse)
-                        std::reverse(line.begin(), line.end());
-
-                    std::array<int, GRID_W> padded{};
-                    for (int i = 0; i < GRID_H; ++i)
-                        padded[i] = line[i];
-
-                    auto merged = process_line(padded);
-
-                    if (reverse)
-                        std::reverse(merged.begin(), merged.begin() + GRID_H);
-
-                    for (int y = 0; y < GRID_H; ++y)
-                        update_cell(x, y, merged[y]);
-                };
-
-                switch (dir) {
-                case Direction::Left:
-                    for (int y = 0; y < GRID_H; ++y)
-                        handle_row(y, false);
-                    break;
-                case Direction::Right:
-                    for (int y = 0; y < GRID_H; ++y)
-                        handle_row(y, true);
-                    break;
-                case Direction::Up:
-                    for (int x = 0; x < GRID_W; ++x)
-                        handle_column(x, false);
-                    break;
-                case Direction::Down:
-                    for (int x = 0; x < GRID_W; ++x)
-                        handle_column(x, true);
-                    break;
-                }
-
-                return moved;
-            };
-
-            auto any_moves_available = [&]() {
-                for (int y = 0; y < GRID_H; ++y) {
-                    for (int x = 0; x < GRID_W; ++x) {
-                        int val = state.grid[gamecore::idx(GRID_W, x, y)];
-                        if (val == 0)
-                            return true;
-                        if (x + 1 < GRID_W && state.grid[gamecore::idx(GRID_W, x + 1, y)] == val)
-                            return true;
-                        if (y + 1 < GRID_H && state.grid[gamecore::idx(GRID_W, x, y + 1)] == val)
-                            return true;
-                    }
-                }
-                return false;
-            };
-
-            auto try_move = [&](Direction dir) {
+            auto try_move = [&](Move move) {
                 if (gameOver)
                     return;
-                if (apply_move(dir)) {
-                    state.add_tile();
-                    if (!any_moves_available())
-                        gameOver = true;
-                }
+                if (rules.step(state, move).done)
+                    gameOver = true;
             };
 
             const bool left = almondnamespace::input::is_key_down(almondnamespace::input::Key::Left);
@@ -221,17 +91,17 @@ namespace almondnamespace::game2048
             const bool any = left || right || up || down;
 
             if (any && !inputConsumed) {
-                if (left)       try_move(Direction::Left);
-                else if (right) try_move(Direction::Right);
-                else if (up)    try_move(Direction::Up);
-                else if (down)  try_move(Direction::Down);
+                if (left)       try_move(Move::Left);
+                else if (right) try_move(Move::Right);
+                else if (up)    try_move(Move::Up);
+                else if (down)  try_move(Move::Down);
                 inputConsumed = true;
             }
             else if (!any) {
                 inputConsumed = false;
             }
 
-            if (!gameOver && !any_moves_available())
+            if (!gameOver && !can_move(state))
                 gameOver = true;
 
             ctx->clear_safe(ctx);
@@ -244,7 +114,7 @@ namespace almondnamespace::game2048
 
             for (int y = 0; y < GRID_H; ++y) {
                 for (int x = 0; x < GRID_W; ++x) {
-                    int val = state.grid[gamecore::idx(GRID_W, x, y)];
+                    const int val = state.value(x, y);
                     if (val == 0)
                         continue;
                     auto it = sprites.find(val);
@@ -268,7 +138,7 @@ namespace almondnamespace::game2048
     private:
         void setupSprites() {
             sprites.clear();
-            const bool createdAtlas = atlasmanager::create_atlas({
+            atlasmanager::create_atlas({
                 .name = "2048_atlas",
                 .width = 256,
                 .height = 256,
@@ -278,36 +148,24 @@ namespace almondnamespace::game2048
             if (!registrar)
                 throw std::runtime_error("[2048] Missing atlas registrar");
 
-            TextureAtlas& atlas = registrar->atlas;
-            bool registeredAny = false;
-
+            std::vector<atlasmanager::AtlasRegistrar::SpriteFile> files;
+            std::vector<int> values;
             for (int val = 2; val <= 2048; val <<= 1) {
-                std::string name = std::to_string(val);
-                if (auto existing = atlasmanager::registry.get(name)) {
-                    auto handle = std::get<0>(*existing);
-                    if (spritepool::is_alive(handle)) {
-                        sprites[val] = handle;
-                        continue;
-                    }
-                }
-                auto img = a_loadImage("assets/2048/" + name + ".ppm", false);
-                if (img.pixels.empty())
-                    throw std::runtime_error("[2048] Missing image " + name + ".ppm");
-                auto handleOpt = registrar->register_atlas_sprites_by_image(
-                    name, img.pixels, img.width, img.height, atlas);
-                if (!handleOpt || !spritepool::is_alive(*handleOpt))
-                    throw std::runtime_error("[2048] Failed to register sprite " + name);
-                sprites[val] = *handleOpt;
-                registeredAny = true;
+                const std::string name = std::to_string(val);
+                files.push_back({ name, "assets/2048/" + name + ".ppm" });
+                values.push_back(val);
             }
 
-            if (createdAtlas || registeredAny) {
-                atlas.rebuild_pixels();
-                atlasmanager::ensure_uploaded(atlas);
+            const auto handles = registrar->load_atlas_sprites(files);
+            for (size_t i = 0; i < handles.size(); ++i) {
+                if (!handles[i] || !spritepool::is_alive(*handles[i]))
+                    throw std::runtime_error("[2048] Failed to register sprite " + files[i].name);
+                sprites[values[i]] = *handles[i];
             }
         }
 
-        GameState state{};
+        Rules rules{};
+        Board state{};
         std::unordered_map<int, SpriteHandle> sprites{};
         bool inputConsumed = false;
         bool gameOver = false;
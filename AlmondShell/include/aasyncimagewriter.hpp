@@ -0,0 +1,245 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // aasyncimagewriter.hpp
+#pragma once
+
+#include "aplatform.hpp"
+#include "aimagewriter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace almondnamespace::imagewriter
+{
+    // What submit() does when the queue is full. Block keeps every frame
+    // (deterministic captures); DropNewest never stalls the producer, for
+    // captures taken while frame times are being measured.
+    enum class OverflowPolicy { Block, DropNewest };
+
+    struct WriteJob
+    {
+        std::filesystem::path path;
+        std::vector<uint8_t> pixels;    // RGBA8, owned by the job
+        int width = 0;
+        int height = 0;
+        bool flipVertically = false;
+        int pngCompressionLevel = 6;
+    };
+
+    struct WriterStats
+    {
+        uint64_t written = 0;
+        uint64_t failed = 0;
+        uint64_t dropped = 0;
+        double encodeMs = 0.0;          // total time spent on the writer thread
+    };
+
+    // Single background thread draining a bounded queue of encode+write
+    // jobs. The producer only pays for moving the pixel buffer in.
+    class AsyncImageWriter
+    {
+    public:
+        explicit AsyncImageWriter(size_t capacity = 8, OverflowPolicy policy = OverflowPolicy::Block)
+            : capacity_((std::max)(size_t{ 1 }, capacity)), policy_(policy)
+        {
+            worker_ = std::thread([this] { run(); });
+        }
+
+        ~AsyncImageWriter()
+        {
+            {
+                std::scoped_lock lock(mutex_);
+                stopping_ = true;
+            }
+            notEmpty_.notify_all();
+            notFull_.notify_all();
+            if (worker_.joinable())
+                worker_.join();
+        }
+
+        AsyncImageWriter(const AsyncImageWriter&) = delete;
+        AsyncImageWriter& operator=(const AsyncImageWriter&) = delete;
+
+        void set_policy(OverflowPolicy policy)
+        {
+            std::scoped_lock lock(mutex_);
+            policy_ = policy;
+        }
+
+        // Returns false if the job was dropped (full queue under DropNewest,
+        // or the writer is shutting down).
+        bool submit(WriteJob job)
+        {
+            {
+                std::unique_lock lock(mutex_);
+                if (policy_ == OverflowPolicy::DropNewest && queue_.size() >= capacity_) {
+                    ++stats_.dropped;
+                    return false;
+                }
+                notFull_.wait(lock, [&] { return stopping_ || queue_.size() < capacity_; });
+                if (stopping_) {
+                    ++stats_.dropped;
+                    return false;
+                }
+                queue_.push_back(std::move(job));
+            }
+            notEmpty_.notify_one();
+            return true;
+        }
+
+        bool submit(std::filesystem::path path, std::vector<uint8_t> pixels, int width, int height,
+            bool flipVertically = false, int pngCompressionLevel = 6)
+        {
+            return submit(WriteJob{ std::move(path), std::move(pixels), width, height, flipVertically, pngCompressionLevel });
+        }
+
+        // Blocks until every job submitted so far has been written.
+        void flush()
+        {
+            std::unique_lock lock(mutex_);
+            idle_.wait(lock, [&] { return queue_.empty() && !busy_; });
+        }
+
+        [[nodiscard]] WriterStats stats() const
+        {
+            std::scoped_lock lock(mutex_);
+            return stats_;
+        }
+
+    private:
+        void run()
+        {
+            std::unique_lock lock(mutex_);
+            for (;;) {
+                notEmpty_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty())
+                    return; // stopping with nothing left to write
+
+                WriteJob job = std::move(queue_.front());
+                queue_.pop_front();
+                busy_ = true;
+                lock.unlock();
+                notFull_.notify_one();
+
+                const auto start = std::chrono::steady_clock::now();
+                bool ok = false;
+                try {
+                    ok = a_writeImage(job.path, job.pixels, job.width, job.height,
+                        job.flipVertically, job.pngCompressionLevel);
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "[ImageWriter] " << e.what() << "\n";
+                }
+                if (!ok)
+                    std::cerr << "[ImageWriter] Failed to write '" << job.path.string() << "'\n";
+                const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+                lock.lock();
+                busy_ = false;
+                ++(ok ? stats_.written : stats_.failed);
+                stats_.encodeMs += ms;
+                if (queue_.empty())
+                    idle_.notify_all();
+            }
+        }
+
+        const size_t capacity_;
+        OverflowPolicy policy_;
+        mutable std::mutex mutex_;
+        std::condition_variable notEmpty_;
+        std::condition_variable notFull_;
+        std::condition_variable idle_;
+        std::deque<WriteJob> queue_;
+        WriterStats stats_{};
+        bool busy_ = false;
+        bool stopping_ = false;
+        std::thread worker_;
+    };
+
+    // Process-wide writer used for atlas dumps and frame captures.
+    inline AsyncImageWriter& default_writer()
+    {
+        static AsyncImageWriter writer{};
+        return writer;
+    }
+
+    // Video-style numbered output: <dir>/<prefix>_000000<ext>, one file per
+    // submitted frame, all encoded off the calling thread.
+    class FrameSequence
+    {
+    public:
+        FrameSequence(std::filesystem::path directory, std::string prefix = "frame",
+            std::string extension = ".png", int pngCompressionLevel = 1,
+            AsyncImageWriter& writer = default_writer())
+            : directory_(std::move(directory)), prefix_(std::move(prefix)), extension_(std::move(extension)),
+            pngCompressionLevel_(pngCompressionLevel), writer_(&writer)
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(directory_, ec);
+            if (ec)
+                std::cerr << "[ImageWriter] Cannot create '" << directory_.string() << "': " << ec.message() << "\n";
+        }
+
+        [[nodiscard]] std::filesystem::path path_for(uint64_t frame) const
+        {
+            return directory_ / std::format("{}_{:06}{}", prefix_, frame, extension_);
+        }
+
+        // Submits the next frame; returns false if the writer dropped it.
+        bool push(std::vector<uint8_t> rgba, int width, int height, bool flipVertically = false)
+        {
+            return writer_->submit(path_for(next_++), std::move(rgba), width, height, flipVertically, pngCompressionLevel_);
+        }
+
+        // Submits under an explicit frame number (e.g. the simulation frame).
+        bool push_at(uint64_t frame, std::vector<uint8_t> rgba, int width, int height, bool flipVertically = false)
+        {
+            next_ = frame + 1;
+            return writer_->submit(path_for(frame), std::move(rgba), width, height, flipVertically, pngCompressionLevel_);
+        }
+
+        void flush() { writer_->flush(); }
+
+        [[nodiscard]] uint64_t next_frame() const noexcept { return next_; }
+
+    private:
+        std::filesystem::path directory_;
+        std::string prefix_;
+        std::string extension_;
+        int pngCompressionLevel_ = 1;
+        AsyncImageWriter* writer_ = nullptr;
+        uint64_t next_ = 0;
+    };
+}
@@ -31,13 +31,16 @@
 #include "acontexttype.hpp"
 
 #include <atomic>
+#include <filesystem>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <queue>
 #include <shared_mutex>
+#include <span>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -58,6 +61,8 @@ namespace almondnamespace::atlasmanager
 
     inline std::atomic<int> nextAtlasIndex = 0; // unique atlas id allocator
 
+    inline void ensure_uploaded(const TextureAtlas& atlas);
+
     // --- Global atlas vector for direct atlasIndex lookup ---
     inline std::vector<const TextureAtlas*> atlas_vector;
 
@@ -219,6 +224,132 @@ namespace almondnamespace::atlasmanager
 
             return handle;
         }
+
+        // ─── Bulk registration ────────────────────────────────────────
+        struct SpriteImage
+        {
+            std::string name;
+            const ImageData* image = nullptr;
+        };
+
+        struct SpriteFile
+        {
+            std::string name;
+            std::filesystem::path path;
+            bool flipVertically = false;
+        };
+
+        // Registers a whole sprite set into this registrar's atlas: one atlas
+        // lock to pack and blit, one registry lock, and a single upload
+        // request. Names that already map to a live handle are reused
+        // untouched. Handles come back in input order; nullopt marks a sprite
+        // that could not be registered.
+        std::vector<std::optional<SpriteHandle>> register_atlas_sprites_by_images(std::span<const SpriteImage> sprites)
+        {
+            std::vector<std::optional<SpriteHandle>> handles(sprites.size());
+            std::vector<size_t> pendingIndex;
+            std::vector<AtlasEntryRequest> requests;
+
+            for (size_t i = 0; i < sprites.size(); ++i) {
+                if (auto existing = registry.get(sprites[i].name)) {
+                    const auto handle = std::get<0>(*existing);
+                    if (spritepool::is_alive(handle)) {
+                        handles[i] = handle;
+                        continue;
+                    }
+                    registry.remove(sprites[i].name);
+                }
+
+                const ImageData* img = sprites[i].image;
+                if (!img || img->pixels.empty()) {
+                    std::cerr << "[AtlasRegistrar] No pixels for '" << sprites[i].name << "'\n";
+                    continue;
+                }
+                pendingIndex.push_back(i);
+                requests.push_back({ sprites[i].name, img->pixels,
+                    static_cast<u32>(img->width), static_cast<u32>(img->height) });
+            }
+
+            if (requests.empty())
+                return handles;
+
+            const auto placed = atlas.add_entries(requests);
+
+            std::vector<SpriteRegistry::BatchEntry> batch;
+            batch.reserve(placed.size());
+            for (size_t r = 0; r < placed.size(); ++r) {
+                if (!placed[r])
+                    continue;
+
+                const std::string& name = sprites[pendingIndex[r]].name;
+                auto allocated = allocate();
+                if (!allocated.is_valid()) {
+                    std::cerr << "[AtlasRegistrar] Failed to allocate spritepool handle for '" << name << "'\n";
+                    continue;
+                }
+
+                const SpriteHandle handle{
+                    allocated.id,
+                    allocated.generation,
+                    static_cast<uint32_t>(atlas.index),
+                    static_cast<uint32_t>(placed[r]->index)
+                };
+                const auto& region = placed[r]->region;
+                batch.push_back({ name, handle, region.u1, region.v1,
+                    region.u2 - region.u1, region.v2 - region.v1 });
+                handles[pendingIndex[r]] = handle;
+            }
+
+            registry.add_batch(batch);
+            ensure_uploaded(atlas);
+            return handles;
+        }
+
+        // Loads and registers a sprite set: images whose names are not yet
+        // registered are decoded in parallel on the worker pool (each
+        // distinct file once), then registered in one batch.
+        std::vector<std::optional<SpriteHandle>> load_atlas_sprites(std::span<const SpriteFile> files)
+        {
+            std::vector<std::filesystem::path> paths;
+            std::vector<bool> flips;
+            std::vector<size_t> imageFor(files.size(), std::numeric_limits<size_t>::max());
+
+            for (size_t i = 0; i < files.size(); ++i) {
+                if (auto existing = registry.get(files[i].name);
+                    existing && spritepool::is_alive(std::get<0>(*existing)))
+                    continue;
+
+                for (size_t p = 0; p < paths.size(); ++p) {
+                    if (paths[p] == files[i].path && flips[p] == files[i].flipVertically) {
+                        imageFor[i] = p;
+                        break;
+                    }
+                }
+                if (imageFor[i] == std::numeric_limits<size_t>::max()) {
+                    imageFor[i] = paths.size();
+                    paths.push_back(files[i].path);
+                    flips.push_back(files[i].flipVertically);
+                }
+            }
+
+            std::vector<ImageData> images(paths.size(), ImageData({}, 0, 0, 4));
+            scheduler_parallel_for(paths.size(), [&](size_t p) {
+                try {
+                    images[p] = a_loadImage(paths[p], flips[p]);
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "[AtlasRegistrar] " << e.what() << "\n";
+                }
+            });
+
+            std::vector<SpriteImage> sprites;
+            sprites.reserve(files.size());
+            for (size_t i = 0; i < files.size(); ++i) {
+                const bool loaded = imageFor[i] != std::numeric_limits<size_t>::max();
+                sprites.push_back({ files[i].name, loaded ? &images[imageFor[i]] : nullptr });
+            }
+            return register_atlas_sprites_by_images(sprites);
+        }
     };
 
     inline std::unordered_map<std::string, std::unique_ptr<AtlasRegistrar>> registrar_map;
@@ -28,13 +28,18 @@
 #include "atexture.hpp"
 #include "aimageloader.hpp"
 
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdint>
 #include <optional>
+#include <numeric>
+#include <span>
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
+#include <deque>
 #include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
@@ -72,6 +77,51 @@ namespace almondnamespace
         }
     };
 
+    // One image for TextureAtlas::add_entries. Pixels are tightly packed RGBA8.
+    struct AtlasEntryRequest
+    {
+        std::string_view name;
+        std::span<const u8> pixels;
+        u32 width = 0;
+        u32 height = 0;
+    };
+
+    // Pixel rectangle inside an atlas; an empty rect means "nothing changed".
+    struct AtlasRect
+    {
+        u32 x = 0;
+        u32 y = 0;
+        u32 width = 0;
+        u32 height = 0;
+
+        [[nodiscard]] bool empty() const noexcept { return width == 0 || height == 0; }
+
+        [[nodiscard]] AtlasRect united(const AtlasRect& o) const noexcept
+        {
+            if (empty()) return o;
+            if (o.empty()) return *this;
+            const u32 x0 = (std::min)(x, o.x);
+            const u32 y0 = (std::min)(y, o.y);
+            const u32 x1 = (std::max)(x + width, o.x + o.width);
+            const u32 y1 = (std::max)(y + height, o.y + o.height);
+            return { x0, y0, x1 - x0, y1 - y0 };
+        }
+    };
+
+    // Result of TextureAtlas::dirty_since: the pixels that changed between
+    // the caller's version and `version`.
+    struct AtlasDirtyRegion
+    {
+        AtlasRect rect{};
+        u64 version = 0;
+    };
+
+    struct AtlasPlacement
+    {
+        int index = -1;
+        AtlasRegion region{};
+    };
+
     struct AtlasConfig 
     {
         std::string name;
@@ -79,8 +129,21 @@ namespace almondnamespace
         u32 height = 2048;
         bool generate_mipmaps = false;
         int index = 0; // <-- NEW: so you can assign index at creation
+
+        // Alpha holds a signed distance (stb_truetype SDF encoding) rather
+        // than coverage; backends threshold it at `distance_field_edge`.
+        bool distance_field = false;
+        u8 distance_field_edge = 128;
+        float distance_field_scale = 32.0f; // alpha units per texel of distance
     };
 
+    struct TextureAtlas;
+
+    // Installed by the texture residency tracker. Called when an atlas is
+    // destroyed or overwritten, so state keyed by its address (GPU textures,
+    // LRU entries) is dropped before that address can belong to another atlas.
+    inline std::atomic<void (*)(const TextureAtlas*)> atlas_released_hook{ nullptr };
+
     struct TextureAtlas 
     {
         std::string name;
@@ -88,6 +151,9 @@ namespace almondnamespace
         u32 width = 0;
         u32 height = 0;
         bool has_mipmaps = false;
+        bool distance_field = false;
+        u8 distance_field_edge = 128;
+        float distance_field_scale = 32.0f;
 
         mutable u64 version = 0;
         mutable std::vector<u8> pixel_data;
@@ -106,6 +172,9 @@ namespace almondnamespace
             width(other.width),
             height(other.height),
             has_mipmaps(other.has_mipmaps),
+            distance_field(other.distance_field),
+            distance_field_edge(other.distance_field_edge),
+            distance_field_scale(other.distance_field_scale),
             version(other.version),
             pixel_data(other.pixel_data),
             entries(other.entries),
@@ -117,11 +186,16 @@ namespace almondnamespace
         TextureAtlas& operator=(const TextureAtlas& other)
         {
             if (this != &other) {
+                if (auto hook = atlas_released_hook.load(std::memory_order_acquire))
+                    hook(this);
                 name = other.name;
                 index = other.index;
                 width = other.width;
                 height = other.height;
                 has_mipmaps = other.has_mipmaps;
+                distance_field = other.distance_field;
+                distance_field_edge = other.distance_field_edge;
+                distance_field_scale = other.distance_field_scale;
                 version = other.version;
                 pixel_data = other.pixel_data;
                 entries = other.entries;
@@ -131,6 +205,11 @@ namespace almondnamespace
             return *this;
         }
 
+        ~TextureAtlas()
+        {
+            if (auto hook = atlas_released_hook.load(std::memory_order_acquire))
+                hook(this);
+        }
 
         [[nodiscard]] size_t entry_count() const noexcept
         {
@@ -169,6 +248,9 @@ namespace almondnamespace
             atlas.width = config.width;
             atlas.height = config.height;
             atlas.has_mipmaps = config.generate_mipmaps;
+            atlas.distance_field = config.distance_field;
+            atlas.distance_field_edge = config.distance_field_edge;
+            atlas.distance_field_scale = config.distance_field_scale;
             atlas.pixel_data.resize(static_cast<size_t>(atlas.width) * atlas.height * 4, 0);
             atlas.occupancy.assign(atlas.height, std::vector<bool>(atlas.width, false));
 #if defined(DEBUG_TEXTURE_RENDERING_VERBOSE)
@@ -245,6 +327,7 @@ namespace almondnamespace
             entries.push_back(entry);
             lookup.emplace(id, region);
             ++version;
+            record_dirty_locked({ x, y, tex.width, tex.height });
 #if defined(DEBUG_TEXTURE_RENDERING_VERBOSE)
             std::cerr << "[Atlas] Added '" << id << "' at (" << x << ", " << y
                 << ") EntryIndex=" << entryIndex << "\n";
@@ -252,6 +335,81 @@ namespace almondnamespace
             return entry;
         }
 
+        // Packs a whole batch under one exclusive lock and bumps `version`
+        // once. Tallest images are placed first, which packs noticeably
+        // tighter than arrival order with the first-fit scan; results are
+        // returned in request order (nullopt where an entry was rejected).
+        std::vector<std::optional<AtlasPlacement>> add_entries(std::span<const AtlasEntryRequest> requests)
+        {
+            std::vector<std::optional<AtlasPlacement>> placed(requests.size());
+
+            std::vector<size_t> order(requests.size());
+            std::iota(order.begin(), order.end(), size_t{ 0 });
+            std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                return requests[a].height != requests[b].height
+                    ? requests[a].height > requests[b].height
+                    : requests[a].width > requests[b].width;
+            });
+
+            std::unique_lock<std::shared_mutex> lock(entriesMutex);
+            const size_t stride = static_cast<size_t>(width) * 4;
+            bool addedAny = false;
+            AtlasRect touched{};
+
+            for (const size_t i : order) {
+                const auto& req = requests[i];
+                const std::string id(req.name);
+                const size_t rowBytes = static_cast<size_t>(req.width) * 4;
+
+                if (req.width == 0 || req.height == 0 || req.pixels.size() < rowBytes * req.height) {
+                    std::cerr << "[Atlas] Rejected empty texture '" << id << "'\n";
+                    continue;
+                }
+                if (lookup.contains(id)) {
+                    std::cerr << "[Atlas] Duplicate ID: '" << id << "'\n";
+                    continue;
+                }
+
+                auto pos = try_pack(req.width, req.height);
+                if (!pos) {
+                    std::cerr << "[Atlas] Failed to pack '" << id << "'\n";
+                    continue;
+                }
+
+                auto [x, y] = *pos;
+                for (u32 row = 0; row < req.height; ++row) {
+                    std::copy_n(req.pixels.data() + row * rowBytes, rowBytes,
+                        pixel_data.data() + (y + row) * stride + size_t(x) * 4);
+                }
+
+                AtlasRegion region{
+                    .u1 = static_cast<float>(x) / width,
+                    .v1 = static_cast<float>(height - (y + req.height)) / height,
+                    .u2 = static_cast<float>(x + req.width) / width,
+                    .v2 = static_cast<float>(height - y) / height,
+                    .x = x,
+                    .y = y,
+                    .width = req.width,
+                    .height = req.height
+                };
+
+                const int entryIndex = static_cast<int>(entries.size());
+                entries.emplace_back(entryIndex, id, region,
+                    std::vector<u8>(req.pixels.begin(), req.pixels.begin() + rowBytes * req.height),
+                    req.width, req.height);
+                lookup.emplace(id, region);
+                placed[i] = AtlasPlacement{ entryIndex, region };
+                touched = touched.united({ x, y, req.width, req.height });
+                addedAny = true;
+            }
+
+            if (addedAny) {
+                ++version;
+                record_dirty_locked(touched);
+            }
+            return placed;
+        }
+
                 /// Adds a slice entry without new pixel data, just references existing pixels.
         std::optional<AtlasEntry> add_slice_entry(const std::string& id, int x, int y, int w, int h)
         {
@@ -294,6 +452,7 @@ namespace almondnamespace
             entries.emplace_back(entry);
             lookup.emplace(id, region);
             ++version;
+            record_dirty_locked({});
 
 #if defined(DEBUG_TEXTURE_RENDERING_VERBOSE)
             std::cerr << "[Atlas] Added slice entry '" << id << "' at ("
@@ -304,6 +463,124 @@ namespace almondnamespace
             return entry;
         }
 
+        // ─── Caller-placed entries ────────────────────────────────────
+        // For owners that run their own allocator over the atlas (the
+        // dynamic glyph cache): pixels go exactly at `rect`, bypassing the
+        // first-fit packer, and an entry can later be rewritten in place so
+        // sprite handles pointing at its index stay valid.
+        std::optional<int> place_entry(const std::string& id, AtlasRect rect, std::span<const u8> pixels)
+        {
+            std::unique_lock<std::shared_mutex> lock(entriesMutex);
+            if (!fits_locked(rect, pixels) || lookup.contains(id))
+                return std::nullopt;
+
+            const int entryIndex = static_cast<int>(entries.size());
+            const AtlasRegion region = make_region(rect);
+            entries.emplace_back(entryIndex, id, region,
+                std::vector<u8>(pixels.begin(), pixels.begin() + size_t(rect.width) * rect.height * 4),
+                rect.width, rect.height);
+            lookup.emplace(id, region);
+            write_rect_locked(rect, pixels);
+            return entryIndex;
+        }
+
+        bool replace_entry(int entryIndex, const std::string& id, AtlasRect rect, std::span<const u8> pixels)
+        {
+            std::unique_lock<std::shared_mutex> lock(entriesMutex);
+            if (entryIndex < 0 || static_cast<size_t>(entryIndex) >= entries.size() || !fits_locked(rect, pixels))
+                return false;
+
+            auto& entry = entries[static_cast<size_t>(entryIndex)];
+            if (entry.name != id && lookup.contains(id))
+                return false;
+
+            lookup.erase(entry.name);
+            entry.name = id;
+            entry.region = make_region(rect);
+            entry.pixels.assign(pixels.begin(), pixels.begin() + size_t(rect.width) * rect.height * 4);
+            entry.texWidth = rect.width;
+            entry.texHeight = rect.height;
+            lookup.emplace(id, entry.region);
+            write_rect_locked(rect, pixels);
+            return true;
+        }
+
+        // Rewrites rows [firstRow, firstRow + rowCount) of an entry in place;
+        // backends that track dirty rects re-upload just that band.
+        bool update_entry_rows(int entryIndex, u32 firstRow, u32 rowCount, std::span<const u8> pixels)
+        {
+            std::unique_lock<std::shared_mutex> lock(entriesMutex);
+            if (entryIndex < 0 || static_cast<size_t>(entryIndex) >= entries.size())
+                return false;
+
+            auto& entry = entries[static_cast<size_t>(entryIndex)];
+            const u32 w = entry.region.width;
+            const size_t rowBytes = static_cast<size_t>(w) * 4;
+            if (rowCount == 0 || firstRow + rowCount > entry.region.height
+                || pixels.size() < rowBytes * rowCount
+                || entry.pixels.size() < rowBytes * entry.region.height)
+                return false;
+
+            std::copy_n(pixels.data(), rowBytes * rowCount, entry.pixels.data() + rowBytes * firstRow);
+            write_rect_locked({ entry.region.x, entry.region.y + firstRow, w, rowCount }, pixels);
+            return true;
+        }
+
+        // Enlarges the atlas keeping every entry at its pixel position; UVs
+        // are recomputed for the new size and backends see a full upload.
+        bool grow(u32 newWidth, u32 newHeight)
+        {
+            std::unique_lock<std::shared_mutex> lock(entriesMutex);
+            if (newWidth < width || newHeight < height)
+                return false;
+            if (newWidth == width && newHeight == height)
+                return true;
+
+            std::vector<u8> grown(static_cast<size_t>(newWidth) * newHeight * 4, 0);
+            const size_t oldStride = static_cast<size_t>(width) * 4;
+            const size_t newStride = static_cast<size_t>(newWidth) * 4;
+            if (pixel_data.size() >= oldStride * height) {
+                for (u32 row = 0; row < height; ++row)
+                    std::copy_n(pixel_data.data() + row * oldStride, oldStride, grown.data() + row * newStride);
+            }
+
+            for (auto& row : occupancy)
+                row.resize(newWidth, false);
+            occupancy.resize(newHeight, std::vector<bool>(newWidth, false));
+
+            width = newWidth;
+            height = newHeight;
+            pixel_data = std::move(grown);
+            for (auto& entry : entries) {
+                entry.region = make_region({ entry.region.x, entry.region.y, entry.region.width, entry.region.height });
+                lookup[entry.name] = entry.region;
+            }
+
+            ++version;
+            dirtyHistory.clear();
+            return true;
+        }
+
+        // Union of every pixel written after `fromVersion`, or nullopt when
+        // that history is no longer known (the atlas was rebuilt or resized,
+        // or too many edits happened since) and the caller must re-upload
+        // everything.
+        [[nodiscard]] std::optional<AtlasDirtyRegion> dirty_since(u64 fromVersion) const
+        {
+            std::shared_lock<std::shared_mutex> lock(entriesMutex);
+            if (fromVersion == version)
+                return AtlasDirtyRegion{ {}, version };
+            if (fromVersion > version || dirtyHistory.empty() || dirtyHistory.front().first > fromVersion + 1)
+                return std::nullopt;
+
+            AtlasRect rect{};
+            for (const auto& [v, r] : dirtyHistory) {
+                if (v > fromVersion)
+                    rect = rect.united(r);
+            }
+            return AtlasDirtyRegion{ rect, version };
+        }
+
         std::optional<AtlasRegion> get_region(const std::string& id) const {
             std::shared_lock<std::shared_mutex> lock(entriesMutex);
             auto it = lookup.find(id);
@@ -347,6 +624,7 @@ namespace almondnamespace
             }
 
             ++version;
+            dirtyHistory.clear();
         }
 
     private:
@@ -354,6 +632,53 @@ namespace almondnamespace
         std::unordered_map<std::string, AtlasRegion> lookup;
         std::vector<std::vector<bool>> occupancy;
 
+        // (version, rect written by the edit that produced it), oldest first.
+        // Lets a backend that is a few versions behind upload one sub-rect
+        // instead of the whole atlas.
+        static constexpr size_t DirtyHistoryLimit = 64;
+        mutable std::deque<std::pair<u64, AtlasRect>> dirtyHistory;
+
+        void record_dirty_locked(AtlasRect rect) const
+        {
+            dirtyHistory.emplace_back(version, rect);
+            if (dirtyHistory.size() > DirtyHistoryLimit)
+                dirtyHistory.pop_front();
+        }
+
+        AtlasRegion make_region(AtlasRect r) const noexcept
+        {
+            return AtlasRegion{
+                .u1 = static_cast<float>(r.x) / width,
+                .v1 = static_cast<float>(height - (r.y + r.height)) / height,
+                .u2 = static_cast<float>(r.x + r.width) / width,
+                .v2 = static_cast<float>(height - r.y) / height,
+                .x = r.x,
+                .y = r.y,
+                .width = r.width,
+                .height = r.height
+            };
+        }
+
+        bool fits_locked(AtlasRect rect, std::span<const u8> pixels) const noexcept
+        {
+            return !rect.empty()
+                && rect.x + rect.width <= width && rect.y + rect.height <= height
+                && pixels.size() >= size_t(rect.width) * rect.height * 4
+                && pixel_data.size() >= size_t(width) * height * 4;
+        }
+
+        void write_rect_locked(AtlasRect rect, std::span<const u8> pixels)
+        {
+            const size_t stride = static_cast<size_t>(width) * 4;
+            const size_t rowBytes = static_cast<size_t>(rect.width) * 4;
+            for (u32 row = 0; row < rect.height; ++row)
+                std::copy_n(pixels.data() + row * rowBytes, rowBytes,
+                    pixel_data.data() + (rect.y + row) * stride + size_t(rect.x) * 4);
+            mark_used(rect.x, rect.y, rect.width, rect.height);
+            ++version;
+            record_dirty_locked(rect);
+        }
+
         std::optional<std::pair<u32, u32>> try_pack(u32 w, u32 h) {
             for (u32 y = 0; y + h <= height; ++y) {
                 for (u32 x = 0; x + w <= width; ++x) {
@@ -382,4 +707,18 @@ namespace almondnamespace
 
     };
 
+    // Copies the pixels of `rect` into a tightly packed RGBA buffer, for
+    // upload APIs that cannot take a source row length (SFML, Raylib).
+    [[nodiscard]] inline std::vector<u8> pack_rect(const TextureAtlas& atlas, const AtlasRect& rect)
+    {
+        std::vector<u8> packed(static_cast<size_t>(rect.width) * rect.height * 4);
+        const size_t rowBytes = static_cast<size_t>(rect.width) * 4;
+        for (u32 row = 0; row < rect.height; ++row) {
+            const u8* src = atlas.pixel_data.data()
+                + (static_cast<size_t>(rect.y + row) * atlas.width + rect.x) * 4;
+            std::copy_n(src, rowBytes, packed.data() + row * rowBytes);
+        }
+        return packed;
+    }
+
 } // namespace almondnamespace
@@ -33,9 +33,14 @@
 #include "aspritepool.hpp"
 #include "ascene.hpp"
 #include "aimageloader.hpp"
+#include "alifeboard.hpp"
+#include "alifeworld.hpp"
+#include "agridtexture.hpp"
 
+#include <bit>
 #include <random>
 #include <iostream>
+#include <string>
 #include <vector>
 #include <span>
 #include <stdexcept>
@@ -44,17 +49,54 @@ namespace almondnamespace::cellular {
 
     constexpr int W = 80, H = 60;
 
+    struct CellularConfig {
+        int width = W;                 // up to LifeBoard::MaxDimension
+        int height = H;
+        std::string rule = "B3/S23";
+        bool wrap = false;             // torus instead of dead borders
+        double density = 0.2;          // initial random fill
+        bool unbounded = false;        // chunked world; width×height is then the seeded/drawn viewport
+    };
+
     struct CellularScene : public scene::Scene {
-        CellularScene(Logger* L = nullptr, time::Timer* C = nullptr)
-            : Scene(L, C)
+        CellularScene(Logger* L = nullptr, time::Timer* C = nullptr, CellularConfig cfg = {})
+            : Scene(L, C), config(std::move(cfg))
         {
         }
 
         void load() override {
             Scene::load();
             setupSprites();
-            grid = gamecore::make_grid<bool>(W, H, false);
-            seedRandom();
+            if (auto parsed = LifeRule::parse(config.rule)) {
+                rule = *parsed;
+            }
+            else {
+                std::cerr << "[Cellular] Unknown rule '" << config.rule << "', using B3/S23\n";
+                rule = {};
+            }
+            if (config.unbounded) {
+                world.clear();
+                std::mt19937_64 rng{ std::random_device{}() };
+                std::bernoulli_distribution d{ std::clamp(config.density, 0.0, 1.0) };
+                for (int y = 0; y < config.height; ++y)
+                    for (int x = 0; x < config.width; ++x)
+                        if (d(rng)) world.set(x, y, true);
+                board = {};
+            }
+            else {
+                board.resize(config.width, config.height, config.wrap);
+                board.randomize(std::random_device{}(), config.density);
+            }
+
+            // Boards past the texture limit are shown downsampled: a texel
+            // is lit when any cell in its block is alive.
+            const int viewW = config.unbounded ? (std::max)(1, config.width) : board.width();
+            const int viewH = config.unbounded ? (std::max)(1, config.height) : board.height();
+            const int limit = int(gamecore::GridTexture::MaxDimension);
+            texelScale = ((std::max)(viewW, viewH) + limit - 1) / limit;
+            if (!texture.resize(std::uint32_t((viewW + texelScale - 1) / texelScale),
+                    std::uint32_t((viewH + texelScale - 1) / texelScale)))
+                std::cerr << "[Cellular] Board texture unavailable, drawing per-cell sprites\n";
         }
 
         bool frame(std::shared_ptr<core::Context> ctx, core::WindowData*) override {
@@ -71,17 +113,37 @@ namespace almondnamespace::cellular {
             auto& atlasVec = atlasmanager::get_atlas_vector();
             std::span<const TextureAtlas* const> atlasSpan(atlasVec.data(), atlasVec.size());
 
-            const float cw = float(ctx->get_width_safe()) / W;
-            const float ch = float(ctx->get_height_safe()) / H;
+            const int viewW = config.unbounded ? (std::max)(1, config.width) : board.width();
+            const int viewH = config.unbounded ? (std::max)(1, config.height) : board.height();
+            const float cw = float(ctx->get_width_safe()) / viewW;
+            const float ch = float(ctx->get_height_safe()) / viewH;
+
+            if (drawTexture(*ctx, atlasSpan)) {
+                ctx->present_safe();
+                return true;
+            }
 
             if (!spritepool::is_alive(cellHandle))
                 return true;
 
-            for (int y = 0; y < H; ++y) {
-                for (int x = 0; x < W; ++x) {
-                    if (grid[gamecore::idx(W, x, y)])
+            if (config.unbounded) {
+                world.for_each_live(0, 0, viewW, viewH, [&](std::int64_t x, std::int64_t y) {
+                    ctx->draw_sprite_safe(cellHandle, atlasSpan,
+                        float(x) * cw, float(y) * ch, cw, ch);
+                });
+                ctx->present_safe();
+                return true;
+            }
+
+            // Walk set bits only; empty words cost one compare.
+            for (int y = 0; y < board.height(); ++y) {
+                const auto row = board.row(y);
+                for (std::size_t k = 0; k < row.size(); ++k) {
+                    for (std::uint64_t bits = row[k]; bits; bits &= bits - 1) {
+                        const int x = static_cast<int>(k * 64) + std::countr_zero(bits);
                         ctx->draw_sprite_safe(cellHandle, atlasSpan,
                             x * cw, y * ch, cw, ch);
+                    }
                 }
             }
 
@@ -91,7 +153,8 @@ namespace almondnamespace::cellular {
 
         void unload() override {
             Scene::unload();
-            grid.clear();
+            board = {};
+            world.clear();
         }
 
     private:
@@ -135,31 +198,58 @@ namespace almondnamespace::cellular {
             }
         }
 
-        void seedRandom() {
-            std::mt19937_64 rng{ std::random_device{}() };
-            std::bernoulli_distribution d{ 0.2 };
-            for (int y = 0; y < H; ++y)
-                for (int x = 0; x < W; ++x)
-                    grid[gamecore::idx(W, x, y)] = d(rng);
+        bool drawTexture(core::Context& ctx, std::span<const TextureAtlas* const> atlasSpan) {
+            if (!texture.ready())
+                return false;
+
+            const std::uint32_t texW = texture.width();
+            const int s = texelScale;
+            bool updated = false;
+            if (config.unbounded) {
+                texels.assign(std::size_t(texW) * texture.height(), 0u);
+                world.for_each_live(0, 0, config.width, config.height, [&](std::int64_t x, std::int64_t y) {
+                    texels[std::size_t(y / s) * texW + std::size_t(x / s)] = cellColour;
+                });
+                updated = texture.update(texels);
+            }
+            else {
+                const std::size_t words = board.row(0).size();
+                updated = texture.update_rows([&](std::uint32_t ty, std::span<std::uint32_t> out) {
+                    rowBits.assign(words, 0u);
+                    const int y0 = int(ty) * s;
+                    const int y1 = (std::min)(y0 + s, board.height());
+                    for (int y = y0; y < y1; ++y) {
+                        const auto row = board.row(y);
+                        for (std::size_t k = 0; k < words; ++k) rowBits[k] |= row[k];
+                    }
+                    std::fill(out.begin(), out.end(), 0u);
+                    for (std::size_t k = 0; k < words; ++k)
+                        for (std::uint64_t bits = rowBits[k]; bits; bits &= bits - 1)
+                            out[(k * 64 + std::countr_zero(bits)) / std::size_t(s)] = cellColour;
+                });
+            }
+            if (!updated)
+                return false;
+            texture.draw(ctx, atlasSpan, 0.0f, 0.0f, float(ctx.get_width_safe()), float(ctx.get_height_safe()));
+            return true;
         }
 
         void stepSimulation() {
-            auto next = grid;
-            for (int y = 0; y < H; ++y) {
-                for (int x = 0; x < W; ++x) {
-                    int live = 0;
-                    for (auto [nx, ny] : gamecore::neighbors(W, H, x, y))
-                        if (grid[gamecore::idx(W, nx, ny)])
-                            ++live;
-                    bool alive = grid[gamecore::idx(W, x, y)];
-                    next[gamecore::idx(W, x, y)] = (live == 3) || (alive && live == 2);
-                }
-            }
-            grid = std::move(next);
+            if (config.unbounded) world.step(rule);
+            else board.step(rule);
         }
 
-        gamecore::grid_t<bool> grid{};
+        CellularConfig config{};
+        LifeRule rule{};
+        LifeBoard board{};
+        LifeChunkWorld world{};
         SpriteHandle cellHandle{};
+        gamecore::GridTexture texture{};
+        int texelScale = 1;
+        std::vector<std::uint32_t> texels;
+        std::vector<std::uint64_t> rowBits;
+
+        static constexpr std::uint32_t cellColour = gamecore::rgba(150, 225, 205);
     };
 
     inline bool run_cellular(std::shared_ptr<core::Context> ctx)
@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <filesystem>
 #include <iostream>
+#include <string>
 #include <string_view>
 
 namespace almondnamespace::core::cli {
@@ -45,6 +46,23 @@ namespace almondnamespace::core::cli {
     inline bool trace_raylib_design_metrics = false;
     inline std::filesystem::path exe_path;
 
+    // Headless software-renderer runs (benchmarks / image-diff regression).
+    // An empty scene name keeps the normal windowed engine loop.
+    inline std::string headless_scene;
+    inline int  headless_frames = 600;
+    inline int  headless_capture_every = 0;
+    inline std::filesystem::path headless_capture_dir;
+    inline std::string headless_capture_format = "png";
+
+    // Frame pacing for the engine and render loops. 0 disables the cap
+    // (benchmark mode); vsync'ed backends never sleep regardless.
+    inline int  target_fps = 60;
+    // Fixed simulation rate for Scene::update(), independent of target_fps.
+    inline int  tick_rate = 60;
+    // Per-backend texture residency budget in MiB; 0 keeps every atlas resident.
+    inline int  vram_budget_mb = 512;
+    inline bool trace_residency = false;
+
     struct ParseResult
     {
         bool update_requested = false;
@@ -63,6 +81,7 @@ namespace almondnamespace::core::cli {
         ParseResult result{};
         trace_menu_button0_rect = false;
         trace_raylib_design_metrics = false;
+        trace_residency = false;
         window_width_overridden = false;
         window_height_overridden = false;
         if (argc < 1) {
@@ -84,6 +103,16 @@ namespace almondnamespace::core::cli {
                     "  --menu-columns <n>    Cap the menu grid at n columns (default 4)\n"
                     "  --trace-menu-button0  Log GUI bounds for menu button index 0\n"
                     "  --trace-raylib-design Log framebuffer vs design canvas dimensions\n"
+                    "  --headless <scene>    Run a scene offscreen on the software renderer\n"
+                    "  --frames <n>          Fixed-step frames to run headless (default 600)\n"
+                    "  --capture-dir <path>  Dump headless frames into <path>\n"
+                    "  --capture-every <n>   Dump every n-th frame (default: last frame only)\n"
+                    "  --capture-format <f>  png, ppm, tga or bmp (default png)\n"
+                    "  --fps <n>             Target frame rate for paced loops (default 60)\n"
+                    "  --uncapped            Disable frame pacing (benchmark mode)\n"
+                    "  --tick-rate <hz>      Fixed simulation tick rate (default 60)\n"
+                    "  --vram-budget <mb>    Evict least-recently-used atlases above <mb> (0 = off)\n"
+                    "  --trace-residency     Log every atlas evicted by the VRAM budget\n"
                     "  --update, -u          Check for a newer AlmondShell build\n"
                     "  --force               Apply the available update immediately\n";
             }
@@ -107,6 +136,36 @@ namespace almondnamespace::core::cli {
             else if (arg == "--trace-raylib-design"sv) {
                 trace_raylib_design_metrics = true;
             }
+            else if (arg == "--trace-residency"sv) {
+                trace_residency = true;
+            }
+            else if (arg == "--headless"sv && i + 1 < argc) {
+                headless_scene = argv[++i];
+            }
+            else if (arg == "--frames"sv && i + 1 < argc) {
+                headless_frames = (std::max)(1, std::stoi(argv[++i]));
+            }
+            else if (arg == "--capture-dir"sv && i + 1 < argc) {
+                headless_capture_dir = argv[++i];
+            }
+            else if (arg == "--capture-every"sv && i + 1 < argc) {
+                headless_capture_every = (std::max)(0, std::stoi(argv[++i]));
+            }
+            else if (arg == "--capture-format"sv && i + 1 < argc) {
+                headless_capture_format = argv[++i];
+            }
+            else if (arg == "--fps"sv && i + 1 < argc) {
+                target_fps = (std::max)(0, std::stoi(argv[++i]));
+            }
+            else if (arg == "--uncapped"sv) {
+                target_fps = 0;
+            }
+            else if (arg == "--tick-rate"sv && i + 1 < argc) {
+                tick_rate = (std::max)(1, std::stoi(argv[++i]));
+            }
+            else if (arg == "--vram-budget"sv && i + 1 < argc) {
+                vram_budget_mb = (std::max)(0, std::stoi(argv[++i]));
+            }
             else if (arg == "--update"sv || arg == "-u"sv) {
                 result.update_requested = true;
             }
@@ -0,0 +1,309 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // aconsolelog.hpp
+#pragma once
+
+#include "ampmcboundedqueue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace almondnamespace::gui
+{
+    // Per-byte advances (tabs included) and the width rows wrap at.
+    // `console_window` fills this from the GUI font; changing it rewraps
+    // every retained line once.
+    struct ConsoleWrapMetrics
+    {
+        std::array<float, 256> advance{};
+        float width = 0.0f;     // <= 0 disables wrapping
+
+        [[nodiscard]] bool operator==(const ConsoleWrapMetrics&) const = default;
+    };
+
+    // Ring-buffered console model. Lines are split and wrapped once when
+    // they are appended, so drawing a view only touches the visible rows.
+    // The ring grows with the log up to `capacity`; after that the oldest
+    // lines are recycled (text and wrap storage included).
+    //
+    // Threading: append/drain_pending/clear and all queries belong to the
+    // thread that draws the console. Any other thread hands lines over with
+    // post(), which goes through a lock-free bounded queue.
+    class ConsoleLog
+    {
+    public:
+        static constexpr std::size_t DefaultCapacity = 100000;
+        static constexpr std::size_t DefaultQueueCapacity = 4096; // must be a power of two
+
+        struct Row
+        {
+            std::size_t line = 0;          // 0 = oldest retained line
+            std::string_view text{};       // bytes of this visual row
+        };
+
+        explicit ConsoleLog(std::size_t capacity = DefaultCapacity, std::size_t queueCapacity = DefaultQueueCapacity)
+            : capacity_((std::max)(capacity, std::size_t{ 1 }))
+            , pending_(queueCapacity)
+        {
+        }
+
+        ConsoleLog(const ConsoleLog&) = delete;
+        ConsoleLog& operator=(const ConsoleLog&) = delete;
+
+        // ─── Writing ────────────────────────────────────────────────
+        // Embedded '\n' starts a new line; '\r' is dropped.
+        void append(std::string_view text)
+        {
+            for (;;) {
+                const std::size_t nl = text.find('\n');
+                push_line(text.substr(0, nl));
+                if (nl == std::string_view::npos)
+                    break;
+                text.remove_prefix(nl + 1);
+            }
+        }
+
+        // Safe from any thread. Returns false when the queue is full; the
+        // line becomes visible after the owner's next drain_pending().
+        bool post(std::string text) { return pending_.enqueue(std::move(text)); }
+
+        // Moves posted lines into the ring; console_window calls this each frame.
+        std::size_t drain_pending()
+        {
+            std::size_t moved = 0;
+            std::string text;
+            while (pending_.dequeue(text)) {
+                append(text);
+                ++moved;
+            }
+            return moved;
+        }
+
+        void clear() noexcept
+        {
+            firstSequence_ += count_;
+            head_ = 0;
+            count_ = 0;
+            headRow_ = nextRow_ = 0;
+            ++version_;
+        }
+
+        // ─── Lines ──────────────────────────────────────────────────
+        [[nodiscard]] std::size_t size() const noexcept { return count_; }
+        [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+        [[nodiscard]] bool empty() const noexcept { return count_ == 0; }
+
+        [[nodiscard]] std::string_view line(std::size_t index) const noexcept
+        {
+            return index < count_ ? std::string_view{ slot(index).text } : std::string_view{};
+        }
+
+        // Monotonic id of a line; stays valid while older lines are evicted.
+        [[nodiscard]] std::uint64_t sequence(std::size_t index) const noexcept { return firstSequence_ + index; }
+        [[nodiscard]] std::optional<std::size_t> index_of(std::uint64_t sequence) const noexcept
+        {
+            if (sequence < firstSequence_ || sequence - firstSequence_ >= count_)
+                return std::nullopt;
+            return static_cast<std::size_t>(sequence - firstSequence_);
+        }
+
+        // Bumped by every change that alters what a view would show.
+        [[nodiscard]] std::uint64_t version() const noexcept { return version_; }
+
+        // ─── Wrapped rows ───────────────────────────────────────────
+        // Returns true when the metrics changed and the log was rewrapped.
+        bool set_wrap(const ConsoleWrapMetrics& metrics)
+        {
+            if (metrics == wrap_)
+                return false;
+            wrap_ = metrics;
+            nextRow_ = 0;
+            for (std::size_t i = 0; i < count_; ++i) {
+                LineSlot& s = slot(i);
+                wrap_slot(s);
+                s.firstRow = nextRow_;
+                nextRow_ += s.wraps.size() + 1;
+            }
+            headRow_ = 0;
+            ++version_;
+            return true;
+        }
+
+        [[nodiscard]] const ConsoleWrapMetrics& wrap() const noexcept { return wrap_; }
+        [[nodiscard]] std::size_t total_rows() const noexcept { return static_cast<std::size_t>(nextRow_ - headRow_); }
+
+        // First visual row of a line.
+        [[nodiscard]] std::size_t row_of_line(std::size_t index) const noexcept
+        {
+            return index < count_ ? static_cast<std::size_t>(slot(index).firstRow - headRow_) : total_rows();
+        }
+
+        // Line that contains visual row `row` (binary search, O(log n)).
+        [[nodiscard]] std::size_t line_of_row(std::size_t row) const noexcept
+        {
+            if (count_ == 0)
+                return 0;
+            const std::uint64_t target = headRow_ + row;
+            std::size_t lo = 0, hi = count_;
+            while (hi - lo > 1) {
+                const std::size_t mid = lo + (hi - lo) / 2;
+                if (slot(mid).firstRow <= target) lo = mid;
+                else hi = mid;
+            }
+            return lo;
+        }
+
+        // Visits up to `count` visual rows starting at `firstRow`; the cost
+        // is the binary search plus the rows visited.
+        template <typename Fn>
+        void for_each_row(std::size_t firstRow, std::size_t count, Fn&& fn) const
+        {
+            if (count == 0 || firstRow >= total_rows())
+                return;
+            std::size_t index = line_of_row(firstRow);
+            std::size_t sub = static_cast<std::size_t>(headRow_ + firstRow - slot(index).firstRow);
+            while (count > 0 && index < count_) {
+                const LineSlot& s = slot(index);
+                const std::size_t rows = s.wraps.size() + 1;
+                for (; sub < rows && count > 0; ++sub, --count) {
+                    const std::size_t begin = sub == 0 ? 0 : s.wraps[sub - 1];
+                    const std::size_t end = sub < s.wraps.size() ? s.wraps[sub] : s.text.size();
+                    fn(Row{ index, std::string_view{ s.text }.substr(begin, end - begin) });
+                }
+                sub = 0;
+                ++index;
+            }
+        }
+
+        // ─── Scrollback search ──────────────────────────────────────
+        // Scans from `from` (inclusive) towards older lines when `backwards`,
+        // newer lines otherwise, and returns the first line containing `needle`.
+        [[nodiscard]] std::optional<std::size_t> find(std::string_view needle, std::size_t from,
+            bool backwards = true, bool caseSensitive = false) const
+        {
+            if (needle.empty() || count_ == 0)
+                return std::nullopt;
+            from = (std::min)(from, count_ - 1);
+
+            auto matches = [&](std::string_view text) {
+                if (caseSensitive)
+                    return text.find(needle) != std::string_view::npos;
+                return std::search(text.begin(), text.end(), needle.begin(), needle.end(),
+                    [](char a, char b) {
+                        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+                    }) != text.end();
+            };
+
+            if (backwards) {
+                for (std::size_t i = from + 1; i-- > 0;)
+                    if (matches(slot(i).text)) return i;
+            }
+            else {
+                for (std::size_t i = from; i < count_; ++i)
+                    if (matches(slot(i).text)) return i;
+            }
+            return std::nullopt;
+        }
+
+    private:
+        struct LineSlot
+        {
+            std::string text{};
+            std::vector<std::uint32_t> wraps{};  // byte offsets where rows 2..n start
+            std::uint64_t firstRow = 0;          // absolute row number of row 1
+        };
+
+        [[nodiscard]] LineSlot& slot(std::size_t index) noexcept { return slots_[(head_ + index) % slots_.size()]; }
+        [[nodiscard]] const LineSlot& slot(std::size_t index) const noexcept { return slots_[(head_ + index) % slots_.size()]; }
+
+        void push_line(std::string_view text)
+        {
+            if (count_ == capacity_) {
+                // Recycle the oldest slot; its buffers keep their capacity.
+                head_ = (head_ + 1) % slots_.size();
+                --count_;
+                ++firstSequence_;
+                headRow_ = count_ ? slot(0).firstRow : nextRow_;
+            }
+            else if (count_ == slots_.size()) {
+                // Not full yet, so head_ is still 0 and the ring is unwrapped.
+                if (slots_.size() == slots_.capacity())
+                    slots_.reserve((std::min)(capacity_, (std::max)(slots_.size() * 2, std::size_t{ 64 })));
+                slots_.emplace_back();
+            }
+
+            LineSlot& s = slot(count_);
+            s.text.clear();
+            for (char ch : text)
+                if (ch != '\r') s.text.push_back(ch);
+            wrap_slot(s);
+            s.firstRow = nextRow_;
+            nextRow_ += s.wraps.size() + 1;
+            if (count_ == 0)
+                headRow_ = s.firstRow;
+            ++count_;
+            ++version_;
+        }
+
+        // Same rule the GUI text layout uses: break before the glyph that
+        // would cross the width, never leaving a row empty.
+        void wrap_slot(LineSlot& s) const
+        {
+            s.wraps.clear();
+            if (wrap_.width <= 0.0f)
+                return;
+
+            const float space = wrap_.advance[static_cast<unsigned char>(' ')];
+            const float limit = (std::max)(space, wrap_.width) + 0.001f;
+            float pen = 0.0f;
+            for (std::size_t i = 0; i < s.text.size(); ++i) {
+                const float advance = wrap_.advance[static_cast<unsigned char>(s.text[i])];
+                if (pen > 0.0f && pen + advance > limit) {
+                    s.wraps.push_back(static_cast<std::uint32_t>(i));
+                    pen = 0.0f;
+                }
+                pen += advance;
+            }
+        }
+
+        std::vector<LineSlot> slots_;           // grows lazily up to capacity_
+        std::size_t capacity_ = 0;
+        std::size_t head_ = 0;
+        std::size_t count_ = 0;
+        std::uint64_t firstSequence_ = 0;
+        std::uint64_t headRow_ = 0;
+        std::uint64_t nextRow_ = 0;
+        std::uint64_t version_ = 0;
+        ConsoleWrapMetrics wrap_{};
+        MPMCQueue<std::string> pending_;
+    };
+
+} // namespace almondnamespace::gui
@@ -114,6 +114,10 @@ namespace almondnamespace::core
         ContextType type = almondnamespace::core::ContextType::Custom;
         std::string backendName;
 
+        // Set by backends whose present blocks on vblank. Render loops then
+        // skip their own frame pacing instead of waiting twice.
+        bool presentIsVsynced = false;
+
         // --- Backend function pointers ---
         InitializeFunc initialize = nullptr;
         CleanupFunc cleanup = nullptr;
@@ -0,0 +1,162 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // adrawlist.hpp
+#pragma once
+
+#include "acontext.hpp"
+#include "aatlasmanager.hpp"
+#include "aspritehandle.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace almondnamespace::core
+{
+    // Backend-neutral record of one scene frame. The engine runs a scene's
+    // frame() once against a recording context, then every window replays the
+    // same list on its own render thread, so mirroring a scene across N
+    // windows costs N rasterisations rather than N simulations.
+    struct DrawListCommand
+    {
+        SpriteHandle sprite{};
+        float x = 0.0f;
+        float y = 0.0f;
+        float w = 0.0f;
+        float h = 0.0f;
+    };
+
+    class DrawList
+    {
+    public:
+        void reset(int logicalWidth, int logicalHeight)
+        {
+            commands.clear();
+            width = (std::max)(1, logicalWidth);
+            height = (std::max)(1, logicalHeight);
+        }
+
+        void reserve(std::size_t count) { commands.reserve(count); }
+
+        void push(SpriteHandle sprite, float x, float y, float w, float h)
+        {
+            commands.push_back({ sprite, x, y, w, h });
+        }
+
+        [[nodiscard]] std::span<const DrawListCommand> view() const noexcept { return commands; }
+        [[nodiscard]] std::size_t size() const noexcept { return commands.size(); }
+        [[nodiscard]] bool empty() const noexcept { return commands.empty(); }
+
+        // Draws every command on `target`, rescaled from the recording
+        // canvas to the target's logical size. Runs on every render thread
+        // while the engine thread may register atlases, so it works from a
+        // locked copy of the atlas table.
+        void replay(const Context& target) const
+        {
+            const float sx = static_cast<float>(target.get_width_safe()) / static_cast<float>(width);
+            const float sy = static_cast<float>(target.get_height_safe()) / static_cast<float>(height);
+            const auto atlases = atlasmanager::get_atlas_vector_snapshot();
+            std::span<const TextureAtlas* const> atlasSpan(atlases.data(), atlases.size());
+            for (const auto& cmd : commands)
+                target.draw_sprite_safe(cmd.sprite, atlasSpan, cmd.x * sx, cmd.y * sy, cmd.w * sx, cmd.h * sy);
+        }
+
+    private:
+        std::vector<DrawListCommand> commands;
+        int width = 1;
+        int height = 1;
+    };
+
+    // ─── Recording ────────────────────────────────────────────────────
+    // Context::draw_sprite is a raw function pointer, so the list being
+    // recorded on this thread is published through a thread_local.
+    inline thread_local DrawList* recordingDrawList = nullptr;
+
+    inline void record_draw_sprite(SpriteHandle sprite, std::span<const TextureAtlas* const>,
+        float x, float y, float w, float h)
+    {
+        if (recordingDrawList)
+            recordingDrawList->push(sprite, x, y, w, h);
+    }
+
+    // RAII scope that routes recording-context draws into `list`.
+    class DrawListRecorder
+    {
+    public:
+        DrawListRecorder(DrawList& list, int logicalWidth, int logicalHeight)
+            : previous(recordingDrawList)
+        {
+            list.reset(logicalWidth, logicalHeight);
+            recordingDrawList = &list;
+        }
+        ~DrawListRecorder() { recordingDrawList = previous; }
+
+        DrawListRecorder(const DrawListRecorder&) = delete;
+        DrawListRecorder& operator=(const DrawListRecorder&) = delete;
+
+    private:
+        DrawList* previous = nullptr;
+    };
+
+    // Context that reads size and input from `source` but records draws
+    // instead of rasterising them. clear/present are left unset because the
+    // replaying render threads own those.
+    inline std::shared_ptr<Context> make_recording_context(const std::shared_ptr<Context>& source)
+    {
+        auto rec = std::make_shared<Context>();
+        if (!source)
+            return rec;
+
+        rec->hwnd = source->hwnd;
+        rec->width = source->width;
+        rec->height = source->height;
+        rec->framebufferWidth = source->framebufferWidth;
+        rec->framebufferHeight = source->framebufferHeight;
+        rec->virtualWidth = source->virtualWidth;
+        rec->virtualHeight = source->virtualHeight;
+        rec->type = source->type;
+        rec->backendName = source->backendName;
+
+        rec->get_width = source->get_width;
+        rec->get_height = source->get_height;
+        rec->registry_get = source->registry_get;
+        rec->add_model = source->add_model;
+        rec->draw_sprite = record_draw_sprite;
+
+        rec->is_key_held = source->is_key_held;
+        rec->is_key_down = source->is_key_down;
+        rec->get_mouse_position = source->get_mouse_position;
+        rec->is_mouse_button_held = source->is_mouse_button_held;
+        rec->is_mouse_button_down = source->is_mouse_button_down;
+
+        rec->add_texture = [source](TextureAtlas& atlas, std::string name, const ImageData& img) {
+            return source->add_texture_safe(atlas, std::move(name), img);
+        };
+        rec->add_atlas = [source](const TextureAtlas& atlas) {
+            return source->add_atlas_safe(atlas);
+        };
+        return rec;
+    }
+}
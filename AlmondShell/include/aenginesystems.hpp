@@ -28,13 +28,15 @@
 //#include "anet.hpp"                // for poll()
 
 #include <span>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <fstream>
 #include <coroutine>
 #include <filesystem>
 #include <functional>
-#include <semaphore> // for cleaner future improvement
+#include <memory>
+#include <semaphore>
 #include <thread>
 #include <vector>
 
@@ -67,25 +69,26 @@ namespace almondnamespace
     // —————————————————————————————————————————————————————————————————
     // Internal job queue + worker pool
     // —————————————————————————————————————————————————————————————————
-    static MPMCQueue<std::function<void()>> g_jobQueue{ 1024 };
-    static std::vector<std::thread>         g_workers;
-    static std::atomic<bool>                g_running{ false };
+    // One pool per process (inline, not static: every translation unit
+    // must see the same queue). Idle workers block on `g_jobSignal`, which
+    // is released once per enqueued job and once per worker on shutdown.
+    inline MPMCQueue<std::function<void()>> g_jobQueue{ 1024 };
+    inline std::vector<std::thread>         g_workers;
+    inline std::atomic<bool>                g_running{ false };
+    inline std::counting_semaphore<>        g_jobSignal{ 0 };
 
     inline void scheduler_start(int threadCount) {
         g_running = true;
         for (int i = 0; i < threadCount; ++i) {
             g_workers.emplace_back([] {
                 std::function<void()> job;
-                while (g_running) {
-                    if (g_jobQueue.dequeue(job)) {
-                        job();
-                    }
-                    else {
+                for (;;) {
+                    g_jobSignal.acquire();
+                    // Jobs still queued at shutdown are drained first.
+                    while (!g_jobQueue.dequeue(job)) {
+                        if (!g_running) return;
                         std::this_thread::yield();
                     }
-                }
-                // Drain remaining jobs
-                while (g_jobQueue.dequeue(job)) {
                     job();
                 }
                 });
@@ -94,6 +97,7 @@ namespace almondnamespace
 
     inline void scheduler_stop() {
         g_running = false;
+        g_jobSignal.release(static_cast<std::ptrdiff_t>(g_workers.size()));
         for (auto& t : g_workers) {
             if (t.joinable()) t.join();
         }
@@ -104,6 +108,55 @@ namespace almondnamespace
         while (!g_jobQueue.enqueue(std::move(job))) {
             std::this_thread::yield();
         }
+        g_jobSignal.release();
+    }
+
+    // Starts hardware_concurrency - 1 workers on first use unless the engine
+    // already started the pool; the pool is stopped at static destruction.
+    inline void scheduler_ensure_started() {
+        static const struct PoolLifetime {
+            PoolLifetime() {
+                if (g_workers.empty())
+                    scheduler_start(static_cast<int>((std::max)(2u, std::thread::hardware_concurrency()) - 1));
+            }
+            ~PoolLifetime() { scheduler_stop(); }
+        } lifetime;
+    }
+
+    // Runs body(i) for every i in [0, count) on the pool and returns once all
+    // have finished. The calling thread takes indices too, so this is safe to
+    // call from inside a job and never waits on an idle pool.
+    inline void scheduler_parallel_for(size_t count, const std::function<void(size_t)>& body) {
+        if (count == 0)
+            return;
+        if (count == 1) {
+            body(0);
+            return;
+        }
+        scheduler_ensure_started();
+
+        struct Progress {
+            std::atomic<size_t> next{ 0 };
+            std::atomic<size_t> done{ 0 };
+        };
+        // Helpers that start after the caller finished only touch `progress`,
+        // never `body`, so the shared state must outlive this frame.
+        auto progress = std::make_shared<Progress>();
+        auto drain = [progress, &body, count] {
+            for (size_t i = progress->next.fetch_add(1); i < count; i = progress->next.fetch_add(1)) {
+                body(i);
+                if (progress->done.fetch_add(1) + 1 == count)
+                    progress->done.notify_all();
+            }
+        };
+
+        const size_t helpers = (std::min)(count - 1, g_workers.size());
+        for (size_t i = 0; i < helpers; ++i)
+            scheduler_enqueue(drain);
+        drain();
+
+        for (size_t done = progress->done.load(); done < count; done = progress->done.load())
+            progress->done.wait(done);
     }
 
     // —————————————————————————————————————————————————————————————————
@@ -0,0 +1,117 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // afixedtimestep.hpp
+#pragma once
+
+#include "arobusttime.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace almondnamespace::time
+{
+    //── Fixed-timestep accumulator ──────────────────────────────//
+    // Decouples simulation rate from render rate. Each render frame feeds its
+    // elapsed time in; `update(dt)` runs zero or more times at the fixed tick
+    // rate and `alpha()` reports how far the render sits between the last two
+    // ticks, so draws can interpolate instead of stuttering.
+    //
+    // Elapsed time is read through `time::now()`, so headless runs on the
+    // manual clock step deterministically.
+    class FixedTimestep
+    {
+    public:
+        explicit FixedTimestep(double tickHz = 60.0, int maxTicksPerFrame = 8)
+        {
+            set_tick_rate(tickHz);
+            set_max_ticks_per_frame(maxTicksPerFrame);
+        }
+
+        void set_tick_rate(double tickHz) noexcept
+        {
+            step = 1.0 / (std::max)(1.0, tickHz);
+        }
+
+        // Caps catch-up work after a long stall (debugger, window drag) so a
+        // slow frame cannot snowball into ever-slower frames.
+        void set_max_ticks_per_frame(int ticks) noexcept { maxTicks = (std::max)(1, ticks); }
+
+        void reset() noexcept
+        {
+            accumulator = 0.0;
+            lastFrameSeconds = 0.0;
+            last = Clock::time_point{};
+        }
+
+        // Measures the time since the previous call and runs `update(step)`
+        // as many times as it covers. Returns the number of ticks run.
+        template <typename UpdateFn>
+        int advance(UpdateFn&& update)
+        {
+            const auto current = now();
+            const double frameSeconds = last == Clock::time_point{}
+                ? 0.0
+                : std::chrono::duration<double>(current - last).count();
+            last = current;
+            return advance(frameSeconds, update);
+        }
+
+        // Same as above with an externally measured frame duration.
+        template <typename UpdateFn>
+        int advance(double frameSeconds, UpdateFn&& update)
+        {
+            lastFrameSeconds = (std::max)(0.0, frameSeconds);
+            accumulator += lastFrameSeconds;
+
+            // Clock durations are truncated to whole ticks, so frames meant to
+            // sum to exactly one step can arrive a few nanoseconds short.
+            constexpr double tolerance = 1e-6;
+            int ticks = 0;
+            while (accumulator + tolerance >= step && ticks < maxTicks) {
+                update(step);
+                accumulator -= step;
+                ++ticks;
+                ++tickCount;
+            }
+            if (ticks == maxTicks && accumulator + tolerance >= step)
+                accumulator = 0.0; // drop the backlog rather than spiral
+            accumulator = (std::max)(0.0, accumulator);
+            return ticks;
+        }
+
+        [[nodiscard]] double alpha() const noexcept { return accumulator / step; }
+        [[nodiscard]] double step_seconds() const noexcept { return step; }
+        [[nodiscard]] double frame_seconds() const noexcept { return lastFrameSeconds; }
+        [[nodiscard]] std::uint64_t tick_count() const noexcept { return tickCount; }
+
+    private:
+        double step = 1.0 / 60.0;
+        double accumulator = 0.0;
+        double lastFrameSeconds = 0.0;
+        int maxTicks = 8;
+        std::uint64_t tickCount = 0;
+        Clock::time_point last{};
+    };
+}
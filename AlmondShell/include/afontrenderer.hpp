@@ -32,10 +32,20 @@
 #include "aspritehandle.hpp"
 #include "agui.hpp"
 
+#include "../src/stb/stb_truetype.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -74,6 +84,355 @@ namespace almondnamespace::font
         SpriteHandle handle{};  // Sprite handle for rendering this glyph slice
     };
 
+    // ─── Dynamic glyphs ───────────────────────────────────────────────
+    // Rasterises glyphs the first time they are asked for instead of baking
+    // whole codepoint ranges. Glyphs live in fixed-size cells of a private
+    // atlas page that starts small and doubles up to `maxPageSize`; once it
+    // is full, the least recently acquired glyph gives up its cell. Each new
+    // glyph is a single caller-placed atlas entry, so backends that track
+    // dirty rects upload just that cell.
+    // Distance-field glyphs store, per texel, the distance to the outline:
+    // `edge` on the outline, +/- `edge / padding` per pixel inside/outside,
+    // up to `padding` pixels out. Backends threshold at `edge`, so one bake
+    // renders cleanly from small UI text to 4K titles.
+    struct SdfParams
+    {
+        int padding = 6;
+        u8 edge = 128;
+
+        [[nodiscard]] float pixel_dist_scale() const noexcept
+        {
+            return static_cast<float>(edge) / static_cast<float>((std::max)(1, padding));
+        }
+    };
+
+    struct GlyphCacheConfig
+    {
+        u32 initialPageSize = 256;
+        u32 maxPageSize = 2048;
+        u32 padding = 1;
+        bool distanceField = false;
+        SdfParams sdf{};
+    };
+
+    class GlyphCache
+    {
+    public:
+        static std::shared_ptr<GlyphCache> create(const std::string& ttf_path, float pixel_height,
+            const GlyphCacheConfig& config = {})
+        {
+            std::ifstream file(ttf_path, std::ios::binary);
+            std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            if (data.empty() || pixel_height <= 0.0f)
+            {
+                std::cerr << "[GlyphCache] Unable to read font file '" << ttf_path << "'\n";
+                return nullptr;
+            }
+
+            std::shared_ptr<GlyphCache> cache(new GlyphCache());
+            cache->fontData = std::move(data);
+            const int offset = stbtt_GetFontOffsetForIndex(cache->fontData.data(), 0);
+            if (offset < 0 || !stbtt_InitFont(&cache->info, cache->fontData.data(), offset))
+            {
+                std::cerr << "[GlyphCache] Failed to initialise font info for '" << ttf_path << "'\n";
+                return nullptr;
+            }
+
+            cache->scale = stbtt_ScaleForPixelHeight(&cache->info, pixel_height);
+            cache->padding = config.padding;
+            cache->distanceField = config.distanceField;
+            cache->sdf = config.sdf;
+
+            // Cells hold the font's bounding box, capped so one oversized
+            // glyph does not make every cell huge; larger bitmaps are clipped.
+            int bx0 = 0, by0 = 0, bx1 = 0, by1 = 0;
+            stbtt_GetFontBoundingBox(&cache->info, &bx0, &by0, &bx1, &by1);
+            const u32 cap = static_cast<u32>(std::ceil(pixel_height * 2.0f));
+            const u32 boxW = static_cast<u32>(std::ceil(static_cast<float>(bx1 - bx0) * cache->scale));
+            const u32 boxH = static_cast<u32>(std::ceil(static_cast<float>(by1 - by0) * cache->scale));
+            const u32 falloff = config.distanceField ? 2 * static_cast<u32>((std::max)(0, config.sdf.padding)) : 0u;
+            cache->cellWidth = std::clamp(boxW, 1u, cap) + falloff + 2 * config.padding;
+            cache->cellHeight = std::clamp(boxH, 1u, cap) + falloff + 2 * config.padding;
+
+            const u32 minPage = (std::max)(cache->cellWidth, cache->cellHeight);
+            cache->maxPageSize = (std::max)(config.maxPageSize, minPage);
+            const u32 page = std::clamp(config.initialPageSize, minPage, cache->maxPageSize);
+
+            static std::atomic<u32> serial{ 0 };
+            cache->atlasName = "glyph_cache_" + std::to_string(serial.fetch_add(1, std::memory_order_relaxed));
+            AtlasConfig atlasConfig{ .name = cache->atlasName, .width = page, .height = page };
+            atlasConfig.distance_field = config.distanceField;
+            atlasConfig.distance_field_edge = config.sdf.edge;
+            atlasConfig.distance_field_scale = config.sdf.pixel_dist_scale();
+            if (!almondnamespace::atlasmanager::create_atlas(atlasConfig))
+                return nullptr;
+            auto* registrar = almondnamespace::atlasmanager::get_registrar(cache->atlasName);
+            if (!registrar)
+                return nullptr;
+            cache->atlas = &registrar->atlas;
+            cache->add_cells_locked(0, 0, page, page);
+            return cache;
+        }
+
+        // Fills `out` with the glyph for `cp`, rasterising it on first use.
+        // Returns false when the font has no glyph for `cp`.
+        bool acquire(char32_t cp, Glyph& out)
+        {
+            bool uploaded = false;
+            {
+                std::lock_guard lock(mutex);
+                if (const auto it = records.find(cp); it != records.end())
+                {
+                    if (!it->second.present)
+                        return false;
+                    if (it->second.slot >= 0)
+                        slots[static_cast<size_t>(it->second.slot)].lastUse = ++tick;
+                    out = it->second.glyph;
+                    return true;
+                }
+
+                Record record = rasterise_locked(cp, uploaded);
+                out = record.glyph;
+                const bool present = record.present;
+                records.emplace(cp, std::move(record));
+                if (!present)
+                    return false;
+            }
+
+            if (uploaded)
+                almondnamespace::atlasmanager::ensure_uploaded(*atlas);
+            return true;
+        }
+
+        [[nodiscard]] float kerning(char32_t left, char32_t right) const noexcept
+        {
+            return static_cast<float>(stbtt_GetCodepointKernAdvance(&info,
+                static_cast<int>(left), static_cast<int>(right))) * scale;
+        }
+
+        // Bumped whenever a glyph loses its cell; anything that cached glyph
+        // handles from this font must re-acquire them.
+        [[nodiscard]] u64 epoch() const noexcept { return evictions.load(std::memory_order_acquire); }
+
+        [[nodiscard]] const TextureAtlas* page() const noexcept { return atlas; }
+
+    private:
+        struct Slot
+        {
+            AtlasRect cell{};
+            int entryIndex = -1;
+            char32_t codepoint = 0;
+            u64 lastUse = 0;
+            bool used = false;
+        };
+
+        struct Record
+        {
+            Glyph glyph{};
+            int slot = -1;          // -1 for glyphs with no bitmap (e.g. space)
+            bool present = false;   // false when the font lacks the codepoint
+        };
+
+        GlyphCache() = default;
+
+        void add_cells_locked(u32 oldW, u32 oldH, u32 newW, u32 newH)
+        {
+            for (u32 y = 0; y + cellHeight <= newH; y += cellHeight)
+            {
+                for (u32 x = 0; x + cellWidth <= newW; x += cellWidth)
+                {
+                    if (x + cellWidth <= oldW && y + cellHeight <= oldH)
+                        continue;
+                    Slot slot{};
+                    slot.cell = { x, y, cellWidth, cellHeight };
+                    freeSlots.push_back(slots.size());
+                    slots.push_back(slot);
+                }
+            }
+        }
+
+        int allocate_slot_locked()
+        {
+            if (freeSlots.empty() && atlas->width < maxPageSize)
+            {
+                const u32 oldW = atlas->width;
+                const u32 oldH = atlas->height;
+                const u32 next = (std::min)(oldW * 2, maxPageSize);
+                if (atlas->grow(next, next))
+                {
+                    add_cells_locked(oldW, oldH, next, next);
+                    for (auto& [_, record] : records)
+                    {
+                        if (record.slot >= 0)
+                            refresh_uv(record);
+                    }
+                }
+            }
+
+            if (!freeSlots.empty())
+            {
+                const size_t index = freeSlots.back();
+                freeSlots.pop_back();
+                return static_cast<int>(index);
+            }
+
+            // Page is at its size limit: evict the least recently used glyph.
+            size_t victim = slots.size();
+            for (size_t i = 0; i < slots.size(); ++i)
+            {
+                if (slots[i].used && (victim == slots.size() || slots[i].lastUse < slots[victim].lastUse))
+                    victim = i;
+            }
+            if (victim == slots.size())
+                return -1;
+
+            records.erase(slots[victim].codepoint);
+            slots[victim].used = false;
+            evictions.fetch_add(1, std::memory_order_release);
+            return static_cast<int>(victim);
+        }
+
+        void refresh_uv(Record& record) const
+        {
+            AtlasRegion region{};
+            if (atlas->try_get_entry_info(slots[static_cast<size_t>(record.slot)].entryIndex, region))
+            {
+                record.glyph.uv.top_left = { region.u1, region.v1 };
+                record.glyph.uv.bottom_right = { region.u2, region.v2 };
+            }
+        }
+
+        Record rasterise_locked(char32_t cp, bool& uploaded)
+        {
+            Record record{};
+            const int glyphIndex = stbtt_FindGlyphIndex(&info, static_cast<int>(cp));
+            if (glyphIndex == 0)
+                return record;
+
+            int advance = 0, lsb = 0;
+            stbtt_GetGlyphHMetrics(&info, glyphIndex, &advance, &lsb);
+            record.present = true;
+            record.glyph.advance = static_cast<float>(advance) * scale;
+
+            int x0 = 0, y0 = 0, fullW = 0, fullH = 0;
+            unsigned char* field = nullptr;
+            if (distanceField)
+            {
+                field = stbtt_GetGlyphSDF(&info, scale, glyphIndex, sdf.padding, sdf.edge,
+                    sdf.pixel_dist_scale(), &fullW, &fullH, &x0, &y0);
+                if (!field)
+                    fullW = fullH = 0;
+            }
+            else
+            {
+                int x1 = 0, y1 = 0;
+                stbtt_GetGlyphBitmapBox(&info, glyphIndex, scale, scale, &x0, &y0, &x1, &y1);
+                fullW = x1 - x0;
+                fullH = y1 - y0;
+            }
+
+            const int w = (std::min)(fullW, static_cast<int>(cellWidth - 2 * padding));
+            const int h = (std::min)(fullH, static_cast<int>(cellHeight - 2 * padding));
+            record.glyph.offset_px = { static_cast<float>(x0), static_cast<float>(y0) };
+            record.glyph.size_px = { static_cast<float>((std::max)(w, 0)), static_cast<float>((std::max)(h, 0)) };
+
+            const int slotIndex = (w > 0 && h > 0) ? allocate_slot_locked() : -1;
+            if (slotIndex < 0)
+            {
+                if (field)
+                    stbtt_FreeSDF(field, nullptr);
+                return record;
+            }
+            Slot& slot = slots[static_cast<size_t>(slotIndex)];
+
+            scratch.assign(static_cast<size_t>(w) * h, 0);
+            if (field)
+            {
+                for (int row = 0; row < h; ++row)
+                    std::copy_n(field + static_cast<size_t>(row) * fullW, w, scratch.data() + static_cast<size_t>(row) * w);
+                stbtt_FreeSDF(field, nullptr);
+            }
+            else
+            {
+                stbtt_MakeGlyphBitmap(&info, scratch.data(), w, h, w, scale, scale, glyphIndex);
+            }
+            rgba.resize(scratch.size() * 4);
+            for (size_t i = 0; i < scratch.size(); ++i)
+            {
+                rgba[i * 4 + 0] = 255;
+                rgba[i * 4 + 1] = 255;
+                rgba[i * 4 + 2] = 255;
+                rgba[i * 4 + 3] = scratch[i];
+            }
+
+            const AtlasRect rect{ slot.cell.x + padding, slot.cell.y + padding, static_cast<u32>(w), static_cast<u32>(h) };
+            const std::string name = atlasName + "_cp" + std::to_string(static_cast<u32>(cp));
+            if (slot.entryIndex < 0)
+            {
+                const auto entry = atlas->place_entry(name, rect, rgba);
+                if (!entry)
+                {
+                    freeSlots.push_back(static_cast<size_t>(slotIndex));
+                    return record;
+                }
+                slot.entryIndex = *entry;
+            }
+            else if (!atlas->replace_entry(slot.entryIndex, name, rect, rgba))
+            {
+                freeSlots.push_back(static_cast<size_t>(slotIndex));
+                return record;
+            }
+
+            slot.used = true;
+            slot.codepoint = cp;
+            slot.lastUse = ++tick;
+            record.slot = slotIndex;
+            record.glyph.handle = SpriteHandle{
+                static_cast<uint32_t>(slot.entryIndex),
+                0u,
+                static_cast<uint32_t>(atlas->get_index()),
+                static_cast<uint32_t>(slot.entryIndex)
+            };
+            refresh_uv(record);
+            uploaded = true;
+            return record;
+        }
+
+        std::vector<unsigned char> fontData;
+        stbtt_fontinfo info{};
+        float scale = 1.0f;
+        u32 padding = 1;
+        bool distanceField = false;
+        SdfParams sdf{};
+        u32 cellWidth = 1;
+        u32 cellHeight = 1;
+        u32 maxPageSize = 2048;
+        std::string atlasName;
+        TextureAtlas* atlas = nullptr;
+
+        std::mutex mutex;
+        std::unordered_map<char32_t, Record> records;
+        std::vector<Slot> slots;
+        std::vector<size_t> freeSlots;
+        u64 tick = 0;
+        std::atomic<u64> evictions{ 0 };
+        std::vector<unsigned char> scratch;
+        std::vector<u8> rgba;
+    };
+
+    struct FontLoadOptions
+    {
+        // Codepoints outside the baked Latin ranges are rasterised on demand.
+        bool dynamicGlyphs = true;
+        GlyphCacheConfig glyphCache{};
+
+        // Bake distance fields instead of coverage. `size_pt` then only sets
+        // the bake resolution; draw at other sizes through RunLayout::scale
+        // (see FontAsset::scale_for).
+        bool signedDistanceField = false;
+        SdfParams sdf{};
+    };
+
     struct FontAsset
     {
         std::string name;
@@ -84,9 +443,23 @@ namespace almondnamespace::font
         int atlas_index = -1;
         FontMetrics metrics{};
         std::unordered_map<std::uint64_t, float> kerningPairs{};
+        char32_t fallbackCodepoint = U'?'; // drawn for codepoints neither baked nor found by dynamicGlyphs
+        std::shared_ptr<GlyphCache> dynamicGlyphs{};
+        bool distanceField = false;
+        u64 generation = 0; // bumped each time the name is reloaded; the address stays the same
+
+        // RunLayout::scale that draws this font `pixel_height` tall.
+        [[nodiscard]] float scale_for(float pixel_height) const noexcept
+        {
+            return size_pt > 0.0f ? pixel_height / size_pt : 1.0f;
+        }
 
         [[nodiscard]] float get_kerning(char32_t left, char32_t right) const noexcept
         {
+            // Baked pairs cover Latin-1; anything wider asks the font directly.
+            if (dynamicGlyphs && (left > 0xFF || right > 0xFF))
+                return dynamicGlyphs->kerning(left, right);
+
             if (kerningPairs.empty())
                 return 0.0f;
 
@@ -99,12 +472,50 @@ namespace almondnamespace::font
         }
     };
 
+    // Index into FontRenderer's font table. Resolve once with
+    // FontRenderer::resolve_font and keep the id; it stays valid for the
+    // renderer's lifetime, including across a reload of the same name.
+    using FontId = std::uint32_t;
+    inline constexpr FontId InvalidFontId = (std::numeric_limits<FontId>::max)();
+
+    // One positioned glyph of a shaped run, relative to the run's top-left.
+    struct GlyphQuad
+    {
+        SpriteHandle handle{};
+        float x = 0.0f;
+        float y = 0.0f;
+        float w = 0.0f;
+        float h = 0.0f;
+    };
+
+    struct RunLayout
+    {
+        float scale = 1.0f;
+        float wrapWidth = 0.0f; // 0 = only break on '\n'
+        int tabSpaces = 4;
+    };
+
+    // Shaped text: kerning, wrapping and fallback glyphs are already resolved,
+    // so drawing it is a straight walk over `quads`.
+    struct GlyphRun
+    {
+        std::vector<GlyphQuad> quads;
+        float width = 0.0f;
+        float height = 0.0f;
+        std::size_t lines = 1;
+    };
+
     class FontRenderer
     {
     public:
+        FontRenderer() = default;
+        FontRenderer(const FontRenderer&) = delete;
+        FontRenderer& operator=(const FontRenderer&) = delete;
+
         // Load and bake font from TTF file into a glyph atlas
         // Returns false on failure, true on success
-        bool load_font(const std::string& name, const std::string& ttf_path, float size_pt)
+        bool load_font(const std::string& name, const std::string& ttf_path, float size_pt,
+            const FontLoadOptions& options = {})
         {
             FontAsset asset{};
             asset.name = name;
@@ -116,7 +527,7 @@ namespace almondnamespace::font
 
             std::unordered_map<std::uint64_t, float> kerning_pairs{};
 
-            if (!load_and_bake_font(ttf_path, size_pt, baked_glyphs, metrics, kerning_pairs, raw_texture))
+            if (!load_and_bake_font(ttf_path, size_pt, options, baked_glyphs, metrics, kerning_pairs, raw_texture))
             {
                 std::cerr << "[FontRenderer] Failed to bake font '" << name << "' from '" << ttf_path << "'\n";
                 return false;
@@ -130,14 +541,20 @@ namespace almondnamespace::font
 
             raw_texture.name = name;
 
+            // Distance-field fonts share their own atlas so backends can tell
+            // how to sample it.
             static std::mutex atlas_mutex;
-            const std::string atlas_name = "font_atlas";
-            almondnamespace::atlasmanager::create_atlas({
+            const std::string atlas_name = options.signedDistanceField ? "font_sdf_atlas" : "font_atlas";
+            AtlasConfig atlas_config{
                 .name = atlas_name,
                 .width = 2048,
                 .height = 2048,
                 .generate_mipmaps = false
-                });
+            };
+            atlas_config.distance_field = options.signedDistanceField;
+            atlas_config.distance_field_edge = options.sdf.edge;
+            atlas_config.distance_field_scale = options.sdf.pixel_dist_scale();
+            almondnamespace::atlasmanager::create_atlas(atlas_config);
 
             auto* registrar = almondnamespace::atlasmanager::get_registrar(atlas_name);
             if (!registrar)
@@ -240,89 +657,134 @@ namespace almondnamespace::font
             asset.atlas_index = atlas.get_index();
             asset.metrics = metrics;
             asset.kerningPairs = std::move(kerning_pairs);
+            if (!asset.glyphs.contains(asset.fallbackCodepoint))
+                asset.fallbackCodepoint = U' ';
+            asset.distanceField = options.signedDistanceField;
+            if (options.dynamicGlyphs)
+            {
+                GlyphCacheConfig cache_config = options.glyphCache;
+                cache_config.distanceField = options.signedDistanceField;
+                cache_config.sdf = options.sdf;
+                asset.dynamicGlyphs = GlyphCache::create(ttf_path, size_pt, cache_config);
+            }
             almondnamespace::atlasmanager::ensure_uploaded(atlas);
-            loaded_fonts_.emplace(name, std::move(asset));
+
+            // Reloading a name keeps its id and asset address, so callers
+            // holding either stay valid; only the shaped runs go stale.
+            if (const auto it = font_ids_.find(name); it != font_ids_.end())
+            {
+                asset.generation = fonts_[it->second]->generation + 1;
+                *fonts_[it->second] = std::move(asset);
+                clear_run_cache();
+            }
+            else
+            {
+                font_ids_.emplace(name, static_cast<FontId>(fonts_.size()));
+                fonts_.push_back(std::make_unique<FontAsset>(std::move(asset)));
+            }
             return true;
         }
 
+        [[nodiscard]] FontId resolve_font(const std::string& name) const noexcept
+        {
+            const auto it = font_ids_.find(name);
+            return it == font_ids_.end() ? InvalidFontId : it->second;
+        }
+
+        [[nodiscard]] const FontAsset* get_font(FontId id) const noexcept
+        {
+            return id < fonts_.size() ? fonts_[id].get() : nullptr;
+        }
+
         [[nodiscard]] const FontAsset* get_font(const std::string& name) const noexcept
         {
-            auto it = loaded_fonts_.find(name);
-            if (it == loaded_fonts_.end())
-                return nullptr;
-            return &it->second;
+            return get_font(resolve_font(name));
         }
 
+        // ─── Shaped runs ──────────────────────────────────────────────
+        // Runs are cached by (font, layout, text hash). The cache keeps two
+        // generations: a lookup that hits the older one promotes the run,
+        // and once the current generation fills up the older one is dropped.
+        // Text redrawn every frame therefore never reshapes, and text that
+        // stops being drawn ages out without per-entry bookkeeping.
+        static constexpr std::size_t RunCacheGeneration = 2048;
 
-        // Render UTF-32 text at pixel coordinates in screen space using an explicit atlas span
-        void render_text(core::Context& ctx,
-            std::span<const TextureAtlas* const> atlases,
-            const std::string& font_name,
-            const std::u32string& text,
-            ui::vec2 pos_px) const
+        [[nodiscard]] std::shared_ptr<const GlyphRun> shape(FontId id,
+            std::u32string_view text, const RunLayout& layout = {}) const
         {
-            auto it = loaded_fonts_.find(font_name);
-            if (it == loaded_fonts_.end())
-                return; // font not loaded, silently drop text (optionally log warning)
-
-            const FontAsset& font = it->second;
-            ui::vec2 cursor = pos_px;
-            const float lineHeight = (font.metrics.lineHeight > 0.0f)
-                ? font.metrics.lineHeight
-                : (font.metrics.ascent + font.metrics.descent);
-            const float fallbackAdvance = (font.metrics.spaceAdvance > 0.0f)
-                ? font.metrics.spaceAdvance
-                : font.metrics.averageAdvance;
-
-            char32_t previous = U'\0';
-            for (char32_t ch : text)
-            {
-                if (ch == U'\n')
-                {
-                    cursor.x = pos_px.x;
-                    cursor.y += lineHeight;
-                    previous = U'\0';
-                    continue;
-                }
+            return shape_cached(id, text, layout);
+        }
 
-                float kern = 0.0f;
-                if (previous != U'\0')
-                    kern = font.get_kerning(previous, ch);
+        // Bytes are taken as Latin-1 codepoints, which is how the GUI feeds text.
+        [[nodiscard]] std::shared_ptr<const GlyphRun> shape(FontId id,
+            std::string_view text, const RunLayout& layout = {}) const
+        {
+            return shape_cached(id, text, layout);
+        }
 
-                auto glyph_it = font.glyphs.find(ch);
-                if (glyph_it == font.glyphs.end())
-                {
-                    cursor.x += (fallbackAdvance > 0.0f) ? fallbackAdvance + kern : kern;
-                    previous = U'\0';
-                    continue;
-                }
+        void clear_run_cache() const
+        {
+            std::lock_guard lock(run_cache_mutex_);
+            run_cache_.clear();
+            run_cache_previous_.clear();
+        }
 
-                const Glyph& g = glyph_it->second;
-                cursor.x += kern;
+        // Draws a shaped run with its top-left at `origin`.
+        static void submit_run(const core::Context& ctx,
+            std::span<const TextureAtlas* const> atlases,
+            const GlyphRun& run,
+            ui::vec2 origin)
+        {
+            for (const GlyphQuad& q : run.quads)
+                ctx.draw_sprite_safe(q.handle, atlases, origin.x + q.x, origin.y + q.y, q.w, q.h);
+        }
 
-                if (g.handle.is_valid())
-                {
-                    ui::vec2 top_left = cursor + g.offset_px;
-                    ctx.draw_sprite_safe(g.handle, atlases, top_left.x, top_left.y, g.size_px.x, g.size_px.y);
-                }
 
-                cursor.x += g.advance;
-                previous = ch;
-            }
+        // Render UTF-32 text with its first baseline starting at `pos_px`
+        // (screen space) using an explicit atlas span.
+        void render_text(core::Context& ctx,
+            std::span<const TextureAtlas* const> atlases,
+            FontId font_id,
+            const std::u32string& text,
+            ui::vec2 pos_px) const
+        {
+            const FontAsset* font = get_font(font_id);
+            if (!font)
+                return; // font not loaded, silently drop text
+
+            const auto run = shape(font_id, std::u32string_view{ text });
+            submit_run(ctx, atlases, *run, { pos_px.x, pos_px.y - font->metrics.ascent });
         }
 
-        // Convenience overload that gathers atlases from the global atlas manager
         void render_text(core::Context& ctx,
+            std::span<const TextureAtlas* const> atlases,
             const std::string& font_name,
             const std::u32string& text,
             ui::vec2 pos_px) const
+        {
+            render_text(ctx, atlases, resolve_font(font_name), text, pos_px);
+        }
+
+        // Convenience overloads that gather atlases from the global atlas manager
+        void render_text(core::Context& ctx,
+            FontId font_id,
+            const std::u32string& text,
+            ui::vec2 pos_px) const
         {
             const auto& atlas_vec = almondnamespace::atlasmanager::get_atlas_vector();
             if (atlas_vec.empty())
                 return;
 
             std::span<const TextureAtlas* const> atlas_span(atlas_vec.data(), atlas_vec.size());
-            render_text(ctx, atlas_span, font_name, text, pos_px);
+            render_text(ctx, atlas_span, font_id, text, pos_px);
+        }
+
+        void render_text(core::Context& ctx,
+            const std::string& font_name,
+            const std::u32string& text,
+            ui::vec2 pos_px) const
+        {
+            render_text(ctx, resolve_font(font_name), text, pos_px);
         }
 
     private:
@@ -337,12 +799,196 @@ namespace almondnamespace::font
 
         bool load_and_bake_font(const std::string& ttf_path,
             float size_pt,
+            const FontLoadOptions& options,
             std::vector<std::pair<char32_t, BakedGlyph>>& out_glyphs,
             FontMetrics& out_metrics,
             std::unordered_map<std::uint64_t, float>& out_kerning,
             Texture& out_texture);
 
-        std::unordered_map<std::string, FontAsset> loaded_fonts_{};
+        struct CachedRun
+        {
+            std::string key;    // font id, layout and raw text bytes; guards hash collisions
+            std::shared_ptr<const GlyphRun> run;
+            u64 glyphEpoch = 0; // GlyphCache::epoch() when shaped; stale once glyphs are evicted
+        };
+
+        template <typename CharT>
+        [[nodiscard]] static std::string make_run_key(FontId id,
+            std::basic_string_view<CharT> text, const RunLayout& layout)
+        {
+            std::string key(sizeof(FontId) + sizeof(RunLayout) + 1 + text.size() * sizeof(CharT), '\0');
+            char* out = key.data();
+            std::memcpy(out, &id, sizeof(FontId));
+            out += sizeof(FontId);
+            std::memcpy(out, &layout, sizeof(RunLayout));
+            out += sizeof(RunLayout);
+            *out++ = static_cast<char>(sizeof(CharT));
+            if (!text.empty())
+                std::memcpy(out, text.data(), text.size() * sizeof(CharT));
+            return key;
+        }
+
+        [[nodiscard]] static std::uint64_t hash_run_key(std::string_view key) noexcept
+        {
+            std::uint64_t h = 14695981039346656037ull;
+            for (const char c : key)
+            {
+                h ^= static_cast<unsigned char>(c);
+                h *= 1099511628211ull;
+            }
+            return h;
+        }
+
+        template <typename CharT>
+        [[nodiscard]] std::shared_ptr<const GlyphRun> shape_cached(FontId id,
+            std::basic_string_view<CharT> text, const RunLayout& layout) const
+        {
+            const FontAsset* font = get_font(id);
+            if (!font)
+                return std::make_shared<const GlyphRun>();
+
+            std::string key = make_run_key(id, text, layout);
+            const std::uint64_t hash = hash_run_key(key);
+            const u64 epoch = font->dynamicGlyphs ? font->dynamicGlyphs->epoch() : 0;
+            auto live = [&](const CachedRun& cached) { return cached.key == key && cached.glyphEpoch == epoch; };
+
+            std::lock_guard lock(run_cache_mutex_);
+            if (const auto it = run_cache_.find(hash); it != run_cache_.end() && live(it->second))
+                return it->second.run;
+
+            std::shared_ptr<const GlyphRun> run;
+            if (const auto it = run_cache_previous_.find(hash); it != run_cache_previous_.end() && live(it->second))
+                run = it->second.run;
+            else
+                run = std::make_shared<const GlyphRun>(shape_run(*font, text, layout));
+
+            if (run_cache_.size() >= RunCacheGeneration)
+            {
+                run_cache_previous_ = std::move(run_cache_);
+                run_cache_.clear();
+            }
+            run_cache_.insert_or_assign(hash, CachedRun{ std::move(key), run, epoch });
+            return run;
+        }
+
+        // Lays out `text` the way the GUI always has: kerning against the next
+        // glyph on the line, tabs as `tabSpaces` spaces, whitespace advancing
+        // without a quad, and a wrap before any glyph that would cross
+        // `wrapWidth`.
+        template <typename CharT>
+        [[nodiscard]] static GlyphRun shape_run(const FontAsset& font,
+            std::basic_string_view<CharT> text, const RunLayout& layout)
+        {
+            const float scale = layout.scale;
+            const FontMetrics& m = font.metrics;
+            const float baseHeight = (m.ascent > 0.0f || m.descent > 0.0f)
+                ? (m.ascent + m.descent) * scale
+                : 8.0f * scale;
+            const float lineAdvance = (m.ascent > 0.0f || m.descent > 0.0f || m.lineGap > 0.0f)
+                ? (m.ascent + m.descent + m.lineGap) * scale
+                : baseHeight;
+            const float ascent = (m.ascent > 0.0f) ? m.ascent * scale : baseHeight;
+
+            const auto fallback_it = font.glyphs.find(font.fallbackCodepoint);
+            const Glyph* fallback = (fallback_it != font.glyphs.end()) ? &fallback_it->second : nullptr;
+            // A dynamic glyph is copied into `acquired`, so the pointer is
+            // only good until the next lookup.
+            Glyph acquired{};
+            auto lookup = [&](char32_t cp) -> const Glyph* {
+                if (const auto it = font.glyphs.find(cp); it != font.glyphs.end())
+                    return &it->second;
+                if (font.dynamicGlyphs && font.dynamicGlyphs->acquire(cp, acquired))
+                    return &acquired;
+                return fallback;
+            };
+            auto to_cp = [](CharT c) {
+                if constexpr (sizeof(CharT) == 1)
+                    return static_cast<char32_t>(static_cast<unsigned char>(c));
+                else
+                    return static_cast<char32_t>(c);
+            };
+
+            float spaceAdvance = m.spaceAdvance * scale;
+            if (spaceAdvance <= 0.0f)
+            {
+                if (const Glyph* space = lookup(U' '))
+                    spaceAdvance = space->advance * scale;
+            }
+            if (spaceAdvance <= 0.0f)
+                spaceAdvance = (m.averageAdvance > 0.0f ? m.averageAdvance : 8.0f) * scale;
+
+            auto advance_of = [&](char32_t cp, const Glyph* glyph) {
+                if (cp == U'\t')
+                    return spaceAdvance * static_cast<float>(layout.tabSpaces);
+                if (glyph)
+                    return glyph->advance * scale;
+                return (m.averageAdvance > 0.0f ? m.averageAdvance : 8.0f) * scale;
+            };
+
+            const bool wraps = layout.wrapWidth > 0.0f;
+            const float limit = (std::max)(spaceAdvance, layout.wrapWidth) + 0.001f;
+
+            GlyphRun run{};
+            run.quads.reserve(text.size());
+            float penX = 0.0f;
+            float baseline = ascent;
+
+            for (std::size_t i = 0; i < text.size(); ++i)
+            {
+                const char32_t cp = to_cp(text[i]);
+                if (cp == U'\n')
+                {
+                    run.width = (std::max)(run.width, penX);
+                    penX = 0.0f;
+                    baseline += lineAdvance;
+                    ++run.lines;
+                    continue;
+                }
+
+                const Glyph* glyph = lookup(cp);
+                float advance = advance_of(cp, glyph);
+                if (i + 1 < text.size())
+                {
+                    const char32_t next = to_cp(text[i + 1]);
+                    if (next != U'\n')
+                        advance += font.get_kerning(cp, next) * scale;
+                }
+
+                if (wraps && penX + advance > limit)
+                {
+                    run.width = (std::max)(run.width, penX);
+                    penX = 0.0f;
+                    baseline += lineAdvance;
+                    ++run.lines;
+                }
+
+                if (glyph && cp != U' ' && cp != U'\t' && glyph->handle.is_valid())
+                {
+                    const float w = glyph->size_px.x * scale;
+                    const float h = glyph->size_px.y * scale;
+                    if (w > 0.0f && h > 0.0f)
+                    {
+                        run.quads.push_back({ glyph->handle,
+                            penX + glyph->offset_px.x * scale,
+                            baseline + glyph->offset_px.y * scale,
+                            w, h });
+                    }
+                }
+
+                penX += advance;
+            }
+
+            run.width = (std::max)(run.width, penX);
+            run.height = baseHeight + static_cast<float>(run.lines - 1) * lineAdvance;
+            return run;
+        }
+
+        std::vector<std::unique_ptr<FontAsset>> fonts_{};
+        std::unordered_map<std::string, FontId> font_ids_{};
+
+        mutable std::mutex run_cache_mutex_;
+        mutable std::unordered_map<std::uint64_t, CachedRun> run_cache_{};
+        mutable std::unordered_map<std::uint64_t, CachedRun> run_cache_previous_{};
     };
 
 } // namespace almondnamespace::font
@@ -0,0 +1,176 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // aframepacer.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+namespace almondnamespace::time
+{
+    //── Frame-time histogram ────────────────────────────────────//
+    // Fixed 0.25 ms buckets up to 100 ms plus one overflow bucket. Recording is
+    // a single increment so it can stay enabled in release builds.
+    class FrameTimeHistogram
+    {
+    public:
+        static constexpr double BucketMs = 0.25;
+        static constexpr std::size_t BucketCount = 400;
+
+        void record(double ms) noexcept
+        {
+            const double clamped = (std::max)(0.0, ms);
+            const auto bucket = static_cast<std::size_t>(clamped / BucketMs);
+            ++buckets[(std::min)(bucket, BucketCount)];
+            ++samples;
+            totalMs += clamped;
+            maxMs = (std::max)(maxMs, clamped);
+        }
+
+        void reset() noexcept
+        {
+            buckets.fill(0);
+            samples = 0;
+            totalMs = 0.0;
+            maxMs = 0.0;
+        }
+
+        [[nodiscard]] std::uint64_t count() const noexcept { return samples; }
+        [[nodiscard]] double max_ms() const noexcept { return maxMs; }
+        [[nodiscard]] double average_ms() const noexcept
+        {
+            return samples ? totalMs / static_cast<double>(samples) : 0.0;
+        }
+
+        // Upper edge of the bucket holding the p-th sample, p in [0, 1].
+        [[nodiscard]] double percentile_ms(double p) const noexcept
+        {
+            if (!samples) return 0.0;
+            const auto target = static_cast<std::uint64_t>(
+                std::clamp(p, 0.0, 1.0) * static_cast<double>(samples - 1)) + 1;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < BucketCount; ++i) {
+                seen += buckets[i];
+                if (seen >= target)
+                    return static_cast<double>(i + 1) * BucketMs;
+            }
+            return maxMs;
+        }
+
+        void print_summary(std::string_view label) const
+        {
+            std::cout << "[FramePacer] " << label << ": " << samples << " frames, avg "
+                << average_ms() << " ms, p50 " << percentile_ms(0.50) << " ms, p99 "
+                << percentile_ms(0.99) << " ms, max " << maxMs << " ms\n";
+        }
+
+    private:
+        std::array<std::uint64_t, BucketCount + 1> buckets{};
+        std::uint64_t samples = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    //── Frame pacer ─────────────────────────────────────────────//
+    // Deadline scheduler for loop tails. Instead of sleeping a fixed amount,
+    // each frame waits until its own deadline: the OS sleep covers everything
+    // but the last `spinThreshold`, which is spun to absorb scheduler jitter.
+    // A target rate of 0 (benchmark mode) or a vsync'ed present skips waiting
+    // entirely; frame times are recorded either way.
+    class FramePacer
+    {
+    public:
+        using SteadyClock = std::chrono::steady_clock;
+
+        FramePacer() = default;
+        explicit FramePacer(int targetHz) { set_target_rate(targetHz); }
+
+        void set_target_rate(int hz) noexcept
+        {
+            targetHz = (std::max)(0, hz);
+            period = targetHz > 0
+                ? std::chrono::duration_cast<SteadyClock::duration>(std::chrono::duration<double>(1.0 / targetHz))
+                : SteadyClock::duration::zero();
+            deadline = {};
+        }
+
+        [[nodiscard]] int target_rate() const noexcept { return targetHz; }
+        [[nodiscard]] bool uncapped() const noexcept { return targetHz == 0; }
+
+        void set_spin_threshold(SteadyClock::duration spin) noexcept { spinThreshold = spin; }
+
+        // Call once at the end of every loop iteration. `presentIsVsynced`
+        // reports whether the backend already blocked on vblank this frame.
+        void end_frame(bool presentIsVsynced = false)
+        {
+            if (!presentIsVsynced && targetHz > 0)
+                wait_for_deadline();
+
+            const auto frameEnd = SteadyClock::now();
+            if (lastFrameEnd != SteadyClock::time_point{})
+                frameTimes.record(std::chrono::duration<double, std::milli>(frameEnd - lastFrameEnd).count());
+            lastFrameEnd = frameEnd;
+        }
+
+        [[nodiscard]] const FrameTimeHistogram& histogram() const noexcept { return frameTimes; }
+        FrameTimeHistogram& histogram() noexcept { return frameTimes; }
+
+    private:
+        void wait_for_deadline()
+        {
+            const auto now = SteadyClock::now();
+            if (deadline == SteadyClock::time_point{} || now - deadline > period) {
+                // First frame, or we fell more than a frame behind: resync
+                // instead of bursting to catch up on missed deadlines.
+                deadline = now + period;
+            }
+            else {
+                deadline += period;
+            }
+
+            if (deadline - spinThreshold > now)
+                std::this_thread::sleep_until(deadline - spinThreshold);
+            while (SteadyClock::now() < deadline)
+                std::this_thread::yield();
+        }
+
+        int targetHz = 60;
+        SteadyClock::duration period = std::chrono::duration_cast<SteadyClock::duration>(std::chrono::duration<double>(1.0 / 60.0));
+#if defined(_WIN32)
+        // Default Win32 timer resolution is coarse; leave the spin more room.
+        SteadyClock::duration spinThreshold = std::chrono::milliseconds(2);
+#else
+        SteadyClock::duration spinThreshold = std::chrono::milliseconds(1);
+#endif
+        SteadyClock::time_point deadline{};
+        SteadyClock::time_point lastFrameEnd{};
+        FrameTimeHistogram frameTimes{};
+    };
+}
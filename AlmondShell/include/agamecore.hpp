@@ -25,17 +25,99 @@
 #pragma once
 
 #include "acontext.hpp"   // Context & draw_sprite()
+#include "agridscratch.hpp"
 
-#include <vector>
-#include <utility>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
 
 namespace almondnamespace
 {
     namespace gamecore
     {
+        // ─── Bit-packed storage ──────────────────────────────────────
+        // Flag grids (pellets, mines, occupancy) store 64 cells per word so
+        // counts, clears and "any left?" checks run a word at a time.
+        class bit_reference
+        {
+        public:
+            constexpr bit_reference(std::uint64_t& word, std::uint64_t mask) noexcept : word_(&word), mask_(mask) {}
+            constexpr operator bool() const noexcept { return (*word_ & mask_) != 0; }
+            constexpr bit_reference& operator=(bool value) noexcept
+            {
+                if (value) *word_ |= mask_; else *word_ &= ~mask_;
+                return *this;
+            }
+            constexpr bit_reference& operator=(const bit_reference& other) noexcept { return *this = bool(other); }
+
+        private:
+            std::uint64_t* word_;
+            std::uint64_t mask_;
+        };
+
+        class bit_vector
+        {
+        public:
+            bit_vector() = default;
+            bit_vector(std::size_t count, bool value) { assign(count, value); }
+
+            void assign(std::size_t count, bool value)
+            {
+                size_ = count;
+                words_.assign((count + 63) / 64, 0);
+                fill(value);
+            }
+
+            void fill(bool value) noexcept
+            {
+                std::fill(words_.begin(), words_.end(), value ? ~std::uint64_t{ 0 } : 0);
+                if (value && (size_ & 63))
+                    words_.back() &= (std::uint64_t{ 1 } << (size_ & 63)) - 1;
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept { return size_; }
+            [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+            [[nodiscard]] bool operator[](std::size_t i) const noexcept { return (words_[i >> 6] >> (i & 63)) & 1; }
+            [[nodiscard]] bit_reference operator[](std::size_t i) noexcept { return { words_[i >> 6], std::uint64_t{ 1 } << (i & 63) }; }
+
+            [[nodiscard]] std::size_t count() const noexcept
+            {
+                std::size_t n = 0;
+                for (const std::uint64_t w : words_) n += static_cast<std::size_t>(std::popcount(w));
+                return n;
+            }
+            [[nodiscard]] bool any() const noexcept
+            {
+                for (const std::uint64_t w : words_) if (w) return true;
+                return false;
+            }
+            [[nodiscard]] bool none() const noexcept { return !any(); }
+
+            // Bits past size() are always zero, so word-wise combining is safe.
+            [[nodiscard]] std::span<std::uint64_t> words() noexcept { return words_; }
+            [[nodiscard]] std::span<const std::uint64_t> words() const noexcept { return words_; }
+
+            friend bool operator==(const bit_vector&, const bit_vector&) = default;
+
+        private:
+            std::vector<std::uint64_t> words_;
+            std::size_t size_ = 0;
+        };
+
+        template <typename T>
+        struct grid_storage { using type = std::vector<T>; };
+
+        template <>
+        struct grid_storage<bool> { using type = bit_vector; };
+
         template <typename T>
-        using grid_t = std::vector<T>;
+        using grid_t = typename grid_storage<T>::type;
 
         template <typename T>
         inline grid_t<T> make_grid(std::size_t width, std::size_t height, T default_value) {
@@ -46,14 +128,9 @@ namespace almondnamespace
             return x < w && y < h;
         }
 
-        template <typename T>
-        inline decltype(auto) at(grid_t<T>& grid, std::size_t width, std::size_t height, std::size_t x, std::size_t y) {
-            assert(in_bounds(width, height, x, y) && "Grid access out of bounds!");
-            return grid[y * width + x];
-        }
-
-        template <typename T>
-        inline decltype(auto) at(const grid_t<T>& grid, std::size_t width, std::size_t height, std::size_t x, std::size_t y) {
+        // Takes any grid_t (const or not); grid_t<bool> yields a bit proxy.
+        template <typename Grid>
+        inline decltype(auto) at(Grid& grid, std::size_t width, std::size_t height, std::size_t x, std::size_t y) {
             assert(in_bounds(width, height, x, y) && "Grid access out of bounds!");
             return grid[y * width + x];
         }
@@ -62,18 +139,65 @@ namespace almondnamespace
             return y * w + x;
         }
 
-        inline std::vector<std::pair<std::size_t, std::size_t>>
-            neighbors(std::size_t w, std::size_t h, std::size_t x, std::size_t y) noexcept {
-            std::vector<std::pair<std::size_t, std::size_t>> n;
-            if (y > 0)          n.emplace_back(x, y - 1);
-            if (x + 1 < w)      n.emplace_back(x + 1, y);
-            if (y + 1 < h)      n.emplace_back(x, y + 1);
-            if (x > 0)          n.emplace_back(x - 1, y);
+        // ─── Neighbours ──────────────────────────────────────────────
+        enum class Connectivity : std::uint8_t { Four = 4, Eight = 8 };
+
+        // Clamp drops neighbours outside the grid; Wrap treats it as a torus.
+        enum class Edge : std::uint8_t { Clamp, Wrap };
+
+        // Up to eight cells held inline; iterating yields (x, y) pairs.
+        struct neighbor_set
+        {
+            std::array<std::pair<std::size_t, std::size_t>, 8> cells{};
+            std::size_t count = 0;
+
+            [[nodiscard]] constexpr const auto* begin() const noexcept { return cells.data(); }
+            [[nodiscard]] constexpr const auto* end() const noexcept { return cells.data() + count; }
+            [[nodiscard]] constexpr std::size_t size() const noexcept { return count; }
+            [[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+        };
+
+        // N, E, S, W first, then the diagonals NE, SE, SW, NW.
+        inline constexpr std::array<std::pair<int, int>, 8> neighbor_offsets{ {
+            { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 },
+            { 1, -1 }, { 1, 1 }, { -1, 1 }, { -1, -1 } } };
+
+        inline constexpr neighbor_set neighbors(std::size_t w, std::size_t h, std::size_t x, std::size_t y,
+            Connectivity connectivity = Connectivity::Four, Edge edge = Edge::Clamp) noexcept
+        {
+            neighbor_set n;
+            const std::size_t limit = static_cast<std::size_t>(connectivity);
+            for (std::size_t k = 0; k < limit; ++k)
+            {
+                const auto [dx, dy] = neighbor_offsets[k];
+                std::size_t nx = x + static_cast<std::size_t>(dx);
+                std::size_t ny = y + static_cast<std::size_t>(dy);
+                if (edge == Edge::Wrap)
+                {
+                    if (w < 3 || h < 3) // a narrow torus would list the same cell twice
+                    {
+                        if (nx >= w || ny >= h) continue;
+                    }
+                    nx = (dx < 0 && x == 0) ? w - 1 : (nx == w ? 0 : nx);
+                    ny = (dy < 0 && y == 0) ? h - 1 : (ny == h ? 0 : ny);
+                }
+                else if (nx >= w || ny >= h)
+                {
+                    continue;
+                }
+                n.cells[n.count++] = { nx, ny };
+            }
             return n;
         }
 
-        template<typename T>
-        inline bool is_free(const grid_t<T>& grid,
+        inline constexpr neighbor_set neighbors8(std::size_t w, std::size_t h, std::size_t x, std::size_t y,
+            Edge edge = Edge::Clamp) noexcept
+        {
+            return neighbors(w, h, x, y, Connectivity::Eight, edge);
+        }
+
+        template<typename Grid, typename T>
+        inline bool is_free(const Grid& grid,
             std::size_t w, std::size_t h,
             std::size_t x, std::size_t y,
             T free_tile_value) noexcept
@@ -81,6 +205,188 @@ namespace almondnamespace
             return in_bounds(w, h, x, y) && grid[idx(w, x, y)] == free_tile_value;
         }
 
+        // ─── Fixed-size grids ────────────────────────────────────────
+        // Board dimensions known at compile time: storage lives inline, so
+        // a game state holding these is trivially copyable.
+        template <typename T, std::size_t W, std::size_t H>
+        struct static_grid
+        {
+            static constexpr std::size_t width = W;
+            static constexpr std::size_t height = H;
+            static constexpr std::size_t cell_count = W * H;
+
+            std::array<T, W * H> cells{};
+
+            [[nodiscard]] static constexpr bool contains(std::size_t x, std::size_t y) noexcept { return x < W && y < H; }
+            [[nodiscard]] static constexpr std::size_t index(std::size_t x, std::size_t y) noexcept { return y * W + x; }
+
+            [[nodiscard]] constexpr T& operator()(std::size_t x, std::size_t y) noexcept
+            {
+                assert(contains(x, y) && "Grid access out of bounds!");
+                return cells[index(x, y)];
+            }
+            [[nodiscard]] constexpr const T& operator()(std::size_t x, std::size_t y) const noexcept
+            {
+                assert(contains(x, y) && "Grid access out of bounds!");
+                return cells[index(x, y)];
+            }
+            [[nodiscard]] constexpr T& operator[](std::size_t i) noexcept { return cells[i]; }
+            [[nodiscard]] constexpr const T& operator[](std::size_t i) const noexcept { return cells[i]; }
+
+            constexpr void fill(const T& value) noexcept { cells.fill(value); }
+            [[nodiscard]] constexpr auto begin() noexcept { return cells.begin(); }
+            [[nodiscard]] constexpr auto end() noexcept { return cells.end(); }
+            [[nodiscard]] constexpr auto begin() const noexcept { return cells.begin(); }
+            [[nodiscard]] constexpr auto end() const noexcept { return cells.end(); }
+            [[nodiscard]] constexpr std::span<T> span() noexcept { return cells; }
+            [[nodiscard]] constexpr std::span<const T> span() const noexcept { return cells; }
+
+            friend constexpr bool operator==(const static_grid&, const static_grid&) = default;
+        };
+
+        template <std::size_t W, std::size_t H>
+        struct static_grid<bool, W, H>
+        {
+            static constexpr std::size_t width = W;
+            static constexpr std::size_t height = H;
+            static constexpr std::size_t cell_count = W * H;
+            static constexpr std::size_t word_count = (W * H + 63) / 64;
+
+            std::array<std::uint64_t, word_count> bits{};
+
+            [[nodiscard]] static constexpr bool contains(std::size_t x, std::size_t y) noexcept { return x < W && y < H; }
+            [[nodiscard]] static constexpr std::size_t index(std::size_t x, std::size_t y) noexcept { return y * W + x; }
+
+            [[nodiscard]] constexpr bool operator()(std::size_t x, std::size_t y) const noexcept
+            {
+                assert(contains(x, y) && "Grid access out of bounds!");
+                return (*this)[index(x, y)];
+            }
+            [[nodiscard]] constexpr bit_reference operator()(std::size_t x, std::size_t y) noexcept
+            {
+                assert(contains(x, y) && "Grid access out of bounds!");
+                return (*this)[index(x, y)];
+            }
+            [[nodiscard]] constexpr bool operator[](std::size_t i) const noexcept { return (bits[i >> 6] >> (i & 63)) & 1; }
+            [[nodiscard]] constexpr bit_reference operator[](std::size_t i) noexcept { return { bits[i >> 6], std::uint64_t{ 1 } << (i & 63) }; }
+
+            constexpr void fill(bool value) noexcept
+            {
+                bits.fill(value ? ~std::uint64_t{ 0 } : 0);
+                if (value && (cell_count & 63))
+                    bits.back() &= (std::uint64_t{ 1 } << (cell_count & 63)) - 1;
+            }
+            [[nodiscard]] constexpr std::size_t count() const noexcept
+            {
+                std::size_t n = 0;
+                for (const std::uint64_t w : bits) n += static_cast<std::size_t>(std::popcount(w));
+                return n;
+            }
+            [[nodiscard]] constexpr bool any() const noexcept
+            {
+                for (const std::uint64_t w : bits) if (w) return true;
+                return false;
+            }
+            [[nodiscard]] constexpr bool none() const noexcept { return !any(); }
+
+            friend constexpr bool operator==(const static_grid&, const static_grid&) = default;
+        };
+
+        // ─── Flood fill / BFS ────────────────────────────────────────
+        // 4-connected fill from (sx, sy) over cells where inside(x, y) holds.
+        // Works a run at a time: each row span is filled left to right and
+        // only one seed per run is pushed for the rows above and below.
+        // fill(x, y) is called once per cell; returns the number filled.
+        template <typename Inside, typename Fill>
+        std::size_t scanline_fill(std::size_t w, std::size_t h, std::size_t sx, std::size_t sy,
+            grid_scratch& scratch, Inside&& inside, Fill&& fill)
+        {
+            scratch.begin(w * h);
+            if (!in_bounds(w, h, sx, sy))
+                return 0;
+
+            std::size_t filled = 0;
+            auto open = [&](std::size_t x, std::size_t y) {
+                return !scratch.visited(idx(w, x, y)) && inside(x, y);
+            };
+            auto seed_row = [&](std::size_t lx, std::size_t rx, std::size_t y) {
+                bool inRun = false;
+                for (std::size_t x = lx; x <= rx; ++x)
+                {
+                    const bool o = open(x, y);
+                    if (o && !inRun)
+                        scratch.queue.push_back(static_cast<std::uint32_t>(idx(w, x, y)));
+                    inRun = o;
+                }
+            };
+
+            scratch.queue.push_back(static_cast<std::uint32_t>(idx(w, sx, sy)));
+            while (!scratch.queue.empty())
+            {
+                const std::size_t i = scratch.queue.back();
+                scratch.queue.pop_back();
+                const std::size_t y = i / w;
+                std::size_t lx = i % w;
+                if (!open(lx, y))
+                    continue;
+
+                std::size_t rx = lx;
+                while (lx > 0 && open(lx - 1, y)) --lx;
+                while (rx + 1 < w && open(rx + 1, y)) ++rx;
+                for (std::size_t x = lx; x <= rx; ++x)
+                {
+                    scratch.mark(idx(w, x, y));
+                    fill(x, y);
+                }
+                filled += rx - lx + 1;
+
+                if (y > 0) seed_row(lx, rx, y - 1);
+                if (y + 1 < h) seed_row(lx, rx, y + 1);
+            }
+            return filled;
+        }
+
+        // Breadth-first walk from (sx, sy). visit(x, y, distance) sees every
+        // reached cell once, nearest first, and returns whether the search
+        // may continue through it (false for walls, or for minesweeper's
+        // numbered border cells). Returns the number of cells visited.
+        template <typename Visit>
+        std::size_t bfs(std::size_t w, std::size_t h, std::size_t sx, std::size_t sy,
+            grid_scratch& scratch, Visit&& visit,
+            Connectivity connectivity = Connectivity::Four, Edge edge = Edge::Clamp)
+        {
+            scratch.begin(w * h);
+            if (!in_bounds(w, h, sx, sy))
+                return 0;
+
+            scratch.mark(idx(w, sx, sy));
+            scratch.queue.push_back(static_cast<std::uint32_t>(idx(w, sx, sy)));
+            std::size_t head = 0;
+            std::size_t levelEnd = 1;
+            std::uint32_t distance = 0;
+            while (head < scratch.queue.size())
+            {
+                if (head == levelEnd)
+                {
+                    levelEnd = scratch.queue.size();
+                    ++distance;
+                }
+                const std::size_t i = scratch.queue[head++];
+                const std::size_t x = i % w, y = i / w;
+                if (!visit(x, y, distance))
+                    continue;
+                for (const auto& [nx, ny] : neighbors(w, h, x, y, connectivity, edge))
+                {
+                    const std::size_t n = idx(w, nx, ny);
+                    if (scratch.visited(n))
+                        continue;
+                    scratch.mark(n);
+                    scratch.queue.push_back(static_cast<std::uint32_t>(n));
+                }
+            }
+            return scratch.queue.size();
+        }
+
         // --- Shared atlas pointers storage ---
         inline std::vector<const TextureAtlas*> g_atlases;
 
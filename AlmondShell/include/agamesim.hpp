@@ -0,0 +1,221 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // agamesim.hpp
+#pragma once
+
+#include "aenginesystems.hpp"   // scheduler_parallel_for
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace almondnamespace::gamesim
+{
+    // Seed scrambler: consecutive inputs give unrelated outputs, so instance
+    // i of a batch can be seeded with base + i.
+    [[nodiscard]] constexpr std::uint64_t splitmix64(std::uint64_t x) noexcept
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // xorshift64*: one word of state, so game states embedding it stay
+    // small and trivially copyable (std::mt19937 is 2.5 KB).
+    struct SimRng
+    {
+        std::uint64_t state = 0x9E3779B97F4A7C15ull;
+
+        constexpr SimRng() noexcept = default;
+        constexpr explicit SimRng(std::uint64_t seed) noexcept : state(splitmix64(seed) | 1u) {}
+
+        constexpr std::uint64_t next() noexcept
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 0x2545F4914F6CDD1Dull;
+        }
+
+        // Uniform in [0, n) (multiply-shift; bias is below 2^-32).
+        constexpr std::uint32_t below(std::uint32_t n) noexcept
+        {
+            return static_cast<std::uint32_t>(((next() >> 32) * n) >> 32);
+        }
+
+        friend constexpr bool operator==(const SimRng&, const SimRng&) = default;
+    };
+
+    struct StepResult
+    {
+        float reward = 0.0f;
+        bool done = false;    // episode ended (won, lost or stuck)
+    };
+
+    // A rules object turns a seed into a fresh State and advances a State
+    // by one Action. Both must be pure: everything random comes from the
+    // RNG inside the state, so a state copy replays identically.
+    template <typename Rules>
+    concept GameRules = std::copy_constructible<typename Rules::State>
+        && requires(const Rules& rules, typename Rules::State& state, std::uint64_t seed, std::size_t i)
+    {
+        { rules.reset(seed) } -> std::same_as<typename Rules::State>;
+        { rules.step(state, typename Rules::Action{}) } -> std::same_as<StepResult>;
+        { rules.action_count() } -> std::convertible_to<std::size_t>;
+        { rules.action(i) } -> std::same_as<typename Rules::Action>;
+    };
+
+    struct BatchStats
+    {
+        std::uint64_t steps = 0;
+        std::uint64_t episodes = 0;   // episodes that finished (or were truncated)
+        double reward = 0.0;
+    };
+
+    // ─── BatchRunner ──────────────────────────────────────────────
+    // N independent instances of one game stepped together across the
+    // worker pool. Instance i is seeded from (seed, i) and re-seeds itself
+    // from its own stream when an episode ends, so results do not depend
+    // on how the work was split between threads.
+    template <GameRules Rules>
+    class BatchRunner
+    {
+    public:
+        using State = typename Rules::State;
+        using Action = typename Rules::Action;
+
+        // Instances per pool task; small enough to balance, large enough
+        // that scheduling cost vanishes next to the stepping.
+        static constexpr std::size_t ChunkSize = 256;
+
+        BatchRunner(Rules rules, std::size_t count, std::uint64_t seed, std::uint32_t maxEpisodeSteps = 0)
+            : rules_(std::move(rules)), maxEpisodeSteps_(maxEpisodeSteps)
+        {
+            states_.reserve(count);
+            rngs_.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                rngs_.emplace_back(splitmix64(seed + i));
+                states_.push_back(rules_.reset(rngs_.back().next()));
+            }
+            episodeSteps_.assign(count, 0);
+            results_.assign(count, {});
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return states_.size(); }
+        [[nodiscard]] const Rules& rules() const noexcept { return rules_; }
+        [[nodiscard]] std::span<const State> states() const noexcept { return states_; }
+        // Results of the last step; `done` instances have already restarted.
+        [[nodiscard]] std::span<const StepResult> results() const noexcept { return results_; }
+
+        // Applies actions[i] to instance i; a span shorter than size() is
+        // rejected without stepping anything.
+        BatchStats step(std::span<const Action> actions)
+        {
+            if (actions.size() < states_.size())
+            {
+                std::cerr << "[BatchRunner] step() given " << actions.size()
+                          << " actions for " << states_.size() << " instances\n";
+                return {};
+            }
+            return for_chunks([&](std::size_t i, BatchStats& stats) {
+                advance(i, actions[i], stats);
+            });
+        }
+
+        // `policy(state, rng) -> Action` drives every instance for `steps`
+        // steps; rng is that instance's private stream.
+        template <typename Policy>
+        BatchStats run(std::size_t steps, Policy&& policy)
+        {
+            return for_chunks([&](std::size_t i, BatchStats& stats) {
+                for (std::size_t s = 0; s < steps; ++s)
+                    advance(i, policy(std::as_const(states_[i]), rngs_[i]), stats);
+            });
+        }
+
+        // Uniformly random actions; the usual throughput baseline.
+        BatchStats run_random(std::size_t steps)
+        {
+            const auto count = static_cast<std::uint32_t>(rules_.action_count());
+            return run(steps, [this, count](const State&, SimRng& rng) { return rules_.action(rng.below(count)); });
+        }
+
+    private:
+        void advance(std::size_t i, Action action, BatchStats& stats)
+        {
+            StepResult result = rules_.step(states_[i], action);
+            ++stats.steps;
+            stats.reward += result.reward;
+            if (maxEpisodeSteps_ && ++episodeSteps_[i] >= maxEpisodeSteps_)
+                result.done = true;
+            if (result.done)
+            {
+                ++stats.episodes;
+                episodeSteps_[i] = 0;
+                states_[i] = rules_.reset(rngs_[i].next());
+            }
+            results_[i] = result;
+        }
+
+        template <typename Body>
+        BatchStats for_chunks(Body&& body)
+        {
+            const std::size_t n = states_.size();
+            const std::size_t chunks = (n + ChunkSize - 1) / ChunkSize;
+            partial_.assign(chunks, {});
+            scheduler_parallel_for(chunks, [&](std::size_t c) {
+                BatchStats local{};
+                const std::size_t end = (std::min)(n, (c + 1) * ChunkSize);
+                for (std::size_t i = c * ChunkSize; i < end; ++i)
+                    body(i, local);
+                partial_[c] = local;
+            });
+
+            BatchStats total{};
+            for (const BatchStats& p : partial_)
+            {
+                total.steps += p.steps;
+                total.episodes += p.episodes;
+                total.reward += p.reward;
+            }
+            return total;
+        }
+
+        Rules rules_;
+        std::uint32_t maxEpisodeSteps_ = 0;
+        std::vector<State> states_;
+        std::vector<SimRng> rngs_;
+        std::vector<std::uint32_t> episodeSteps_;
+        std::vector<StepResult> results_;
+        std::vector<BatchStats> partial_;
+    };
+
+} // namespace almondnamespace::gamesim
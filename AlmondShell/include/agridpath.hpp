@@ -0,0 +1,636 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // agridpath.hpp
+#pragma once
+
+#include "agamecore.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace almondnamespace::gamecore
+{
+    struct GridPoint
+    {
+        int x = 0;
+        int y = 0;
+        friend constexpr bool operator==(GridPoint, GridPoint) = default;
+    };
+
+    // ─── Walkability ──────────────────────────────────────────────
+    // Bit-packed open/blocked map. Every toggle bumps version() and is
+    // logged so flow fields can repair themselves instead of rebuilding.
+    class WalkGrid
+    {
+    public:
+        WalkGrid() = default;
+        WalkGrid(int width, int height, bool open = true)
+            : width_((std::max)(0, width)), height_((std::max)(0, height)),
+            open_(std::size_t(width_) * height_, open)
+        {
+        }
+
+        template <typename Grid, typename Pred>
+        [[nodiscard]] static WalkGrid from(const Grid& grid, int width, int height, Pred&& walkable)
+        {
+            WalkGrid walk(width, height, false);
+            for (std::size_t i = 0; i < walk.open_.size(); ++i)
+                walk.open_[i] = bool(walkable(grid[i]));
+            return walk;
+        }
+
+        [[nodiscard]] int width() const noexcept { return width_; }
+        [[nodiscard]] int height() const noexcept { return height_; }
+        [[nodiscard]] std::size_t cell_count() const noexcept { return open_.size(); }
+        [[nodiscard]] std::uint64_t version() const noexcept { return version_; }
+
+        [[nodiscard]] bool contains(int x, int y) const noexcept
+        {
+            return unsigned(x) < unsigned(width_) && unsigned(y) < unsigned(height_);
+        }
+        [[nodiscard]] bool walkable(int x, int y) const noexcept
+        {
+            return contains(x, y) && open_[std::size_t(y) * width_ + x];
+        }
+
+        void set_walkable(int x, int y, bool open)
+        {
+            if (!contains(x, y) || walkable(x, y) == open)
+                return;
+            const std::size_t i = std::size_t(y) * width_ + x;
+            open_[i] = open;
+            ++version_;
+            log_.push_back(static_cast<std::uint32_t>(i));
+            if (log_.size() > MaxLog)
+            {
+                const std::size_t drop = log_.size() / 2;
+                log_.erase(log_.begin(), log_.begin() + std::ptrdiff_t(drop));
+                logBase_ += drop;
+            }
+        }
+
+        // Cells toggled after version `since` (possibly repeated); nullopt
+        // once the log no longer reaches that far back.
+        [[nodiscard]] std::optional<std::span<const std::uint32_t>> changes_since(std::uint64_t since) const noexcept
+        {
+            if (since < logBase_ || since > version_)
+                return std::nullopt;
+            return std::span<const std::uint32_t>(log_.data() + (since - logBase_), std::size_t(version_ - since));
+        }
+
+    private:
+        static constexpr std::size_t MaxLog = 1u << 16;
+
+        int width_ = 0;
+        int height_ = 0;
+        bit_vector open_;
+        std::vector<std::uint32_t> log_;
+        std::uint64_t logBase_ = 0;   // log_[i] is change logBase_ + i + 1
+        std::uint64_t version_ = 0;
+    };
+
+    namespace pathdetail
+    {
+        // Costs are ×10 so diagonals (√2 ≈ 1.4) stay integral.
+        inline constexpr std::uint32_t StraightCost = 10;
+        inline constexpr std::uint32_t DiagonalCost = 14;
+
+        [[nodiscard]] constexpr std::uint32_t step_cost(std::size_t k) noexcept { return k < 4 ? StraightCost : DiagonalCost; }
+
+        // Index into neighbor_offsets of the reverse direction.
+        [[nodiscard]] constexpr std::size_t opposite(std::size_t k) noexcept { return k < 4 ? (k + 2) % 4 : 4 + (k - 2) % 4; }
+
+        // Diagonals never cut a blocked corner.
+        [[nodiscard]] inline bool can_step(const WalkGrid& grid, int x, int y, std::size_t k) noexcept
+        {
+            const auto [dx, dy] = neighbor_offsets[k];
+            if (!grid.walkable(x + dx, y + dy))
+                return false;
+            return k < 4 || (grid.walkable(x + dx, y) && grid.walkable(x, y + dy));
+        }
+
+        [[nodiscard]] inline std::uint32_t heuristic(GridPoint a, GridPoint b, Connectivity connectivity) noexcept
+        {
+            const std::uint32_t dx = std::uint32_t(std::abs(a.x - b.x));
+            const std::uint32_t dy = std::uint32_t(std::abs(a.y - b.y));
+            if (connectivity == Connectivity::Four)
+                return StraightCost * (dx + dy);
+            return StraightCost * (dx + dy) - (2 * StraightCost - DiagonalCost) * (std::min)(dx, dy);
+        }
+
+        using HeapEntry = std::pair<std::uint32_t, std::uint32_t>; // (priority, cell)
+
+        inline void heap_push(std::vector<HeapEntry>& heap, std::uint32_t priority, std::uint32_t cell)
+        {
+            heap.emplace_back(priority, cell);
+            std::push_heap(heap.begin(), heap.end(), std::greater<>{});
+        }
+
+        inline HeapEntry heap_pop(std::vector<HeapEntry>& heap)
+        {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+            const HeapEntry top = heap.back();
+            heap.pop_back();
+            return top;
+        }
+    }
+
+    // ─── A* / JPS ─────────────────────────────────────────────────
+    // Per-search state reused between calls; stamps make a new search
+    // O(1) to start regardless of map size.
+    struct PathScratch
+    {
+        std::vector<std::uint32_t> g;
+        std::vector<std::uint32_t> parent;
+        std::vector<std::uint32_t> seen;
+        std::vector<std::uint32_t> closed;
+        std::vector<pathdetail::HeapEntry> open;
+        std::uint32_t epoch = 0;
+
+        void begin(std::size_t cells)
+        {
+            if (seen.size() != cells)
+            {
+                g.assign(cells, 0);
+                parent.assign(cells, 0);
+                seen.assign(cells, 0);
+                closed.assign(cells, 0);
+                epoch = 0;
+            }
+            if (++epoch == 0)
+            {
+                std::fill(seen.begin(), seen.end(), 0);
+                std::fill(closed.begin(), closed.end(), 0);
+                epoch = 1;
+            }
+            open.clear();
+        }
+    };
+
+    namespace pathdetail
+    {
+        template <typename Expand>
+        bool search(const WalkGrid& grid, GridPoint from, GridPoint to, Connectivity connectivity,
+            PathScratch& scratch, std::vector<GridPoint>& path, Expand&& expand)
+        {
+            path.clear();
+            if (!grid.walkable(from.x, from.y) || !grid.walkable(to.x, to.y))
+                return false;
+
+            const int w = grid.width();
+            const auto index = [w](GridPoint p) { return std::uint32_t(p.y * w + p.x); };
+            const auto point = [w](std::uint32_t i) { return GridPoint{ int(i % std::uint32_t(w)), int(i / std::uint32_t(w)) }; };
+
+            scratch.begin(grid.cell_count());
+            const std::uint32_t start = index(from), goal = index(to);
+            scratch.g[start] = 0;
+            scratch.parent[start] = start;
+            scratch.seen[start] = scratch.epoch;
+            heap_push(scratch.open, heuristic(from, to, connectivity), start);
+
+            auto offer = [&](std::uint32_t cell, std::uint32_t g, std::uint32_t parent) {
+                if (scratch.closed[cell] == scratch.epoch)
+                    return;
+                if (scratch.seen[cell] == scratch.epoch && scratch.g[cell] <= g)
+                    return;
+                scratch.seen[cell] = scratch.epoch;
+                scratch.g[cell] = g;
+                scratch.parent[cell] = parent;
+                heap_push(scratch.open, g + heuristic(point(cell), to, connectivity), cell);
+            };
+
+            while (!scratch.open.empty())
+            {
+                const auto [f, cell] = heap_pop(scratch.open);
+                if (scratch.closed[cell] == scratch.epoch)
+                    continue;
+                scratch.closed[cell] = scratch.epoch;
+                if (cell == goal)
+                {
+                    // Parents may be jump points several cells apart; walk
+                    // each straight/diagonal segment back cell by cell.
+                    for (std::uint32_t c = goal; c != start; c = scratch.parent[c])
+                    {
+                        const GridPoint p = point(c);
+                        const GridPoint q = point(scratch.parent[c]);
+                        const int sx = (q.x > p.x) - (q.x < p.x);
+                        const int sy = (q.y > p.y) - (q.y < p.y);
+                        for (GridPoint s = p; s != q; s.x += sx, s.y += sy)
+                            path.push_back(s);
+                    }
+                    path.push_back(from);
+                    std::reverse(path.begin(), path.end());
+                    return true;
+                }
+                expand(point(cell), point(scratch.parent[cell]), cell == start, scratch.g[cell],
+                    [&](GridPoint next, std::uint32_t g, GridPoint parent) { offer(index(next), g, index(parent)); });
+            }
+            return false;
+        }
+    }
+
+    // Shortest path including both endpoints; false when unreachable.
+    inline bool find_path_astar(const WalkGrid& grid, GridPoint from, GridPoint to, std::vector<GridPoint>& path,
+        PathScratch& scratch, Connectivity connectivity = Connectivity::Four)
+    {
+        const std::size_t directions = static_cast<std::size_t>(connectivity);
+        return pathdetail::search(grid, from, to, connectivity, scratch, path,
+            [&](GridPoint p, GridPoint, bool, std::uint32_t g, auto&& offer) {
+                for (std::size_t k = 0; k < directions; ++k)
+                {
+                    if (!pathdetail::can_step(grid, p.x, p.y, k))
+                        continue;
+                    const auto [dx, dy] = neighbor_offsets[k];
+                    offer(GridPoint{ p.x + dx, p.y + dy }, g + pathdetail::step_cost(k), p);
+                }
+            });
+    }
+
+    namespace pathdetail
+    {
+        // Jump from (x, y) heading (dx, dy) until a jump point, the goal,
+        // or a dead end. Diagonal scans probe both straight components.
+        inline std::optional<GridPoint> jump(const WalkGrid& grid, int x, int y, int dx, int dy, GridPoint goal)
+        {
+            for (;;)
+            {
+                if (!grid.walkable(x, y))
+                    return std::nullopt;
+                if (GridPoint{ x, y } == goal)
+                    return GridPoint{ x, y };
+
+                if (dx != 0 && dy != 0)
+                {
+                    if (jump(grid, x + dx, y, dx, 0, goal) || jump(grid, x, y + dy, 0, dy, goal))
+                        return GridPoint{ x, y };
+                }
+                else if (dx != 0)
+                {
+                    if ((grid.walkable(x, y - 1) && !grid.walkable(x - dx, y - 1)) ||
+                        (grid.walkable(x, y + 1) && !grid.walkable(x - dx, y + 1)))
+                        return GridPoint{ x, y };
+                }
+                else
+                {
+                    if ((grid.walkable(x - 1, y) && !grid.walkable(x - 1, y - dy)) ||
+                        (grid.walkable(x + 1, y) && !grid.walkable(x + 1, y - dy)))
+                        return GridPoint{ x, y };
+                }
+
+                if (!grid.walkable(x + dx, y) || !grid.walkable(x, y + dy))
+                    return std::nullopt;
+                x += dx;
+                y += dy;
+            }
+        }
+    }
+
+    // Jump Point Search: 8-connected, no corner cutting, same path cost as
+    // A* with Connectivity::Eight but far fewer heap operations on open maps.
+    inline bool find_path_jps(const WalkGrid& grid, GridPoint from, GridPoint to, std::vector<GridPoint>& path,
+        PathScratch& scratch)
+    {
+        return pathdetail::search(grid, from, to, Connectivity::Eight, scratch, path,
+            [&](GridPoint p, GridPoint parent, bool isStart, std::uint32_t g, auto&& offer) {
+                // Pruned directions: natural plus forced neighbours of the
+                // incoming move, or all eight from the start cell.
+                std::array<std::pair<int, int>, 8> dirs{};
+                std::size_t count = 0;
+                const auto add = [&](int dx, int dy) { dirs[count++] = { dx, dy }; };
+                const auto open = [&](int x, int y) { return grid.walkable(x, y); };
+
+                if (isStart)
+                {
+                    for (std::size_t k = 0; k < 8; ++k)
+                        if (pathdetail::can_step(grid, p.x, p.y, k))
+                            add(neighbor_offsets[k].first, neighbor_offsets[k].second);
+                }
+                else
+                {
+                    const int dx = (p.x > parent.x) - (p.x < parent.x);
+                    const int dy = (p.y > parent.y) - (p.y < parent.y);
+                    if (dx != 0 && dy != 0)
+                    {
+                        const bool openY = open(p.x, p.y + dy), openX = open(p.x + dx, p.y);
+                        if (openY) add(0, dy);
+                        if (openX) add(dx, 0);
+                        if (openX && openY) add(dx, dy);
+                    }
+                    else if (dx != 0)
+                    {
+                        const bool next = open(p.x + dx, p.y), up = open(p.x, p.y - 1), down = open(p.x, p.y + 1);
+                        if (next)
+                        {
+                            add(dx, 0);
+                            if (up) add(dx, -1);
+                            if (down) add(dx, 1);
+                        }
+                        if (up) add(0, -1);
+                        if (down) add(0, 1);
+                    }
+                    else
+                    {
+                        const bool next = open(p.x, p.y + dy), left = open(p.x - 1, p.y), right = open(p.x + 1, p.y);
+                        if (next)
+                        {
+                            add(0, dy);
+                            if (left) add(-1, dy);
+                            if (right) add(1, dy);
+                        }
+                        if (left) add(-1, 0);
+                        if (right) add(1, 0);
+                    }
+                }
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const auto [dx, dy] = dirs[i];
+                    if (const auto jp = pathdetail::jump(grid, p.x + dx, p.y + dy, dx, dy, to))
+                        offer(*jp, g + pathdetail::heuristic(p, *jp, Connectivity::Eight), p);
+                }
+            });
+    }
+
+    // ─── Flow fields ──────────────────────────────────────────────
+    // Distance-to-target for every cell plus the direction to step, so any
+    // number of chasers share one search and each move is a lookup. When
+    // the WalkGrid changes, sync() repairs only the affected region.
+    class FlowField
+    {
+    public:
+        static constexpr std::uint32_t Unreachable = (std::numeric_limits<std::uint32_t>::max)();
+        static constexpr std::uint8_t NoDirection = 0xFF;
+
+        void build(const WalkGrid& grid, GridPoint target, Connectivity connectivity = Connectivity::Four)
+        {
+            target_ = target;
+            connectivity_ = connectivity;
+            width_ = grid.width();
+            height_ = grid.height();
+            version_ = grid.version();
+            dist_.assign(grid.cell_count(), Unreachable);
+            dir_.assign(grid.cell_count(), NoDirection);
+            heap_.clear();
+            if (!grid.walkable(target.x, target.y))
+                return;
+            const std::uint32_t t = index(target.x, target.y);
+            dist_[t] = 0;
+            pathdetail::heap_push(heap_, 0, t);
+            relax(grid);
+        }
+
+        // Brings the field up to date with `grid`; returns false when the
+        // grid's change log no longer reached back and a rebuild was done.
+        bool sync(const WalkGrid& grid)
+        {
+            if (grid.version() == version_ && grid.width() == width_ && grid.height() == height_)
+                return true;
+            const auto changes = grid.width() == width_ && grid.height() == height_
+                ? grid.changes_since(version_) : std::nullopt;
+            // A blocked target leaves nothing to repair from, and one that
+            // was blocked at the last build has no seed yet: rebuild both.
+            if (!changes || !grid.walkable(target_.x, target_.y) || dist_[index(target_.x, target_.y)] != 0)
+            {
+                build(grid, target_, connectivity_);
+                return false;
+            }
+
+            version_ = grid.version();
+            heap_.clear();
+            raised_.clear();
+            const std::size_t directions = static_cast<std::size_t>(connectivity_);
+
+            // Invalidate every cell whose route ran through a newly blocked
+            // cell (or squeezed diagonally past one). The corner check runs
+            // even when the cell was already raised by a neighbour blocked
+            // in the same batch.
+            for (const std::uint32_t c : *changes)
+            {
+                const int cx = int(c % std::uint32_t(width_)), cy = int(c / std::uint32_t(width_));
+                if (grid.walkable(cx, cy))
+                    continue;
+                raise(c);
+                for (std::size_t k = 0; k < 8; ++k)
+                {
+                    const auto [dx, dy] = neighbor_offsets[k];
+                    const int nx = cx + dx, ny = cy + dy;
+                    if (!grid.contains(nx, ny))
+                        continue;
+                    const std::uint32_t n = index(nx, ny);
+                    if (dir_[n] != NoDirection && !pathdetail::can_step(grid, nx, ny, dir_[n]))
+                        raise(n);
+                }
+            }
+            for (std::size_t head = 0; head < raised_.size(); ++head)
+            {
+                const std::uint32_t r = raised_[head];
+                const int rx = int(r % std::uint32_t(width_)), ry = int(r / std::uint32_t(width_));
+                for (std::size_t k = 0; k < directions; ++k)
+                {
+                    const auto [dx, dy] = neighbor_offsets[k];
+                    if (!grid.contains(rx + dx, ry + dy))
+                        continue;
+                    const std::uint32_t n = index(rx + dx, ry + dy);
+                    if (dir_[n] == pathdetail::opposite(k))
+                        raise(n);
+                }
+            }
+
+            // Reseed invalidated cells from their still-valid neighbours;
+            // newly opened cells re-relax from everything around them so
+            // diagonals they unblock are picked up too.
+            for (const std::uint32_t r : raised_)
+                reseed(grid, r);
+            for (const std::uint32_t c : *changes)
+            {
+                const int cx = int(c % std::uint32_t(width_)), cy = int(c / std::uint32_t(width_));
+                if (!grid.walkable(cx, cy))
+                    continue;
+                reseed(grid, c);
+                for (std::size_t k = 0; k < 8; ++k)
+                {
+                    const auto [dx, dy] = neighbor_offsets[k];
+                    if (!grid.contains(cx + dx, cy + dy))
+                        continue;
+                    const std::uint32_t n = index(cx + dx, cy + dy);
+                    if (dist_[n] != Unreachable)
+                        pathdetail::heap_push(heap_, dist_[n], n);
+                }
+            }
+            relax(grid);
+            return true;
+        }
+
+        [[nodiscard]] GridPoint target() const noexcept { return target_; }
+        [[nodiscard]] Connectivity connectivity() const noexcept { return connectivity_; }
+
+        // In StraightCost units (10 per orthogonal step).
+        [[nodiscard]] std::uint32_t distance(int x, int y) const noexcept
+        {
+            return contains(x, y) ? dist_[index(x, y)] : Unreachable;
+        }
+
+        // Next cell toward the target; nullopt at the target or when cut off.
+        [[nodiscard]] std::optional<GridPoint> next_step(int x, int y) const noexcept
+        {
+            if (!contains(x, y))
+                return std::nullopt;
+            const std::uint8_t k = dir_[index(x, y)];
+            if (k == NoDirection)
+                return std::nullopt;
+            return GridPoint{ x + neighbor_offsets[k].first, y + neighbor_offsets[k].second };
+        }
+
+    private:
+        [[nodiscard]] bool contains(int x, int y) const noexcept
+        {
+            return unsigned(x) < unsigned(width_) && unsigned(y) < unsigned(height_);
+        }
+        [[nodiscard]] std::uint32_t index(int x, int y) const noexcept { return std::uint32_t(y * width_ + x); }
+
+        void raise(std::uint32_t cell)
+        {
+            if (dist_[cell] == Unreachable)
+                return;
+            dist_[cell] = Unreachable;
+            dir_[cell] = NoDirection;
+            raised_.push_back(cell);
+        }
+
+        void reseed(const WalkGrid& grid, std::uint32_t cell)
+        {
+            const int x = int(cell % std::uint32_t(width_)), y = int(cell / std::uint32_t(width_));
+            if (!grid.walkable(x, y))
+                return;
+            for (std::size_t k = 0; k < static_cast<std::size_t>(connectivity_); ++k)
+            {
+                if (!pathdetail::can_step(grid, x, y, k))
+                    continue;
+                const std::uint32_t n = index(x + neighbor_offsets[k].first, y + neighbor_offsets[k].second);
+                if (dist_[n] == Unreachable)
+                    continue;
+                const std::uint32_t d = dist_[n] + pathdetail::step_cost(k);
+                if (d < dist_[cell])
+                {
+                    dist_[cell] = d;
+                    dir_[cell] = static_cast<std::uint8_t>(k);
+                }
+            }
+            if (dist_[cell] != Unreachable)
+                pathdetail::heap_push(heap_, dist_[cell], cell);
+        }
+
+        // Dijkstra outward from whatever is queued; only ever lowers distances.
+        void relax(const WalkGrid& grid)
+        {
+            const std::size_t directions = static_cast<std::size_t>(connectivity_);
+            while (!heap_.empty())
+            {
+                const auto [d, cell] = pathdetail::heap_pop(heap_);
+                if (d != dist_[cell])
+                    continue;
+                const int x = int(cell % std::uint32_t(width_)), y = int(cell / std::uint32_t(width_));
+                for (std::size_t k = 0; k < directions; ++k)
+                {
+                    if (!pathdetail::can_step(grid, x, y, k))
+                        continue;
+                    const std::uint32_t n = index(x + neighbor_offsets[k].first, y + neighbor_offsets[k].second);
+                    const std::uint32_t nd = d + pathdetail::step_cost(k);
+                    if (nd >= dist_[n])
+                        continue;
+                    dist_[n] = nd;
+                    dir_[n] = static_cast<std::uint8_t>(pathdetail::opposite(k));
+                    pathdetail::heap_push(heap_, nd, n);
+                }
+            }
+        }
+
+        GridPoint target_{};
+        Connectivity connectivity_ = Connectivity::Four;
+        int width_ = 0;
+        int height_ = 0;
+        std::uint64_t version_ = 0;
+        std::vector<std::uint32_t> dist_;
+        std::vector<std::uint8_t> dir_;
+        std::vector<pathdetail::HeapEntry> heap_;
+        std::vector<std::uint32_t> raised_;
+    };
+
+    // A handful of flow fields keyed by target, least recently used evicted.
+    // Chasers after the same target (or the same few) share one field.
+    class FlowFieldCache
+    {
+    public:
+        explicit FlowFieldCache(std::size_t capacity = 8, Connectivity connectivity = Connectivity::Four)
+            : capacity_((std::max)(std::size_t{ 1 }, capacity)), connectivity_(connectivity)
+        {
+        }
+
+        const FlowField& toward(const WalkGrid& grid, GridPoint target)
+        {
+            ++tick_;
+            for (auto& entry : entries_)
+            {
+                if (entry.field.target() == target)
+                {
+                    entry.lastUse = tick_;
+                    entry.field.sync(grid);
+                    return entry.field;
+                }
+            }
+
+            Entry* slot = nullptr;
+            if (entries_.size() < capacity_)
+                slot = &entries_.emplace_back();
+            else
+                slot = &*std::min_element(entries_.begin(), entries_.end(),
+                    [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+            slot->lastUse = tick_;
+            slot->field.build(grid, target, connectivity_);
+            return slot->field;
+        }
+
+        void clear() noexcept { entries_.clear(); }
+
+    private:
+        struct Entry
+        {
+            FlowField field;
+            std::uint64_t lastUse = 0;
+        };
+
+        std::vector<Entry> entries_;
+        std::size_t capacity_;
+        Connectivity connectivity_;
+        std::uint64_t tick_ = 0;
+    };
+
+} // namespace almondnamespace::gamecore
@@ -0,0 +1,64 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // agridscratch.hpp
+#pragma once
+
+#include "aplatform.hpp"   // almondnamespace
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Kept free of the render stack so headless tools (solvers, validators)
+// can share it without pulling in a context.
+namespace almondnamespace::gamecore
+{
+    // Scratch reused across searches. Visited marks are epoch stamps, so
+    // starting a search costs nothing beyond the first sizing.
+    struct grid_scratch
+    {
+        std::vector<std::uint32_t> stamps;
+        std::vector<std::uint32_t> queue;
+        std::uint32_t epoch = 0;
+
+        void begin(std::size_t cellCount)
+        {
+            if (stamps.size() != cellCount)
+            {
+                stamps.assign(cellCount, 0);
+                epoch = 0;
+            }
+            if (++epoch == 0)
+            {
+                std::fill(stamps.begin(), stamps.end(), 0);
+                epoch = 1;
+            }
+            queue.clear();
+        }
+
+        [[nodiscard]] bool visited(std::size_t i) const noexcept { return stamps[i] == epoch; }
+        void mark(std::size_t i) noexcept { stamps[i] = epoch; }
+    };
+} // namespace almondnamespace::gamecore
@@ -0,0 +1,233 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // agridtexture.hpp
+#pragma once
+
+#include "aatlasmanager.hpp"
+#include "acontext.hpp"
+#include "aspritehandle.hpp"
+#include "aspritepool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace almondnamespace::gamecore
+{
+    // Packs a colour in the byte order the atlases store (R, G, B, A).
+    [[nodiscard]] constexpr std::uint32_t rgba(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255) noexcept
+    {
+        if constexpr (std::endian::native == std::endian::little)
+            return std::uint32_t(r) | (std::uint32_t(g) << 8) | (std::uint32_t(b) << 16) | (std::uint32_t(a) << 24);
+        else
+            return (std::uint32_t(r) << 24) | (std::uint32_t(g) << 16) | (std::uint32_t(b) << 8) | std::uint32_t(a);
+    }
+
+    // ─── GridTexture ──────────────────────────────────────────────
+    // A board rendered as one texel per cell: the scene rewrites texel
+    // rows, only the band of rows that actually changed is uploaded, and
+    // the whole board is drawn as a single stretched quad. Every backend
+    // samples atlases that are not distance fields with nearest filtering
+    // (SDL sets it explicitly, its default is linear), so cells stay crisp
+    // at any scale.
+    //
+    // Each GridTexture owns a private atlas (atlases are never destroyed,
+    // so it is created once and grown if the board gets bigger).
+    class GridTexture
+    {
+    public:
+        static constexpr std::uint32_t MaxDimension = 4096;
+
+        // Returns false when the texture cannot be created at this size;
+        // callers then fall back to drawing one sprite per cell.
+        bool resize(std::uint32_t width, std::uint32_t height)
+        {
+            if (width == 0 || height == 0 || width > MaxDimension || height > MaxDimension)
+                return false;
+            if (ready() && width == width_ && height == height_)
+                return true;
+
+            if (!atlas_)
+            {
+                static std::atomic<std::uint32_t> serial{ 0 };
+                name_ = "grid_texture_" + std::to_string(serial.fetch_add(1, std::memory_order_relaxed));
+                if (!atlasmanager::create_atlas({ .name = name_, .width = width, .height = height,
+                        .generate_mipmaps = false }))
+                    return false;
+                auto* registrar = atlasmanager::get_registrar(name_);
+                if (!registrar)
+                    return false;
+                atlas_ = &registrar->atlas;
+            }
+            else if (width > atlas_->width || height > atlas_->height)
+            {
+                if (!atlas_->grow((std::max)(width, atlas_->width), (std::max)(height, atlas_->height)))
+                    return false;
+            }
+
+            width_ = width;
+            height_ = height;
+            texels_.assign(std::size_t(width) * height, 0u);
+            const AtlasRect rect{ 0, 0, width, height };
+            const std::span<const u8> bytes(reinterpret_cast<const u8*>(texels_.data()), texels_.size() * 4);
+            if (entryIndex_ < 0)
+            {
+                const auto entry = atlas_->place_entry(name_, rect, bytes);
+                if (!entry)
+                    return false;
+                entryIndex_ = *entry;
+            }
+            else if (!atlas_->replace_entry(entryIndex_, name_, rect, bytes))
+            {
+                return false;
+            }
+
+            handle_ = SpriteHandle{
+                static_cast<uint32_t>(entryIndex_),
+                0u,
+                static_cast<uint32_t>(atlas_->get_index()),
+                static_cast<uint32_t>(entryIndex_)
+            };
+            atlasmanager::ensure_uploaded(*atlas_);
+            return true;
+        }
+
+        [[nodiscard]] bool ready() const noexcept { return atlas_ && entryIndex_ >= 0; }
+        [[nodiscard]] std::uint32_t width() const noexcept { return width_; }
+        [[nodiscard]] std::uint32_t height() const noexcept { return height_; }
+        [[nodiscard]] const SpriteHandle& handle() const noexcept { return handle_; }
+
+        // `fill(y, row)` writes the `width()` texels of row y into `row`.
+        // Rows that come out identical to last frame cost a compare and
+        // nothing else; the changed ones go up as one contiguous band.
+        template<typename Fill>
+        bool update_rows(Fill&& fill)
+        {
+            if (!ready())
+                return false;
+            scratch_.resize(width_);
+            std::uint32_t first = height_, last = 0;
+            for (std::uint32_t y = 0; y < height_; ++y)
+            {
+                fill(y, std::span<std::uint32_t>(scratch_));
+                std::uint32_t* row = texels_.data() + std::size_t(y) * width_;
+                if (std::memcmp(row, scratch_.data(), std::size_t(width_) * 4) == 0)
+                    continue;
+                std::copy(scratch_.begin(), scratch_.end(), row);
+                first = (std::min)(first, y);
+                last = y;
+            }
+            return upload_band(first, last);
+        }
+
+        // Whole-board variant: `texels` holds width()*height() colours.
+        bool update(std::span<const std::uint32_t> texels)
+        {
+            if (!ready() || texels.size() < texels_.size())
+                return false;
+            return update_rows([&](std::uint32_t y, std::span<std::uint32_t> row) {
+                std::copy_n(texels.data() + std::size_t(y) * width_, width_, row.data());
+            });
+        }
+
+        // Palette lookup for boards of small enum/integer cells.
+        template<typename Cell>
+        bool update_indexed(std::span<const Cell> cells, std::span<const std::uint32_t> palette)
+        {
+            if (!ready() || cells.size() < texels_.size())
+                return false;
+            return update_rows([&](std::uint32_t y, std::span<std::uint32_t> row) {
+                const Cell* src = cells.data() + std::size_t(y) * width_;
+                for (std::uint32_t x = 0; x < width_; ++x)
+                {
+                    const auto index = static_cast<std::size_t>(src[x]);
+                    row[x] = index < palette.size() ? palette[index] : 0u;
+                }
+            });
+        }
+
+        void draw(core::Context& ctx, std::span<const TextureAtlas* const> atlases,
+            float x, float y, float w, float h) const
+        {
+            if (ready())
+                ctx.draw_sprite_safe(handle_, atlases, x, y, w, h);
+        }
+
+    private:
+        bool upload_band(std::uint32_t first, std::uint32_t last)
+        {
+            if (first > last)
+                return true;
+            const std::uint32_t rows = last - first + 1;
+            const std::span<const u8> band(
+                reinterpret_cast<const u8*>(texels_.data() + std::size_t(first) * width_),
+                std::size_t(rows) * width_ * 4);
+            if (!atlas_->update_entry_rows(entryIndex_, first, rows, band))
+                return false;
+            atlasmanager::ensure_uploaded(*atlas_);
+            return true;
+        }
+
+        std::string name_;
+        TextureAtlas* atlas_ = nullptr;
+        int entryIndex_ = -1;
+        SpriteHandle handle_{};
+        std::uint32_t width_ = 0;
+        std::uint32_t height_ = 0;
+        std::vector<std::uint32_t> texels_;
+        std::vector<std::uint32_t> scratch_;
+    };
+
+    // ─── Tile-map fallback ────────────────────────────────────────
+    // One sprite per non-empty cell, for boards too large for a texture
+    // or backends where the atlas could not be created. `tiles[v]` is the
+    // sprite for cell value v; value 0 (and dead handles) draw nothing.
+    template<typename Cell>
+    void draw_tiles(core::Context& ctx, std::span<const TextureAtlas* const> atlases,
+        std::span<const Cell> cells, int width, int height, std::span<const SpriteHandle> tiles,
+        float x, float y, float w, float h)
+    {
+        if (width <= 0 || height <= 0 || cells.size() < std::size_t(width) * height)
+            return;
+        const float cw = w / float(width);
+        const float ch = h / float(height);
+        for (int cy = 0; cy < height; ++cy)
+        {
+            const Cell* row = cells.data() + std::size_t(cy) * width;
+            for (int cx = 0; cx < width; ++cx)
+            {
+                const auto index = static_cast<std::size_t>(row[cx]);
+                if (index == 0 || index >= tiles.size() || !spritepool::is_alive(tiles[index]))
+                    continue;
+                ctx.draw_sprite_safe(tiles[index], atlases, x + cx * cw, y + cy * ch, cw, ch);
+            }
+        }
+    }
+
+} // namespace almondnamespace::gamecore
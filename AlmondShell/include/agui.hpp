@@ -27,6 +27,7 @@
 #include "aplatform.hpp"
 #include "aengineconfig.hpp"
 #include "aspritehandle.hpp"
+#include "aconsolelog.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -133,6 +134,8 @@ namespace almondnamespace::gui
         Vec2 size{};
         std::span<const std::string> lines{};
         std::size_t max_visible_lines = 128;
+        ConsoleLog* log = nullptr;          // when set, replaces `lines`; drawn one visual row at a time
+        std::size_t scroll_rows = 0;        // rows scrolled back from the newest (log only)
         std::string* input = nullptr;
         std::size_t max_input_chars = 256;
         bool multiline_input = false;
@@ -140,6 +143,7 @@ namespace almondnamespace::gui
 
     struct ConsoleWindowResult {
         EditBoxResult input;
+        std::size_t max_scroll_rows = 0;    // clamp for ConsoleWindowOptions::scroll_rows
     };
 
     [[nodiscard]] ConsoleWindowResult console_window(const ConsoleWindowOptions& options) noexcept;
@@ -170,6 +174,7 @@ namespace almondnamespace::ui
     using gui::advance_cursor;
     using gui::ConsoleWindowOptions;
     using gui::ConsoleWindowResult;
+    using gui::ConsoleLog;
     using gui::console_window;
     using gui::push_input;
     using gui::line_height;
@@ -41,6 +41,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <memory>
@@ -67,6 +68,8 @@ namespace almondnamespace::menu
         bool initialized = false;
 
         std::vector<std::pair<int, int>> cachedPositions; // x,y per item
+        std::vector<std::pair<int, int>> flippedPositions; // rows mirrored for the OpenGL input flip
+        std::vector<std::string> selectedLabels;           // "> label <" per item
         std::vector<float> colWidths, rowHeights;
         int cachedWidth = -1;
         int cachedHeight = -1;
@@ -74,6 +77,18 @@ namespace almondnamespace::menu
         int rows = 0;
         int maxColumns = ExpectedColumns;
 
+        // Layout only depends on these; update_and_draw recomputes when the
+        // key changes instead of every frame.
+        struct LayoutKey {
+            int width = -1;
+            int height = -1;
+            int maxColumns = 0;
+            std::uint64_t descriptorVersion = 0;
+            bool operator==(const LayoutKey&) const = default;
+        };
+        std::uint64_t descriptorVersion = 0;  // bump when descriptors change
+        std::optional<LayoutKey> layoutKey;
+
         float layoutOriginX = 0.0f;
         float layoutOriginY = 0.0f;
         float layoutWidth = 0.0f;
@@ -84,12 +99,20 @@ namespace almondnamespace::menu
         static constexpr float LayoutSpacing = 32.f;
 
         void set_max_columns(int desiredMax) {
-            const int clamped = std::clamp(desiredMax, 1, ExpectedColumns);
-            if (maxColumns != clamped) {
-                maxColumns = clamped;
-                cachedWidth = -1;
-                cachedHeight = -1;
-            }
+            maxColumns = std::clamp(desiredMax, 1, ExpectedColumns);
+        }
+
+        void set_descriptors(std::vector<ChoiceDescriptor> entries) {
+            descriptors = std::move(entries);
+            ++descriptorVersion;
+        }
+
+        void ensure_layout(std::shared_ptr<core::Context> ctx, int widthPixels, int heightPixels) {
+            const LayoutKey key{ widthPixels, heightPixels, maxColumns, descriptorVersion };
+            if (layoutKey == key)
+                return;
+            recompute_layout(std::move(ctx), widthPixels, heightPixels);
+            layoutKey = key;
         }
 
         void recompute_layout(std::shared_ptr<core::Context> ctx,
@@ -98,6 +121,8 @@ namespace almondnamespace::menu
             const int totalItems = static_cast<int>(descriptors.size());
             if (totalItems == 0) {
                 cachedPositions.clear();
+                flippedPositions.clear();
+                selectedLabels.clear();
                 colWidths.clear();
                 rowHeights.clear();
                 columns = 1;
@@ -177,6 +202,24 @@ namespace almondnamespace::menu
                 }
                 yPos += rowHeights[r] + spacing;
             }
+
+            // Same grid with rows mirrored: the OpenGL path reports mouse Y
+            // bottom-up, so items are placed where the flipped cursor lands.
+            flippedPositions.resize(totalItems);
+            for (int idx = 0; idx < totalItems; ++idx) {
+                const int row = idx / columns;
+                const int col = idx % columns;
+                const int flippedRow = std::clamp(rows - 1 - row, 0, rows - 1);
+                const int rowIdx = flippedRow * columns;
+                const int rowY = rowIdx < totalItems ? cachedPositions[rowIdx].second
+                    : cachedPositions[(std::max)(0, rowIdx - columns)].second;
+                const int colX = col < totalItems ? cachedPositions[col].first : cachedPositions.back().first;
+                flippedPositions[idx] = { colX, rowY };
+            }
+
+            selectedLabels.resize(totalItems);
+            for (int idx = 0; idx < totalItems; ++idx)
+                selectedLabels[idx] = "> " + descriptors[idx].label + " <";
         }
 
         void initialize(std::shared_ptr<core::Context> ctx) {
@@ -189,7 +232,7 @@ namespace almondnamespace::menu
 
             constexpr gui::Vec2 DefaultButtonSize{ 256.0f, 96.0f };
 
-            descriptors = {
+            set_descriptors({
                 { Choice::Snake, "Snake", DefaultButtonSize },
                 { Choice::Tetris, "Tetris", DefaultButtonSize },
                 { Choice::Pacman, "Pacman", DefaultButtonSize },
@@ -202,11 +245,11 @@ namespace almondnamespace::menu
                 { Choice::Cellular, "Cellular", DefaultButtonSize },
                 { Choice::Settings, "Settings", DefaultButtonSize },
                 { Choice::Exit, "Quit", DefaultButtonSize }
-            };
+            });
 
             const int currentWidth = ctx ? ctx->get_width_safe() : cachedWidth;
             const int currentHeight = ctx ? ctx->get_height_safe() : cachedHeight;
-            recompute_layout(ctx, currentWidth, currentHeight);
+            ensure_layout(ctx, currentWidth, currentHeight);
 
             initialized = true;
             std::cout << "[Menu] Initialized " << descriptors.size() << " entries\n";
@@ -233,8 +276,7 @@ namespace almondnamespace::menu
             if (currentWidth <= 0) currentWidth = 1;
             if (currentHeight <= 0) currentHeight = 1;
 
-            if (currentWidth != cachedWidth || currentHeight != cachedHeight)
-                recompute_layout(ctx, currentWidth, currentHeight);
+            ensure_layout(ctx, currentWidth, currentHeight);
 
             //input::poll_input();
 
@@ -242,57 +284,20 @@ namespace almondnamespace::menu
             ctx->get_mouse_position_safe(mx, my);
 
             const int totalItems = int(descriptors.size());
-            if (totalItems == 0 || cachedPositions.size() != static_cast<size_t>(totalItems))
+            if (totalItems == 0 || cachedPositions.size() != static_cast<size_t>(totalItems)
+                || flippedPositions.size() != cachedPositions.size())
                 return std::nullopt;
 
             if (selection >= static_cast<size_t>(totalItems))
                 selection = static_cast<size_t>(totalItems - 1);
 
             const bool flipVertical = ctx && ctx->type == core::ContextType::OpenGL;
-            std::vector<int> rowBaseY;
-            std::vector<int> colBaseX;
-
-            if (flipVertical) {
-                rowBaseY.resize((std::max)(1, rows));
-                for (int r = 0; r < rows; ++r) {
-                    const int idx = r * columns;
-                    if (idx < totalItems) {
-                        rowBaseY[r] = cachedPositions[idx].second;
-                    }
-                    else if (r > 0) {
-                        rowBaseY[r] = rowBaseY[r - 1];
-                    }
-                    else {
-                        rowBaseY[r] = 0;
-                    }
-                }
-
-                colBaseX.resize((std::max)(1, columns));
-                for (int c = 0; c < columns; ++c) {
-                    if (c < totalItems) {
-                        colBaseX[c] = cachedPositions[c].first;
-                    }
-                    else if (!cachedPositions.empty()) {
-                        colBaseX[c] = cachedPositions.back().first;
-                    }
-                    else {
-                        colBaseX[c] = 0;
-                    }
-                }
-            }
-
+            const auto& positions = flipVertical ? flippedPositions : cachedPositions;
             auto position_for_index = [&](int idx) -> std::pair<int, int> {
                 if (idx < 0 || idx >= totalItems) {
                     return { 0, 0 };
                 }
-                if (!flipVertical || rowBaseY.empty() || colBaseX.empty()) {
-                    return cachedPositions[idx];
-                }
-                const int row = idx / columns;
-                const int col = idx % columns;
-                const int flippedRow = std::clamp(rows - 1 - row, 0, rows - 1);
-                const int clampedCol = std::clamp(col, 0, columns - 1);
-                return { colBaseX[clampedCol], rowBaseY[flippedRow] };
+                return positions[idx];
             };
 
             int hover = -1;
@@ -338,10 +343,9 @@ namespace almondnamespace::menu
                 const auto pos = position_for_index(i);
                 gui::set_cursor({ static_cast<float>(pos.first), static_cast<float>(pos.second) });
 
-                std::string label = descriptors[i].label;
-                if (static_cast<size_t>(i) == selection) {
-                    label = "> " + label + " <";
-                }
+                const std::string& label = (static_cast<size_t>(i) == selection)
+                    ? selectedLabels[i]
+                    : descriptors[i].label;
 
                 const bool activated = gui::button(label, descriptors[i].size);
                 if (core::cli::trace_menu_button0_rect && i == 0) {
@@ -413,8 +417,11 @@ namespace almondnamespace::menu
             cachedPositions.clear();
             colWidths.clear();
             rowHeights.clear();
+            flippedPositions.clear();
+            selectedLabels.clear();
             cachedWidth = -1;
             cachedHeight = -1;
+            layoutKey.reset();
             columns = 1;
             rows = 0;
             layoutOriginX = 0.0f;
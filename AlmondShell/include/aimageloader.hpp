@@ -24,19 +24,47 @@
 #pragma once
 
 #include "aplatform.hpp"
+#include "aenginesystems.hpp"   // scheduler_parallel_for
 
 #undef max
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
+#include <charconv>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <stdexcept>
 #include <cstring>
+#include <exception>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <algorithm>
 #include <iostream>
 #include <limits>
+#include <thread>
+
+#if defined(_WIN32)
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#    include <tmmintrin.h>
+#    define ALMOND_IMAGE_SSSE3 1
+#endif
+
+// Declarations only; the implementation is compiled once in aimagecodecs.cpp.
+#include "../src/stb/stb_image.h"
 
 namespace almondnamespace
 {
@@ -52,210 +80,718 @@ namespace almondnamespace
         }
     };
 
+    // RGBA8 decode destination. Rows are `strideBytes` apart, so a view can
+    // address a sub-rectangle of a larger buffer such as an atlas page.
+    struct RgbaView
+    {
+        uint8_t* pixels = nullptr;
+        int width = 0;
+        int height = 0;
+        size_t strideBytes = 0;
+    };
+
+    struct ImageSize
+    {
+        int width = 0;
+        int height = 0;
+    };
+
     inline void a_listSupportedImageTypes()
     {
-        std::cout << "Supported image types: BMP, TGA, PPM\n";
+        std::cout << "Supported image types: BMP, TGA, PPM, PNG, JPEG, GIF\n";
     }
 
-    inline ImageData a_loadBMP(const std::filesystem::path& path, bool flipVertically);
-    inline ImageData a_loadTGA(const std::filesystem::path& path, bool flipVertically);
-    inline ImageData a_loadPPM(const std::filesystem::path& path, bool flipVertically);
-
-    inline ImageData a_loadImage(const std::filesystem::path& filepath, bool flipVertically = false)
+    namespace imagedetail
     {
-        auto ext = filepath.extension().string();
-        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        // ─── File access ──────────────────────────────────────────────
+        // Memory-maps the file when the OS allows it; otherwise falls back to
+        // a single buffered read. Decoders only ever see one contiguous span.
+        class MappedFile
+        {
+        public:
+            explicit MappedFile(const std::filesystem::path& path)
+            {
+#if defined(_WIN32)
+                file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (file != INVALID_HANDLE_VALUE) {
+                    LARGE_INTEGER size{};
+                    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+                        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                        if (mapping) {
+                            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                            if (view) {
+                                data = static_cast<const uint8_t*>(view);
+                                length = static_cast<size_t>(size.QuadPart);
+                                return;
+                            }
+                        }
+                    }
+                    release();
+                }
+#else
+                const int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd >= 0) {
+                    struct stat st{};
+                    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                        void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                        if (p != MAP_FAILED) {
+                            ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+                            view = p;
+                            data = static_cast<const uint8_t*>(p);
+                            length = static_cast<size_t>(st.st_size);
+                        }
+                    }
+                    ::close(fd);
+                    if (view)
+                        return;
+                }
+#endif
+                std::ifstream f(path, std::ios::binary | std::ios::ate);
+                if (!f)
+                    return;
+                const auto size = f.tellg();
+                if (size <= 0)
+                    return;
+                buffer.resize(static_cast<size_t>(size));
+                f.seekg(0);
+                if (!f.read(reinterpret_cast<char*>(buffer.data()), size))
+                    return;
+                data = buffer.data();
+                length = buffer.size();
+            }
 
-        if (ext == ".bmp") return a_loadBMP(filepath, flipVertically);
-        if (ext == ".tga") return a_loadTGA(filepath, flipVertically);
-        if (ext == ".ppm") return a_loadPPM(filepath, flipVertically);
+            ~MappedFile() { release(); }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            [[nodiscard]] bool is_open() const noexcept { return data != nullptr; }
+            [[nodiscard]] std::span<const uint8_t> bytes() const noexcept { return { data, length }; }
+
+        private:
+            void release() noexcept
+            {
+#if defined(_WIN32)
+                if (view) UnmapViewOfFile(view);
+                if (mapping) CloseHandle(mapping);
+                if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+                mapping = nullptr;
+                file = INVALID_HANDLE_VALUE;
+#else
+                if (view) ::munmap(view, length);
+#endif
+                view = nullptr;
+            }
 
-        throw std::runtime_error("Unsupported image format: " + filepath.string());
-    }
+#if defined(_WIN32)
+            HANDLE file = INVALID_HANDLE_VALUE;
+            HANDLE mapping = nullptr;
+            LPVOID view = nullptr;
+#else
+            void* view = nullptr;
+#endif
+            std::vector<uint8_t> buffer;
+            const uint8_t* data = nullptr;
+            size_t length = 0;
+        };
+
+        // ─── Pixel conversion ─────────────────────────────────────────
+        enum class SourceLayout { RGB, BGR, RGBA, BGRA };
+
+        // Converts one row to RGBA8. The SSSE3 path shuffles four pixels per
+        // instruction; the scalar loop handles the tail and other targets.
+        inline void swizzle_row(const uint8_t* src, uint8_t* dst, size_t width, SourceLayout layout) noexcept
+        {
+            size_t x = 0;
+            if (layout == SourceLayout::RGBA) {
+                std::memcpy(dst, src, width * 4);
+                return;
+            }
+#if defined(ALMOND_IMAGE_SSSE3)
+            if (layout == SourceLayout::BGRA) {
+                const __m128i mask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+                for (; x + 4 <= width; x += 4) {
+                    const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_shuffle_epi8(px, mask));
+                }
+            }
+            else {
+                const __m128i mask = layout == SourceLayout::RGB
+                    ? _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1)
+                    : _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+                const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+                // Each load reads 16 bytes but consumes 12; stop while a full
+                // load still stays inside the row.
+                for (; x + 6 <= width; x += 4) {
+                    const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 3));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4),
+                        _mm_or_si128(_mm_shuffle_epi8(px, mask), alpha));
+                }
+            }
+#endif
+            switch (layout) {
+            case SourceLayout::RGB:
+                for (; x < width; ++x) {
+                    dst[x * 4 + 0] = src[x * 3 + 0];
+                    dst[x * 4 + 1] = src[x * 3 + 1];
+                    dst[x * 4 + 2] = src[x * 3 + 2];
+                    dst[x * 4 + 3] = 255;
+                }
+                break;
+            case SourceLayout::BGR:
+                for (; x < width; ++x) {
+                    dst[x * 4 + 0] = src[x * 3 + 2];
+                    dst[x * 4 + 1] = src[x * 3 + 1];
+                    dst[x * 4 + 2] = src[x * 3 + 0];
+                    dst[x * 4 + 3] = 255;
+                }
+                break;
+            case SourceLayout::BGRA:
+                for (; x < width; ++x) {
+                    dst[x * 4 + 0] = src[x * 4 + 2];
+                    dst[x * 4 + 1] = src[x * 4 + 1];
+                    dst[x * 4 + 2] = src[x * 4 + 0];
+                    dst[x * 4 + 3] = src[x * 4 + 3];
+                }
+                break;
+            case SourceLayout::RGBA:
+                break;
+            }
+        }
 
-    inline ImageData a_loadBMP(const std::filesystem::path& filepath, bool flipVertically)
-    {
-        std::ifstream f(filepath, std::ios::binary);
-        if (!f) throw std::runtime_error("Cannot open BMP: " + filepath.string());
-
-        char hdr[54];
-        f.read(hdr, 54);
-        if (std::memcmp(hdr, "BM", 2) != 0)
-            throw std::runtime_error("Invalid BMP header: " + filepath.string());
-
-        int w = *reinterpret_cast<int*>(&hdr[18]);
-        int h = *reinterpret_cast<int*>(&hdr[22]);
-        int bpp = *reinterpret_cast<short*>(&hdr[28]);
-        int ch = bpp / 8;
-        int pad = (4 - (w * ch) % 4) % 4;
-
-        std::vector<uint8_t> raw(size_t(w) * size_t(h) * ch);
-
-        f.seekg(*reinterpret_cast<int*>(&hdr[10]));
-        for (int y = 0; y < h; ++y) {
-            f.read(reinterpret_cast<char*>(raw.data() + y * w * ch), w * ch);
-            f.ignore(pad);
+        // Swizzle and vertical flip in one pass: row y of the source lands in
+        // row y (or h-1-y) of the destination.
+        inline void convert_rows(const uint8_t* src, size_t srcStride, SourceLayout layout,
+            const RgbaView& dst, int w, int h, bool flip) noexcept
+        {
+            for (int y = 0; y < h; ++y) {
+                const int dstY = flip ? (h - 1 - y) : y;
+                swizzle_row(src + size_t(y) * srcStride, dst.pixels + size_t(dstY) * dst.strideBytes, size_t(w), layout);
+            }
+        }
+
+        template <typename T>
+        inline T read_le(std::span<const uint8_t> bytes, size_t offset)
+        {
+            T value{};
+            std::memcpy(&value, bytes.data() + offset, sizeof(T));
+            return value;
+        }
+
+        inline void require(bool condition, const char* what, const std::filesystem::path& path)
+        {
+            if (!condition)
+                throw std::runtime_error(std::string(what) + ": " + path.string());
+        }
+
+        // Validates that a caller view can hold a w×h image.
+        inline RgbaView check_view(const RgbaView& view, int w, int h, const std::filesystem::path& path)
+        {
+            require(view.pixels && w <= view.width && h <= view.height
+                && view.strideBytes >= size_t(w) * 4, "Decode target too small", path);
+            return view;
         }
 
-        std::vector<uint8_t> out(size_t(w) * size_t(h) * 4);
-        for (int y = 0; y < h; ++y) {
-            int srcY = flipVertically ? (h - 1 - y) : y;
-            for (int x = 0; x < w; ++x) {
-                int srcIdx = (srcY * w + x) * ch;
-                int dstIdx = (y * w + x) * 4;
-                out[dstIdx + 0] = raw[srcIdx + 2];
-                out[dstIdx + 1] = raw[srcIdx + 1];
-                out[dstIdx + 2] = raw[srcIdx + 0];
-                out[dstIdx + 3] = (ch == 4) ? raw[srcIdx + 3] : 255;
+        // ─── Decoders ─────────────────────────────────────────────────
+        // Each decoder parses the header, asks `acquire(w, h)` for an RGBA
+        // destination, then converts straight from the file bytes into it.
+        using AcquireFn = std::function<RgbaView(int, int)>;
+        using DecodeFn = ImageSize(*)(std::span<const uint8_t>, const std::filesystem::path&, bool, const AcquireFn&);
+
+        inline ImageSize decode_bmp(std::span<const uint8_t> file, const std::filesystem::path& path, bool flip, const AcquireFn& acquire)
+        {
+            require(file.size() >= 54 && std::memcmp(file.data(), "BM", 2) == 0, "Invalid BMP header", path);
+
+            const int w = read_le<int32_t>(file, 18);
+            const int h = read_le<int32_t>(file, 22);
+            const int bpp = read_le<int16_t>(file, 28);
+            const uint32_t dataOffset = read_le<uint32_t>(file, 10);
+            require(w > 0 && h > 0 && (bpp == 24 || bpp == 32), "Unsupported BMP format", path);
+
+            const int ch = bpp / 8;
+            const size_t stride = (size_t(w) * ch + 3) & ~size_t(3);
+            require(dataOffset + stride * size_t(h) <= file.size(), "Truncated BMP", path);
+
+            const RgbaView dst = acquire(w, h);
+            convert_rows(file.data() + dataOffset, stride,
+                ch == 4 ? SourceLayout::BGRA : SourceLayout::BGR, dst, w, h, flip);
+            return { w, h };
+        }
+
+        inline ImageSize decode_tga(std::span<const uint8_t> file, const std::filesystem::path& path, bool flip, const AcquireFn& acquire)
+        {
+            require(file.size() >= 18, "Invalid TGA header", path);
+
+            const uint8_t idLen = file[0];
+            const uint8_t imgType = file[2];
+            const int w = read_le<uint16_t>(file, 12);
+            const int h = read_le<uint16_t>(file, 14);
+            const uint8_t bpp = file[16];
+            const uint8_t desc = file[17];
+
+            require((imgType == 2 || imgType == 10) && (bpp == 24 || bpp == 32), "Unsupported TGA format", path);
+
+            const int ch = bpp / 8;
+            const bool originTopLeft = (desc & 0x20) != 0;
+            const size_t pixelCount = size_t(w) * size_t(h);
+            size_t pos = 18 + size_t(idLen);
+
+            // Uncompressed data is converted in place from the mapping; RLE
+            // has to be expanded once into scratch first.
+            std::vector<uint8_t> unpacked;
+            const uint8_t* pixelsIn = nullptr;
+            if (imgType == 2) {
+                require(pos + pixelCount * ch <= file.size(), "Truncated TGA", path);
+                pixelsIn = file.data() + pos;
+            }
+            else {
+                unpacked.resize(pixelCount * ch);
+                size_t written = 0;
+                while (written < pixelCount) {
+                    require(pos < file.size(), "Truncated TGA", path);
+                    const uint8_t header = file[pos++];
+                    const size_t count = (std::min)(size_t(header & 0x7F) + 1, pixelCount - written);
+                    if (header & 0x80) {
+                        require(pos + ch <= file.size(), "Truncated TGA", path);
+                        for (size_t i = 0; i < count; ++i)
+                            std::memcpy(unpacked.data() + (written + i) * ch, file.data() + pos, ch);
+                        pos += ch;
+                    }
+                    else {
+                        require(pos + count * ch <= file.size(), "Truncated TGA", path);
+                        std::memcpy(unpacked.data() + written * ch, file.data() + pos, count * ch);
+                        pos += count * ch;
+                    }
+                    written += count;
+                }
+                pixelsIn = unpacked.data();
             }
+
+            const RgbaView dst = acquire(w, h);
+            // Bottom-left origin images are stored upside down already.
+            convert_rows(pixelsIn, size_t(w) * ch, ch == 4 ? SourceLayout::BGRA : SourceLayout::BGR,
+                dst, w, h, !(originTopLeft ^ flip));
+            return { w, h };
         }
 
-        return ImageData(std::move(out), w, h, 4);
+        struct PnmCursor
+        {
+            std::span<const uint8_t> file;
+            size_t pos = 0;
+
+            void skip_space_and_comments() noexcept
+            {
+                while (pos < file.size()) {
+                    const auto c = file[pos];
+                    if (c == '#') {
+                        while (pos < file.size() && file[pos] != '\n') ++pos;
+                    }
+                    else if (c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f') {
+                        ++pos;
+                    }
+                    else {
+                        break;
+                    }
+                }
+            }
+
+            bool next_int(int& out) noexcept
+            {
+                skip_space_and_comments();
+                const char* begin = reinterpret_cast<const char*>(file.data()) + pos;
+                const char* end = reinterpret_cast<const char*>(file.data()) + file.size();
+                const auto [ptr, ec] = std::from_chars(begin, end, out);
+                if (ec != std::errc{})
+                    return false;
+                pos += size_t(ptr - begin);
+                return true;
+            }
+        };
+
+        inline ImageSize decode_ppm(std::span<const uint8_t> file, const std::filesystem::path& path, bool flip, const AcquireFn& acquire)
+        {
+            require(file.size() >= 2 && file[0] == 'P' && (file[1] == '6' || file[1] == '3'),
+                "Unsupported PPM format", path);
+            const bool binary = file[1] == '6';
+
+            PnmCursor cursor{ file, 2 };
+            int w = 0, h = 0, maxv = 0;
+            require(cursor.next_int(w) && cursor.next_int(h) && cursor.next_int(maxv), "PPM parse error", path);
+            require(w > 0 && h > 0, "PPM parse error", path);
+            require(maxv == 255, "PPM maxval!=255", path);
+
+            const size_t rowBytes = size_t(w) * 3;
+            if (binary) {
+                // Exactly one whitespace byte separates the header from data.
+                const size_t dataStart = cursor.pos + 1;
+                require(dataStart + rowBytes * size_t(h) <= file.size(), "Unexpected EOF", path);
+                const RgbaView dst = acquire(w, h);
+                convert_rows(file.data() + dataStart, rowBytes, SourceLayout::RGB, dst, w, h, flip);
+                return { w, h };
+            }
+
+            const RgbaView dst = acquire(w, h);
+            for (int y = 0; y < h; ++y) {
+                uint8_t* row = dst.pixels + size_t(flip ? (h - 1 - y) : y) * dst.strideBytes;
+                for (int x = 0; x < w; ++x) {
+                    int r = 0, g = 0, b = 0;
+                    require(cursor.next_int(r) && cursor.next_int(g) && cursor.next_int(b), "PPM parse error", path);
+                    row[x * 4 + 0] = static_cast<uint8_t>(r);
+                    row[x * 4 + 1] = static_cast<uint8_t>(g);
+                    row[x * 4 + 2] = static_cast<uint8_t>(b);
+                    row[x * 4 + 3] = 255;
+                }
+            }
+            return { w, h };
+        }
+
+        // PNG, JPEG and GIF (first frame) go through stb_image. It decodes
+        // into its own buffer, so the copy into `acquire` also applies the
+        // flip; stb's global flip flag is left alone because it is not
+        // thread-safe.
+        inline ImageSize decode_stb(std::span<const uint8_t> file, const std::filesystem::path& path, bool flip, const AcquireFn& acquire)
+        {
+            require(file.size() <= size_t((std::numeric_limits<int>::max)()), "Image too large", path);
+
+            int w = 0, h = 0, comp = 0;
+            std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> decoded(
+                stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &w, &h, &comp, 4),
+                &stbi_image_free);
+            if (!decoded)
+                throw std::runtime_error(std::string("Image decode failed (") + stbi_failure_reason() + "): " + path.string());
+
+            const RgbaView dst = acquire(w, h);
+            convert_rows(decoded.get(), size_t(w) * 4, SourceLayout::RGBA, dst, w, h, flip);
+            return { w, h };
+        }
+
+        // FNV-1a over 64-bit words (bytes for the tail). Only used to tell
+        // whether a source file changed, so speed matters more than spread.
+        inline uint64_t hash_bytes(std::span<const uint8_t> bytes, uint64_t seed = 1469598103934665603ull) noexcept
+        {
+            constexpr uint64_t kPrime = 1099511628211ull;
+            uint64_t hash = seed;
+            size_t i = 0;
+            for (; i + 8 <= bytes.size(); i += 8) {
+                hash ^= read_le<uint64_t>(bytes, i);
+                hash *= kPrime;
+                hash ^= hash >> 32;
+            }
+            for (; i < bytes.size(); ++i) {
+                hash ^= bytes[i];
+                hash *= kPrime;
+            }
+            return hash;
+        }
+
+        inline std::string lower_extension(const std::filesystem::path& path)
+        {
+            auto ext = path.extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(),
+                [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return ext;
+        }
+
+        inline DecodeFn decoder_for(const std::filesystem::path& path)
+        {
+            const auto ext = lower_extension(path);
+            if (ext == ".bmp") return decode_bmp;
+            if (ext == ".tga") return decode_tga;
+            if (ext == ".ppm") return decode_ppm;
+            if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".gif") return decode_stb;
+            return nullptr;
+        }
     }
 
-    inline ImageData a_loadTGA(const std::filesystem::path& filepath, bool flipVertically)
+    // ─── Decoded-image cache ──────────────────────────────────────────
+    // Compressed formats are stored once more on disk as raw RGBA so later
+    // runs skip decoding. Entries are named after the source path and carry
+    // the source's mtime, size and content hash: a matching mtime is trusted
+    // without reading the source, and a touched-but-identical file (fresh
+    // checkout) still hits once its hash is checked.
+    namespace imagecache
     {
-        std::ifstream f(filepath, std::ios::binary);
-        if (!f) throw std::runtime_error("Cannot open TGA: " + filepath.string());
+        struct CacheHeader
+        {
+            char magic[8];
+            uint64_t contentHash;
+            int64_t sourceMtime;
+            uint64_t sourceSize;
+            int32_t width;
+            int32_t height;
+        };
+
+        inline constexpr char kMagic[8] = { 'A', 'L', 'I', 'M', 'G', 'C', '0', '1' };
+
+        struct CacheState
+        {
+            std::mutex mutex;
+            std::filesystem::path directory = "cache/images";
+        };
+
+        inline CacheState& state()
+        {
+            static CacheState s;
+            return s;
+        }
 
-        uint8_t hdr[18];
-        f.read(reinterpret_cast<char*>(hdr), 18);
+        // An empty directory disables the cache.
+        inline void set_directory(std::filesystem::path dir)
+        {
+            auto& s = state();
+            std::scoped_lock lock(s.mutex);
+            s.directory = std::move(dir);
+        }
 
-        uint8_t  idLen = hdr[0];
-        uint8_t  imgType = hdr[2];
-        uint16_t w = *reinterpret_cast<uint16_t*>(&hdr[12]);
-        uint16_t h = *reinterpret_cast<uint16_t*>(&hdr[14]);
-        uint8_t  bpp = hdr[16];
-        uint8_t  desc = hdr[17];
+        [[nodiscard]] inline std::filesystem::path directory()
+        {
+            auto& s = state();
+            std::scoped_lock lock(s.mutex);
+            return s.directory;
+        }
 
-        if ((imgType != 2 && imgType != 10) || (bpp != 24 && bpp != 32))
-            throw std::runtime_error("Unsupported TGA format: " + filepath.string());
+        inline void clear()
+        {
+            const auto dir = directory();
+            std::error_code ec;
+            if (!dir.empty())
+                std::filesystem::remove_all(dir, ec);
+        }
 
-        int ch = bpp / 8;
-        bool originTopLeft = (desc & 0x20) != 0;
+        [[nodiscard]] inline std::filesystem::path entry_path(const std::filesystem::path& dir, const std::filesystem::path& source)
+        {
+            std::error_code ec;
+            auto absolute = std::filesystem::absolute(source, ec);
+            const auto key = (ec ? source : absolute).lexically_normal().generic_string();
+            const auto hash = imagedetail::hash_bytes({ reinterpret_cast<const uint8_t*>(key.data()), key.size() });
+            return dir / std::format("{:016x}.rgba", hash);
+        }
 
-        f.seekg(idLen, std::ios::cur);
+        struct SourceStamp
+        {
+            int64_t mtime = 0;
+            uint64_t size = 0;
+        };
+
+        [[nodiscard]] inline std::optional<SourceStamp> stamp(const std::filesystem::path& source)
+        {
+            std::error_code ec;
+            const auto mtime = std::filesystem::last_write_time(source, ec);
+            if (ec) return std::nullopt;
+            const auto size = std::filesystem::file_size(source, ec);
+            if (ec) return std::nullopt;
+            return SourceStamp{ static_cast<int64_t>(mtime.time_since_epoch().count()), static_cast<uint64_t>(size) };
+        }
 
-        const size_t pixelCount = size_t(w) * size_t(h);
-        std::vector<uint8_t> raw(pixelCount * ch);
+        // Validated view of a cache entry's header and pixels.
+        [[nodiscard]] inline std::optional<CacheHeader> read_header(const imagedetail::MappedFile& entry)
+        {
+            if (!entry.is_open() || entry.bytes().size() < sizeof(CacheHeader))
+                return std::nullopt;
+            CacheHeader header{};
+            std::memcpy(&header, entry.bytes().data(), sizeof(header));
+            if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.width <= 0 || header.height <= 0)
+                return std::nullopt;
+            const size_t expected = sizeof(CacheHeader) + size_t(header.width) * size_t(header.height) * 4;
+            if (entry.bytes().size() != expected)
+                return std::nullopt;
+            return header;
+        }
 
-        if (imgType == 2) {
-            f.read(reinterpret_cast<char*>(raw.data()), raw.size());
+        inline ImageSize copy_out(const imagedetail::MappedFile& entry, const CacheHeader& header,
+            bool flip, const imagedetail::AcquireFn& acquire)
+        {
+            const RgbaView dst = acquire(header.width, header.height);
+            imagedetail::convert_rows(entry.bytes().data() + sizeof(CacheHeader), size_t(header.width) * 4,
+                imagedetail::SourceLayout::RGBA, dst, header.width, header.height, flip);
+            return { header.width, header.height };
         }
-        else {
-            size_t totalRead = 0;
-            while (totalRead < pixelCount) {
-                uint8_t header = 0;
-                f.read(reinterpret_cast<char*>(&header), 1);
-
-                int count = (header & 0x7F) + 1;
-                if (header & 0x80) {
-                    std::vector<uint8_t> pixel(ch);
-                    f.read(reinterpret_cast<char*>(pixel.data()), ch);
-                    for (int i = 0; i < count; ++i)
-                        std::copy(pixel.begin(), pixel.end(), raw.begin() + (totalRead + i) * ch);
+
+        // Writes `view` (flipped if it was decoded flipped) as a new entry.
+        // The temp-file + rename keeps concurrent loaders of the same image
+        // from ever observing a half-written entry.
+        inline void store(const std::filesystem::path& entryPath, const CacheHeader& header, const RgbaView& view, bool flipped)
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(entryPath.parent_path(), ec);
+
+            auto tmp = entryPath;
+            tmp += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+            {
+                std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                if (!out)
+                    return;
+                out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                const size_t rowBytes = size_t(header.width) * 4;
+                for (int y = 0; y < header.height; ++y) {
+                    const int srcY = flipped ? (header.height - 1 - y) : y;
+                    out.write(reinterpret_cast<const char*>(view.pixels + size_t(srcY) * view.strideBytes),
+                        static_cast<std::streamsize>(rowBytes));
                 }
-                else {
-                    f.read(reinterpret_cast<char*>(raw.data() + totalRead * ch), count * ch);
+                if (!out) {
+                    out.close();
+                    std::filesystem::remove(tmp, ec);
+                    return;
                 }
-                totalRead += count;
             }
+            std::filesystem::rename(tmp, entryPath, ec);
+            if (ec)
+                std::filesystem::remove(tmp, ec);
         }
 
-        std::vector<uint8_t> out(pixelCount * 4);
-        for (uint16_t y = 0; y < h; ++y) {
-            uint16_t srcY = (originTopLeft ^ flipVertically) ? y : (h - 1 - y);
-            const uint8_t* srcRow = raw.data() + size_t(srcY) * w * ch;
-            uint8_t* dstRow = out.data() + size_t(y) * w * 4;
-
-            for (uint16_t x = 0; x < w; ++x) {
-                dstRow[x * 4 + 0] = srcRow[x * ch + 2];
-                dstRow[x * 4 + 1] = srcRow[x * ch + 1];
-                dstRow[x * 4 + 2] = srcRow[x * ch + 0];
-                dstRow[x * 4 + 3] = (ch == 4) ? srcRow[x * ch + 3] : 255;
-            }
+        // Re-stamps an entry whose content hash matched but whose source
+        // mtime moved, so the next lookup takes the fast path again.
+        inline void restamp(const std::filesystem::path& entryPath, int64_t mtime)
+        {
+            std::fstream f(entryPath, std::ios::binary | std::ios::in | std::ios::out);
+            if (!f)
+                return;
+            f.seekp(offsetof(CacheHeader, sourceMtime));
+            f.write(reinterpret_cast<const char*>(&mtime), sizeof(mtime));
         }
 
-        return ImageData(std::move(out), int(w), int(h), 4);
-    }
+        // Decodes `path` through `decode`, serving and filling the cache.
+        inline ImageSize decode_cached(const std::filesystem::path& path, imagedetail::DecodeFn decode,
+            bool flip, const imagedetail::AcquireFn& acquire, const std::filesystem::path& dir)
+        {
+            const auto sourceStamp = stamp(path);
+            if (!sourceStamp)
+                throw std::runtime_error("Cannot open image: " + path.string());
+
+            const auto entryPath = entry_path(dir, path);
+            std::optional<CacheHeader> cached;
+            {
+                imagedetail::MappedFile entry(entryPath);
+                cached = read_header(entry);
+                if (cached && cached->sourceMtime == sourceStamp->mtime && cached->sourceSize == sourceStamp->size)
+                    return copy_out(entry, *cached, flip, acquire);
+            }
 
-    inline ImageData a_loadPPM(const std::filesystem::path& filepath, bool flipVertically)
-    {
-        std::ifstream f{ filepath, std::ios::binary };
-        if (!f) throw std::runtime_error("Cannot open PPM: " + filepath.string());
-
-        auto nextToken = [&](std::string& out) {
-            out.clear();
-            char c;
-            while (f.get(c)) {
-                if (std::isspace(static_cast<unsigned char>(c))) continue;
-                if (c == '#') {
-                    f.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                    continue;
+            imagedetail::MappedFile file(path);
+            if (!file.is_open())
+                throw std::runtime_error("Cannot open image: " + path.string());
+            const uint64_t contentHash = imagedetail::hash_bytes(file.bytes());
+
+            if (cached && cached->contentHash == contentHash && cached->sourceSize == sourceStamp->size) {
+                ImageSize size{};
+                {
+                    imagedetail::MappedFile entry(entryPath);
+                    if (const auto header = read_header(entry); header && header->contentHash == contentHash)
+                        size = copy_out(entry, *header, flip, acquire);
+                }
+                if (size.width > 0) {
+                    restamp(entryPath, sourceStamp->mtime);
+                    return size;
                 }
-                f.unget();
-                break;
-            }
-            while (f.get(c)) {
-                if (std::isspace(static_cast<unsigned char>(c))) break;
-                out.push_back(c);
             }
-            if (out.empty())
-                throw std::runtime_error("PPM parse error: " + filepath.string());
-            };
-
-        std::string magic, wstr, hstr, maxvstr;
-        nextToken(magic); nextToken(wstr); nextToken(hstr); nextToken(maxvstr);
-        if (magic != "P6" && magic != "P3")
-            throw std::runtime_error("Unsupported PPM format: " + filepath.string());
-
-        const int w = std::stoi(wstr);
-        const int h = std::stoi(hstr);
-        const int maxv = std::stoi(maxvstr);
-        if (maxv != 255)
-            throw std::runtime_error("PPM maxval!=255: " + filepath.string());
-
-        while (true) {
-            int c = f.peek();
-            if (c == EOF) throw std::runtime_error("Unexpected EOF: " + filepath.string());
-            if (!std::isspace(static_cast<unsigned char>(c))) break;
-            f.get();
+
+            RgbaView decodedInto{};
+            const ImageSize size = decode(file.bytes(), path, flip, [&](int w, int h) {
+                decodedInto = acquire(w, h);
+                return decodedInto;
+            });
+
+            CacheHeader header{};
+            std::memcpy(header.magic, kMagic, sizeof(kMagic));
+            header.contentHash = contentHash;
+            header.sourceMtime = sourceStamp->mtime;
+            header.sourceSize = sourceStamp->size;
+            header.width = size.width;
+            header.height = size.height;
+            store(entryPath, header, decodedInto, flip);
+            return size;
         }
+    }
 
-        const size_t pixelCount = size_t(w) * size_t(h);
-        std::vector<uint8_t> rawData(pixelCount * 3);
+    namespace imagedetail
+    {
 
-        if (magic == "P6") {
-            f.read(reinterpret_cast<char*>(rawData.data()), rawData.size());
-        }
-        else {
-            std::string tok;
-            for (size_t i = 0; i < pixelCount * 3; ++i) {
-                nextToken(tok);
-                rawData[i] = static_cast<uint8_t>(std::stoi(tok));
+        inline ImageSize decode_file(const std::filesystem::path& path, DecodeFn decode, bool flip, const AcquireFn& acquire)
+        {
+            // BMP/TGA/PPM convert at memcpy speed; caching them would only
+            // double the I/O.
+            if (decode == decode_stb) {
+                if (const auto dir = imagecache::directory(); !dir.empty())
+                    return imagecache::decode_cached(path, decode, flip, acquire, dir);
             }
+
+            MappedFile file(path);
+            if (!file.is_open())
+                throw std::runtime_error("Cannot open image: " + path.string());
+            return decode(file.bytes(), path, flip, acquire);
         }
 
-        std::vector<uint8_t> pixels(pixelCount * 4);
-        for (size_t i = 0; i < pixelCount; ++i) {
-            pixels[i * 4 + 0] = rawData[i * 3 + 0];
-            pixels[i * 4 + 1] = rawData[i * 3 + 1];
-            pixels[i * 4 + 2] = rawData[i * 3 + 2];
-            pixels[i * 4 + 3] = 255;
+        // Decodes into a freshly sized ImageData.
+        inline ImageData load_with(const std::filesystem::path& path, DecodeFn decode, bool flip)
+        {
+            ImageData out({}, 0, 0, 4);
+            decode_file(path, decode, flip, [&](int w, int h) {
+                out.pixels.resize(size_t(w) * size_t(h) * 4);
+                out.width = w;
+                out.height = h;
+                return RgbaView{ out.pixels.data(), w, h, size_t(w) * 4 };
+            });
+            return out;
         }
+    }
+
+    inline ImageData a_loadBMP(const std::filesystem::path& filepath, bool flipVertically)
+    {
+        return imagedetail::load_with(filepath, imagedetail::decode_bmp, flipVertically);
+    }
+
+    inline ImageData a_loadTGA(const std::filesystem::path& filepath, bool flipVertically)
+    {
+        return imagedetail::load_with(filepath, imagedetail::decode_tga, flipVertically);
+    }
+
+    inline ImageData a_loadPPM(const std::filesystem::path& filepath, bool flipVertically)
+    {
+        return imagedetail::load_with(filepath, imagedetail::decode_ppm, flipVertically);
+    }
+
+    inline ImageData a_loadImage(const std::filesystem::path& filepath, bool flipVertically = false)
+    {
+        const auto decode = imagedetail::decoder_for(filepath);
+        if (!decode)
+            throw std::runtime_error("Unsupported image format: " + filepath.string());
+        return imagedetail::load_with(filepath, decode, flipVertically);
+    }
 
-        if (flipVertically) {
-            const size_t rowBytes = size_t(w) * 4;
-            std::vector<uint8_t> tmp(rowBytes);
-            for (int y = 0; y < h / 2; ++y) {
-                auto top = pixels.data() + y * rowBytes;
-                auto bot = pixels.data() + (h - 1 - y) * rowBytes;
-                std::memcpy(tmp.data(), top, rowBytes);
-                std::memcpy(top, bot, rowBytes);
-                std::memcpy(bot, tmp.data(), rowBytes);
+    // Decodes a batch of images on the engine worker pool. Results keep the
+    // order of `filepaths`; if any image fails, the first failure (in input
+    // order) is rethrown once the whole batch has finished.
+    inline std::vector<ImageData> a_loadImages(std::span<const std::filesystem::path> filepaths, bool flipVertically = false)
+    {
+        std::vector<ImageData> images(filepaths.size(), ImageData({}, 0, 0, 4));
+        std::vector<std::exception_ptr> errors(filepaths.size());
+
+        scheduler_parallel_for(filepaths.size(), [&](size_t i) {
+            try {
+                images[i] = a_loadImage(filepaths[i], flipVertically);
             }
-        }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
 
-        return ImageData{ std::move(pixels), w, h, 4 };
+        for (const auto& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+        return images;
+    }
+
+    // Decodes straight into caller-owned RGBA memory (for example the image's
+    // slot inside an atlas page) without an intermediate ImageData. Throws if
+    // the image does not fit `target`.
+    inline ImageSize a_loadImageInto(const std::filesystem::path& filepath, const RgbaView& target, bool flipVertically = false)
+    {
+        const auto decode = imagedetail::decoder_for(filepath);
+        if (!decode)
+            throw std::runtime_error("Unsupported image format: " + filepath.string());
+        return imagedetail::decode_file(filepath, decode, flipVertically, [&](int w, int h) {
+            return imagedetail::check_view(target, w, h, filepath);
+        });
     }
 } // namespace almondnamespace
@@ -30,39 +30,68 @@
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <span>
 #include <stdexcept>
 #include <cstring>
 #include <string>
 #include <algorithm>
 #include <iostream>
 
+// Declarations only; the implementation is compiled once in aimagecodecs.cpp.
+#include "../src/stb/stb_image_write.h"
+
 namespace almondnamespace
 {
-    inline bool a_writeBMP(const std::filesystem::path& filepath, const std::vector<uint8_t>& pixels, int width, int height, bool flipVertically)
+    namespace imagewriterdetail
     {
-        if (width <= 0 || height <= 0)
-            throw std::runtime_error("a_writeBMP: Invalid dimensions");
+        // Every writer assembles the complete file in memory and hands it to
+        // the OS in one write; per-byte stream calls dominated the old cost.
+        inline bool write_file(const std::filesystem::path& filepath, std::span<const uint8_t> bytes)
+        {
+            std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            return static_cast<bool>(out);
+        }
 
-        const int channels = 4; // expecting RGBA input
-        const int rowBytes = width * 3; // BMP stores as BGR, 3 bytes per pixel (no alpha)
-        const int padSize = (4 - (rowBytes % 4)) % 4;
-        const int stride = rowBytes + padSize;
+        // Appends `height` rows converted by `convert(srcRow, dstRow)`, reading
+        // bottom-up when `bottomUp` is set.
+        template <typename ConvertRow>
+        inline void append_rows(std::vector<uint8_t>& file, std::span<const uint8_t> pixels,
+            int width, int height, size_t dstStride, bool bottomUp, ConvertRow&& convert)
+        {
+            const size_t srcStride = size_t(width) * 4;
+            if (pixels.size() < srcStride * size_t(height))
+                throw std::runtime_error("Image writer: pixel buffer smaller than width*height*4");
+
+            const size_t base = file.size();
+            file.resize(base + dstStride * size_t(height), 0);
+            for (int y = 0; y < height; ++y) {
+                const int srcY = bottomUp ? (height - 1 - y) : y;
+                convert(pixels.data() + size_t(srcY) * srcStride, file.data() + base + size_t(y) * dstStride);
+            }
+        }
 
-        std::vector<uint8_t> bmpData(stride * height, 0);
+        // stb_image_write keeps its compression level and flip flag in
+        // globals, so PNG encodes are serialised.
+        inline std::mutex pngMutex;
 
-        for (int y = 0; y < height; ++y)
+        inline void append_bytes(void* context, void* data, int size)
         {
-            int srcY = flipVertically ? y : (height - 1 - y);
-            const uint8_t* srcRow = pixels.data() + size_t(srcY) * width * channels;
-            uint8_t* dstRow = bmpData.data() + size_t(y) * stride;
-
-            for (int x = 0; x < width; ++x)
-            {
-                dstRow[x * 3 + 0] = srcRow[x * channels + 2]; // B
-                dstRow[x * 3 + 1] = srcRow[x * channels + 1]; // G
-                dstRow[x * 3 + 2] = srcRow[x * channels + 0]; // R
-            }
+            auto* out = static_cast<std::vector<uint8_t>*>(context);
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            out->insert(out->end(), bytes, bytes + size);
         }
+    }
+
+    inline bool a_writeBMP(const std::filesystem::path& filepath, const std::vector<uint8_t>& pixels, int width, int height, bool flipVertically)
+    {
+        if (width <= 0 || height <= 0)
+            throw std::runtime_error("a_writeBMP: Invalid dimensions");
+
+        const size_t rowBytes = size_t(width) * 3; // BMP stores as BGR, 3 bytes per pixel (no alpha)
+        const size_t stride = (rowBytes + 3) & ~size_t(3);
 
         // BMP file header (14 bytes)
         uint8_t fileHeader[14] = {
@@ -88,22 +117,26 @@ namespace almondnamespace
             0,0,0,0            // Important colors
         };
 
-        uint32_t fileSize = 54 + static_cast<uint32_t>(bmpData.size());
-        // Fill file size
+        const uint32_t fileSize = 54 + static_cast<uint32_t>(stride * size_t(height));
         std::memcpy(&fileHeader[2], &fileSize, 4);
-        // Fill width
         std::memcpy(&infoHeader[4], &width, 4);
-        // Fill height
         std::memcpy(&infoHeader[8], &height, 4);
 
-        std::ofstream out(filepath, std::ios::binary);
-        if (!out) return false;
-
-        out.write(reinterpret_cast<const char*>(fileHeader), sizeof(fileHeader));
-        out.write(reinterpret_cast<const char*>(infoHeader), sizeof(infoHeader));
-        out.write(reinterpret_cast<const char*>(bmpData.data()), bmpData.size());
-
-        return true;
+        std::vector<uint8_t> file;
+        file.reserve(fileSize);
+        file.insert(file.end(), std::begin(fileHeader), std::end(fileHeader));
+        file.insert(file.end(), std::begin(infoHeader), std::end(infoHeader));
+
+        // BMP rows are stored bottom-up.
+        imagewriterdetail::append_rows(file, pixels, width, height, stride, !flipVertically,
+            [width](const uint8_t* src, uint8_t* dst) {
+                for (int x = 0; x < width; ++x) {
+                    dst[x * 3 + 0] = src[x * 4 + 2]; // B
+                    dst[x * 3 + 1] = src[x * 4 + 1]; // G
+                    dst[x * 3 + 2] = src[x * 4 + 0]; // R
+                }
+            });
+        return imagewriterdetail::write_file(filepath, file);
     }
 
     inline bool a_writeTGA(const std::filesystem::path& filepath, const std::vector<uint8_t>& pixels, int width, int height, bool flipVertically)
@@ -111,10 +144,6 @@ namespace almondnamespace
         if (width <= 0 || height <= 0)
             throw std::runtime_error("a_writeTGA: Invalid dimensions");
 
-        const int channels = 4; // expecting RGBA input
-        std::ofstream out(filepath, std::ios::binary);
-        if (!out) return false;
-
         uint8_t header[18] = { 0 };
         header[2] = 2; // Uncompressed true-color image
         header[12] = static_cast<uint8_t>(width & 0xFF);
@@ -124,22 +153,20 @@ namespace almondnamespace
         header[16] = 32; // bits per pixel
         header[17] = 0x20; // top-left origin
 
-        out.write(reinterpret_cast<const char*>(header), sizeof(header));
-
-        for (int y = 0; y < height; ++y)
-        {
-            int srcY = flipVertically ? (height - 1 - y) : y;
-            const uint8_t* srcRow = pixels.data() + size_t(srcY) * width * channels;
-
-            for (int x = 0; x < width; ++x)
-            {
-                out.put(static_cast<char>(srcRow[x * channels + 2])); // B
-                out.put(static_cast<char>(srcRow[x * channels + 1])); // G
-                out.put(static_cast<char>(srcRow[x * channels + 0])); // R
-                out.put(static_cast<char>(srcRow[x * channels + 3])); // A
-            }
-        }
-        return true;
+        std::vector<uint8_t> file;
+        file.reserve(sizeof(header) + size_t(width) * size_t(height) * 4);
+        file.insert(file.end(), std::begin(header), std::end(header));
+
+        imagewriterdetail::append_rows(file, pixels, width, height, size_t(width) * 4, flipVertically,
+            [width](const uint8_t* src, uint8_t* dst) {
+                for (int x = 0; x < width; ++x) {
+                    dst[x * 4 + 0] = src[x * 4 + 2]; // B
+                    dst[x * 4 + 1] = src[x * 4 + 1]; // G
+                    dst[x * 4 + 2] = src[x * 4 + 0]; // R
+                    dst[x * 4 + 3] = src[x * 4 + 3]; // A
+                }
+            });
+        return imagewriterdetail::write_file(filepath, file);
     }
 
     inline bool a_writePPM(const std::filesystem::path& filepath, const std::vector<uint8_t>& pixels, int width, int height, bool flipVertically)
@@ -147,28 +174,48 @@ namespace almondnamespace
         if (width <= 0 || height <= 0)
             throw std::runtime_error("a_writePPM: Invalid dimensions");
 
-        const int channels = 4; // expecting RGBA input
-        std::ofstream out(filepath, std::ios::binary);
-        if (!out) return false;
+        const std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+
+        std::vector<uint8_t> file;
+        file.reserve(header.size() + size_t(width) * size_t(height) * 3);
+        file.insert(file.end(), header.begin(), header.end());
+
+        imagewriterdetail::append_rows(file, pixels, width, height, size_t(width) * 3, flipVertically,
+            [width](const uint8_t* src, uint8_t* dst) {
+                for (int x = 0; x < width; ++x) {
+                    dst[x * 3 + 0] = src[x * 4 + 0]; // R
+                    dst[x * 3 + 1] = src[x * 4 + 1]; // G
+                    dst[x * 3 + 2] = src[x * 4 + 2]; // B
+                }
+            });
+        return imagewriterdetail::write_file(filepath, file);
+    }
 
-        out << "P6\n" << width << " " << height << "\n255\n";
+    // PNG through stb_image_write. `compressionLevel` is zlib-style: 0 stores,
+    // 1 is fastest, 9 smallest (stb's default is 8).
+    inline bool a_writePNG(const std::filesystem::path& filepath, const std::vector<uint8_t>& pixels, int width, int height,
+        bool flipVertically, int compressionLevel = 6)
+    {
+        if (width <= 0 || height <= 0)
+            throw std::runtime_error("a_writePNG: Invalid dimensions");
+        if (pixels.size() < size_t(width) * size_t(height) * 4)
+            throw std::runtime_error("a_writePNG: pixel buffer smaller than width*height*4");
 
-        for (int y = 0; y < height; ++y)
+        std::vector<uint8_t> file;
         {
-            int srcY = flipVertically ? (height - 1 - y) : y;
-            const uint8_t* srcRow = pixels.data() + size_t(srcY) * width * channels;
-
-            for (int x = 0; x < width; ++x)
-            {
-                out.put(static_cast<char>(srcRow[x * channels + 0])); // R
-                out.put(static_cast<char>(srcRow[x * channels + 1])); // G
-                out.put(static_cast<char>(srcRow[x * channels + 2])); // B
-            }
+            std::scoped_lock lock(imagewriterdetail::pngMutex);
+            stbi_write_png_compression_level = std::clamp(compressionLevel, 0, 9);
+            stbi_flip_vertically_on_write(flipVertically ? 1 : 0);
+            const int ok = stbi_write_png_to_func(imagewriterdetail::append_bytes, &file,
+                width, height, 4, pixels.data(), width * 4);
+            stbi_flip_vertically_on_write(0);
+            if (!ok) return false;
         }
-        return true;
+        return imagewriterdetail::write_file(filepath, file);
     }
 
-    inline bool a_writeImage(const std::filesystem::path& filepath, const std::vector<uint8_t>& pixels, int width, int height, bool flipVertically = false)
+    inline bool a_writeImage(const std::filesystem::path& filepath, const std::vector<uint8_t>& pixels, int width, int height,
+        bool flipVertically = false, int pngCompressionLevel = 6)
     {
         auto ext = filepath.extension().string();
         std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
@@ -176,6 +223,7 @@ namespace almondnamespace
         if (ext == ".bmp") return a_writeBMP(filepath, pixels, width, height, flipVertically);
         if (ext == ".tga") return a_writeTGA(filepath, pixels, width, height, flipVertically);
         if (ext == ".ppm") return a_writePPM(filepath, pixels, width, height, flipVertically);
+        if (ext == ".png") return a_writePNG(filepath, pixels, width, height, flipVertically, pngCompressionLevel);
 
         std::cerr << "Unsupported image format for writing: " << ext << "\n";
         return false;
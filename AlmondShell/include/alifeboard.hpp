@@ -0,0 +1,325 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // alifeboard.hpp
+#pragma once
+
+#include "aenginesystems.hpp"   // scheduler_parallel_for
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace almondnamespace::cellular
+{
+    // ─── Rules ──────────────────────────────────────────────────────
+    // Outer-totalistic Moore-neighbourhood rule: bit n of `birth` /
+    // `survive` is set when a cell with n live neighbours is born / stays.
+    struct LifeRule
+    {
+        std::uint16_t birth = 1u << 3;
+        std::uint16_t survive = (1u << 2) | (1u << 3);
+
+        [[nodiscard]] bool is_conway() const noexcept { return birth == (1u << 3) && survive == ((1u << 2) | (1u << 3)); }
+        [[nodiscard]] bool operator==(const LifeRule&) const = default;
+
+        // Accepts "B3/S23" (any case, either order) and the older "23/3"
+        // survive/birth notation.
+        [[nodiscard]] static std::optional<LifeRule> parse(std::string_view text)
+        {
+            auto digits = [](std::string_view part, std::uint16_t& mask) {
+                for (char ch : part) {
+                    if (ch < '0' || ch > '8') return false;
+                    mask |= static_cast<std::uint16_t>(1u << (ch - '0'));
+                }
+                return true;
+            };
+
+            const std::size_t slash = text.find('/');
+            if (slash == std::string_view::npos)
+                return std::nullopt;
+            std::string_view first = text.substr(0, slash);
+            std::string_view second = text.substr(slash + 1);
+
+            LifeRule rule{ 0, 0 };
+            auto tagged = [&](std::string_view part) {
+                if (part.empty()) return false;
+                const char tag = static_cast<char>(part.front() | 0x20);
+                if (tag == 'b') return digits(part.substr(1), rule.birth);
+                if (tag == 's') return digits(part.substr(1), rule.survive);
+                return false;
+            };
+
+            if (!first.empty() && (first.front() | 0x20) != 'b' && (first.front() | 0x20) != 's') {
+                if (!digits(first, rule.survive) || !digits(second, rule.birth))
+                    return std::nullopt;
+                return rule;
+            }
+            if (!tagged(first) || !tagged(second))
+                return std::nullopt;
+            return rule;
+        }
+
+        [[nodiscard]] std::string to_string() const
+        {
+            std::string out = "B";
+            for (int n = 0; n <= 8; ++n) if (birth & (1u << n)) out.push_back(static_cast<char>('0' + n));
+            out += "/S";
+            for (int n = 0; n <= 8; ++n) if (survive & (1u << n)) out.push_back(static_cast<char>('0' + n));
+            return out;
+        }
+    };
+
+    // ─── SWAR kernel ────────────────────────────────────────────────
+    // Rule expanded to all-ones / all-zero word masks per neighbour count.
+    struct LifeRuleMasks
+    {
+        std::uint64_t born[9]{};
+        std::uint64_t keep[9]{};
+
+        explicit LifeRuleMasks(const LifeRule& rule) noexcept
+        {
+            for (int n = 0; n <= 8; ++n) {
+                born[n] = (rule.birth >> n) & 1u ? ~std::uint64_t{ 0 } : 0;
+                keep[n] = (rule.survive >> n) & 1u ? ~std::uint64_t{ 0 } : 0;
+            }
+        }
+    };
+
+    // (sum, carry) of three one-bit planes.
+    inline void life_add3(std::uint64_t a, std::uint64_t b, std::uint64_t c,
+        std::uint64_t& sum, std::uint64_t& carry) noexcept
+    {
+        const std::uint64_t ab = a ^ b;
+        sum = ab ^ c;
+        carry = (a & b) | (c & ab);
+    }
+
+    // Next state of 64 cells (`c`) given the rows above/below and the
+    // west/east shifted planes of all three rows. The eight neighbour planes
+    // are summed with full adders into four count planes.
+    template <bool Conway>
+    inline std::uint64_t life_next_word(
+        std::uint64_t uw, std::uint64_t u, std::uint64_t ue,
+        std::uint64_t cw, std::uint64_t c, std::uint64_t ce,
+        std::uint64_t dw, std::uint64_t d, std::uint64_t de,
+        const LifeRuleMasks& masks) noexcept
+    {
+        std::uint64_t t0, t1, b0, b1, s0, k1, x, k2;
+        life_add3(uw, u, ue, t0, t1);
+        life_add3(dw, d, de, b0, b1);
+        const std::uint64_t m0 = cw ^ ce;
+        const std::uint64_t m1 = cw & ce;
+        life_add3(t0, m0, b0, s0, k1);              // ones plane + carry into twos
+        life_add3(t1, m1, b1, x, k2);               // three twos -> twos + fours
+        const std::uint64_t s1 = x ^ k1;
+        const std::uint64_t k3 = x & k1;
+        const std::uint64_t s2 = k2 ^ k3;           // fours plane
+        const std::uint64_t s3 = k2 & k3;           // eights plane (count == 8)
+
+        if constexpr (Conway) {
+            // count == 3, or alive with count == 2
+            return s1 & ~s2 & ~s3 & (s0 | c);
+        }
+        else {
+            std::uint64_t next = 0;
+            for (int n = 0; n <= 8; ++n) {
+                const std::uint64_t eq = ((n & 1) ? s0 : ~s0) & ((n & 2) ? s1 : ~s1)
+                    & ((n & 4) ? s2 : ~s2) & ((n & 8) ? s3 : ~s3);
+                next |= eq & ((masks.born[n] & ~c) | (masks.keep[n] & c));
+            }
+            return next;
+        }
+    }
+
+    // ─── Bit-packed board ───────────────────────────────────────────
+    // 64 cells per word, bit i of word k in a row is column k*64+i. Two
+    // buffers are kept and swapped after each step, so stepping never
+    // copies the board; each word goes through life_next_word.
+    class LifeBoard
+    {
+    public:
+        static constexpr int MaxDimension = 8192;
+        static constexpr int BandRows = 64;            // rows per parallel job
+        static constexpr std::size_t ParallelWords = 1u << 14; // below this a step runs inline
+
+        LifeBoard() = default;
+        LifeBoard(int width, int height, bool wrap = true) { resize(width, height, wrap); }
+
+        void resize(int width, int height, bool wrap = true)
+        {
+            width_ = std::clamp(width, 1, MaxDimension);
+            height_ = std::clamp(height, 1, MaxDimension);
+            wrap_ = wrap;
+            stride_ = (static_cast<std::size_t>(width_) + 63) / 64;
+            const int tailBits = width_ % 64;
+            tailMask_ = tailBits ? (std::uint64_t{ 1 } << tailBits) - 1 : ~std::uint64_t{ 0 };
+            cells_.assign(stride_ * static_cast<std::size_t>(height_), 0);
+            next_.assign(cells_.size(), 0);
+            generation_ = 0;
+        }
+
+        [[nodiscard]] int width() const noexcept { return width_; }
+        [[nodiscard]] int height() const noexcept { return height_; }
+        [[nodiscard]] bool wraps() const noexcept { return wrap_; }
+        [[nodiscard]] std::size_t words_per_row() const noexcept { return stride_; }
+        [[nodiscard]] std::uint64_t generation() const noexcept { return generation_; }
+
+        [[nodiscard]] std::span<const std::uint64_t> row(int y) const noexcept
+        {
+            return { cells_.data() + static_cast<std::size_t>(y) * stride_, stride_ };
+        }
+
+        [[nodiscard]] bool get(int x, int y) const noexcept
+        {
+            if (x < 0 || y < 0 || x >= width_ || y >= height_) return false;
+            return (cells_[static_cast<std::size_t>(y) * stride_ + static_cast<std::size_t>(x >> 6)] >> (x & 63)) & 1u;
+        }
+
+        void set(int x, int y, bool alive) noexcept
+        {
+            if (x < 0 || y < 0 || x >= width_ || y >= height_) return;
+            auto& word = cells_[static_cast<std::size_t>(y) * stride_ + static_cast<std::size_t>(x >> 6)];
+            const std::uint64_t bit = std::uint64_t{ 1 } << (x & 63);
+            word = alive ? (word | bit) : (word & ~bit);
+        }
+
+        void clear() noexcept { std::fill(cells_.begin(), cells_.end(), 0); }
+
+        void randomize(std::uint64_t seed, double density)
+        {
+            std::mt19937_64 rng{ seed };
+            std::bernoulli_distribution d{ std::clamp(density, 0.0, 1.0) };
+            for (int y = 0; y < height_; ++y) {
+                std::uint64_t* r = cells_.data() + static_cast<std::size_t>(y) * stride_;
+                for (std::size_t k = 0; k < stride_; ++k) {
+                    std::uint64_t word = 0;
+                    for (int b = 0; b < 64; ++b)
+                        word |= std::uint64_t{ d(rng) } << b;
+                    r[k] = word;
+                }
+                r[stride_ - 1] &= tailMask_;
+            }
+        }
+
+        [[nodiscard]] std::size_t population() const noexcept
+        {
+            std::size_t total = 0;
+            for (std::uint64_t w : cells_) total += static_cast<std::size_t>(std::popcount(w));
+            return total;
+        }
+
+        // Advances one generation. Row bands go to the engine worker pool
+        // when the board is large enough to pay for the hand-off.
+        void step(const LifeRule& rule, bool parallel = true)
+        {
+            if (cells_.empty())
+                return;
+
+            const LifeRuleMasks masks{ rule };
+            const std::size_t bands = (static_cast<std::size_t>(height_) + BandRows - 1) / BandRows;
+            auto run_band = [&](std::size_t band) {
+                const int y0 = static_cast<int>(band) * BandRows;
+                const int y1 = (std::min)(height_, y0 + BandRows);
+                if (rule.is_conway()) step_rows<true>(masks, y0, y1);
+                else step_rows<false>(masks, y0, y1);
+            };
+
+            if (parallel && bands > 1 && cells_.size() >= ParallelWords
+                && std::thread::hardware_concurrency() > 1) {
+                scheduler_parallel_for(bands, run_band);
+            }
+            else {
+                for (std::size_t band = 0; band < bands; ++band)
+                    run_band(band);
+            }
+
+            cells_.swap(next_);
+            ++generation_;
+        }
+
+    private:
+        // West/east neighbour planes of word k: bit i holds column i-1 / i+1.
+        void shifted(const std::uint64_t* r, std::size_t k, std::uint64_t& west, std::uint64_t& east) const noexcept
+        {
+            const std::uint64_t w = r[k];
+            const std::size_t last = stride_ - 1;
+            const int tailBit = (width_ - 1) & 63;
+
+            std::uint64_t inWest = 0; // column just left of this word's bit 0
+            std::uint64_t inEast = 0; // column just right of this word's last bit
+            if (k > 0) inWest = r[k - 1] >> 63;
+            else if (wrap_) inWest = (r[last] >> tailBit) & 1u;
+            if (k < last) inEast = r[k + 1] & 1u;
+            else if (wrap_) inEast = r[0] & 1u;
+
+            west = (w << 1) | inWest;
+            east = (k < last) ? ((w >> 1) | (inEast << 63)) : ((w >> 1) | (inEast << tailBit));
+        }
+
+        template <bool Conway>
+        void step_rows(const LifeRuleMasks& masks, int y0, int y1) noexcept
+        {
+            static thread_local std::vector<std::uint64_t> zeroRow;
+            if (zeroRow.size() < stride_) zeroRow.assign(stride_, 0);
+
+            for (int y = y0; y < y1; ++y) {
+                const std::uint64_t* cur = cells_.data() + static_cast<std::size_t>(y) * stride_;
+                const std::uint64_t* up = zeroRow.data();
+                const std::uint64_t* down = zeroRow.data();
+                if (y > 0) up = cur - stride_;
+                else if (wrap_) up = cells_.data() + static_cast<std::size_t>(height_ - 1) * stride_;
+                if (y + 1 < height_) down = cur + stride_;
+                else if (wrap_) down = cells_.data();
+                std::uint64_t* out = next_.data() + static_cast<std::size_t>(y) * stride_;
+
+                for (std::size_t k = 0; k < stride_; ++k) {
+                    std::uint64_t uw, ue, cw, ce, dw, de;
+                    shifted(up, k, uw, ue);
+                    shifted(cur, k, cw, ce);
+                    shifted(down, k, dw, de);
+                    out[k] = life_next_word<Conway>(uw, up[k], ue, cw, cur[k], ce, dw, down[k], de, masks);
+                }
+                out[stride_ - 1] &= tailMask_;
+            }
+        }
+
+        int width_ = 0;
+        int height_ = 0;
+        bool wrap_ = true;
+        std::size_t stride_ = 0;
+        std::uint64_t tailMask_ = ~std::uint64_t{ 0 };
+        std::vector<std::uint64_t> cells_{};
+        std::vector<std::uint64_t> next_{};
+        std::uint64_t generation_ = 0;
+    };
+
+} // namespace almondnamespace::cellular
@@ -0,0 +1,550 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // alifeworld.hpp
+#pragma once
+
+#include "alifeboard.hpp"       // LifeRule, life_next_word
+#include "aenginesystems.hpp"   // scheduler_parallel_for
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace almondnamespace::cellular
+{
+    // ─── Chunked world ──────────────────────────────────────────────
+    // Unbounded board stored as 64×64 tiles (one word per tile row). Only
+    // tiles that changed last generation, and their neighbours, are stepped;
+    // settled and empty regions cost nothing and empty tiles are dropped.
+    // Rules with B0 would fill the infinite background and are rejected.
+    class LifeChunkWorld
+    {
+    public:
+        static constexpr int TileSize = 64;
+        static constexpr std::size_t ParallelTiles = 32; // fewer candidates step inline
+
+        using Tile = std::array<std::uint64_t, TileSize>;
+
+        [[nodiscard]] bool get(std::int64_t x, std::int64_t y) const noexcept
+        {
+            const auto it = tiles_.find(tile_key(x >> 6, y >> 6));
+            return it != tiles_.end() && ((it->second[y & 63] >> (x & 63)) & 1u);
+        }
+
+        void set(std::int64_t x, std::int64_t y, bool alive)
+        {
+            const std::uint64_t key = tile_key(x >> 6, y >> 6);
+            const std::uint64_t bit = std::uint64_t{ 1 } << (x & 63);
+            auto it = tiles_.find(key);
+            if (it == tiles_.end()) {
+                if (!alive) return;
+                it = tiles_.emplace(key, Tile{}).first;
+            }
+            auto& row = it->second[y & 63];
+            const std::uint64_t before = row;
+            row = alive ? (row | bit) : (row & ~bit);
+            if (row != before)
+                changed_.push_back(key);
+        }
+
+        void clear() noexcept
+        {
+            tiles_.clear();
+            changed_.clear();
+            generation_ = 0;
+        }
+
+        [[nodiscard]] std::size_t tile_count() const noexcept { return tiles_.size(); }
+        [[nodiscard]] std::size_t stepped_tiles() const noexcept { return lastStepped_; }
+        [[nodiscard]] std::uint64_t generation() const noexcept { return generation_; }
+
+        [[nodiscard]] std::uint64_t population() const noexcept
+        {
+            std::uint64_t total = 0;
+            for (const auto& [key, tile] : tiles_)
+                for (std::uint64_t row : tile) total += static_cast<std::uint64_t>(std::popcount(row));
+            return total;
+        }
+
+        // Calls fn(x, y) for live cells with x0 <= x < x1, y0 <= y < y1.
+        template <typename Fn>
+        void for_each_live(std::int64_t x0, std::int64_t y0, std::int64_t x1, std::int64_t y1, Fn&& fn) const
+        {
+            for (std::int64_t ty = y0 >> 6; ty <= (y1 - 1) >> 6; ++ty) {
+                for (std::int64_t tx = x0 >> 6; tx <= (x1 - 1) >> 6; ++tx) {
+                    const auto it = tiles_.find(tile_key(tx, ty));
+                    if (it == tiles_.end()) continue;
+                    for (int r = 0; r < TileSize; ++r) {
+                        const std::int64_t y = ty * TileSize + r;
+                        if (y < y0 || y >= y1) continue;
+                        for (std::uint64_t bits = it->second[r]; bits; bits &= bits - 1) {
+                            const std::int64_t x = tx * TileSize + std::countr_zero(bits);
+                            if (x >= x0 && x < x1) fn(x, y);
+                        }
+                    }
+                }
+            }
+        }
+
+        bool step(const LifeRule& rule, bool parallel = true)
+        {
+            if (rule.birth & 1u) {
+                std::cerr << "[Cellular] B0 rules cannot run on an unbounded world\n";
+                return false;
+            }
+
+            // A tile that settled under the old rule may not be settled
+            // under the new one, so a rule change wakes every tile.
+            if (lastRule_ && *lastRule_ != rule)
+                for (const auto& [key, tile] : tiles_)
+                    changed_.push_back(key);
+            lastRule_ = rule;
+
+            // Candidates: every tile that changed plus its eight neighbours.
+            candidates_.clear();
+            for (std::uint64_t key : changed_) {
+                const auto [tx, ty] = tile_coords(key);
+                for (std::int64_t dy = -1; dy <= 1; ++dy)
+                    for (std::int64_t dx = -1; dx <= 1; ++dx)
+                        candidates_.push_back(tile_key(tx + dx, ty + dy));
+            }
+            std::sort(candidates_.begin(), candidates_.end());
+            candidates_.erase(std::unique(candidates_.begin(), candidates_.end()), candidates_.end());
+            lastStepped_ = candidates_.size();
+
+            results_.resize(candidates_.size());
+            const LifeRuleMasks masks{ rule };
+            const bool conway = rule.is_conway();
+            auto step_one = [&](std::size_t i) {
+                if (conway) step_tile<true>(candidates_[i], masks, results_[i]);
+                else step_tile<false>(candidates_[i], masks, results_[i]);
+            };
+
+            if (parallel && candidates_.size() >= ParallelTiles) {
+                const std::size_t groups = (candidates_.size() + 15) / 16;
+                scheduler_parallel_for(groups, [&](std::size_t g) {
+                    const std::size_t end = (std::min)(candidates_.size(), (g + 1) * 16);
+                    for (std::size_t i = g * 16; i < end; ++i) step_one(i);
+                });
+            }
+            else {
+                for (std::size_t i = 0; i < candidates_.size(); ++i) step_one(i);
+            }
+
+            // Reads are finished; publish the new generation.
+            changed_.clear();
+            for (std::size_t i = 0; i < candidates_.size(); ++i) {
+                const std::uint64_t key = candidates_[i];
+                const Tile& next = results_[i];
+                const bool empty = std::all_of(next.begin(), next.end(), [](std::uint64_t r) { return r == 0; });
+                auto it = tiles_.find(key);
+                if (it == tiles_.end()) {
+                    if (empty) continue;
+                    tiles_.emplace(key, next);
+                    changed_.push_back(key);
+                    continue;
+                }
+                if (it->second == next) continue;
+                changed_.push_back(key);
+                if (empty) tiles_.erase(it);
+                else it->second = next;
+            }
+            ++generation_;
+            return true;
+        }
+
+    private:
+        [[nodiscard]] static std::uint64_t tile_key(std::int64_t tx, std::int64_t ty) noexcept
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(tx)) << 32) | static_cast<std::uint32_t>(ty);
+        }
+
+        [[nodiscard]] static std::pair<std::int64_t, std::int64_t> tile_coords(std::uint64_t key) noexcept
+        {
+            return { static_cast<std::int32_t>(key >> 32), static_cast<std::int32_t>(key & 0xFFFFFFFFu) };
+        }
+
+        [[nodiscard]] const Tile& tile_or_empty(std::int64_t tx, std::int64_t ty) const noexcept
+        {
+            static const Tile empty{};
+            const auto it = tiles_.find(tile_key(tx, ty));
+            return it == tiles_.end() ? empty : it->second;
+        }
+
+        template <bool Conway>
+        void step_tile(std::uint64_t key, const LifeRuleMasks& masks, Tile& out) const noexcept
+        {
+            const auto [tx, ty] = tile_coords(key);
+            const Tile& nw = tile_or_empty(tx - 1, ty - 1);
+            const Tile& n = tile_or_empty(tx, ty - 1);
+            const Tile& ne = tile_or_empty(tx + 1, ty - 1);
+            const Tile& w = tile_or_empty(tx - 1, ty);
+            const Tile& c = tile_or_empty(tx, ty);
+            const Tile& e = tile_or_empty(tx + 1, ty);
+            const Tile& sw = tile_or_empty(tx - 1, ty + 1);
+            const Tile& s = tile_or_empty(tx, ty + 1);
+            const Tile& se = tile_or_empty(tx + 1, ty + 1);
+
+            // Row r in [-1, 64] with its west/east shifted planes.
+            auto planes = [&](int r, std::uint64_t& west, std::uint64_t& mid, std::uint64_t& east) {
+                std::uint64_t wr, er;
+                if (r < 0) { wr = nw[63]; mid = n[63]; er = ne[63]; }
+                else if (r >= TileSize) { wr = sw[0]; mid = s[0]; er = se[0]; }
+                else { wr = w[r]; mid = c[r]; er = e[r]; }
+                west = (mid << 1) | (wr >> 63);
+                east = (mid >> 1) | ((er & 1u) << 63);
+            };
+
+            std::uint64_t uw, u, ue, cw, cm, ce;
+            planes(-1, uw, u, ue);
+            planes(0, cw, cm, ce);
+            for (int r = 0; r < TileSize; ++r) {
+                std::uint64_t dw, d, de;
+                planes(r + 1, dw, d, de);
+                out[r] = life_next_word<Conway>(uw, u, ue, cw, cm, ce, dw, d, de, masks);
+                uw = cw; u = cm; ue = ce;
+                cw = dw; cm = d; ce = de;
+            }
+        }
+
+        std::unordered_map<std::uint64_t, Tile> tiles_{};
+        std::vector<std::uint64_t> changed_{};     // tiles edited or changed by the last step
+        std::vector<std::uint64_t> candidates_{};  // scratch, kept between steps
+        std::vector<Tile> results_{};
+        std::optional<LifeRule> lastRule_{};
+        std::size_t lastStepped_ = 0;
+        std::uint64_t generation_ = 0;
+    };
+
+    // ─── HashLife ───────────────────────────────────────────────────
+    // Quadtree of hash-consed nodes; a node of level k is a 2^k square.
+    // advance(2^j) memoises the centred result of every node it touches, so
+    // repeating or sparse patterns jump huge generation counts at the cost
+    // of node memory (collected once `max_nodes` is exceeded).
+    class HashLife
+    {
+    public:
+        using NodeId = std::uint32_t;
+
+        explicit HashLife(LifeRule rule = {}, std::size_t maxNodes = std::size_t{ 1 } << 22)
+            : rule_(rule), masks_(rule), maxNodes_(maxNodes)
+        {
+            reset_store();
+            root_ = empty(3);
+        }
+
+        [[nodiscard]] const LifeRule& rule() const noexcept { return rule_; }
+        [[nodiscard]] std::uint64_t generation() const noexcept { return generation_; }
+        [[nodiscard]] std::uint64_t population() const noexcept { return nodes_[root_].population; }
+        [[nodiscard]] std::size_t node_count() const noexcept { return nodes_.size(); }
+
+        void clear()
+        {
+            reset_store();
+            root_ = empty(3);
+            generation_ = 0;
+        }
+
+        // Cells live in [-2^(L-1), 2^(L-1)) of the root; the root grows to fit.
+        void set(std::int64_t x, std::int64_t y, bool alive)
+        {
+            while (!contains(x, y))
+                root_ = expand(root_);
+            root_ = set_in(root_, x, y, alive);
+        }
+
+        [[nodiscard]] bool get(std::int64_t x, std::int64_t y) const noexcept
+        {
+            if (!contains(x, y)) return false;
+            for (NodeId id = root_;;) {
+                const Node& nd = nodes_[id];
+                const bool east = x >= 0, south = y >= 0;
+                const NodeId child = south ? (east ? nd.se : nd.sw) : (east ? nd.ne : nd.nw);
+                if (nd.level == 1)
+                    return child == AliveCell;
+                const std::int64_t quarter = std::int64_t{ 1 } << (nd.level - 2);
+                x += east ? -quarter : quarter;
+                y += south ? -quarter : quarter;
+                id = child;
+            }
+        }
+
+        // Advances `generations` by summing power-of-two jumps.
+        bool advance(std::uint64_t generations)
+        {
+            if (rule_.birth & 1u) {
+                std::cerr << "[Cellular] B0 rules cannot run on an unbounded world\n";
+                return false;
+            }
+            for (unsigned j = 0; generations; ++j, generations >>= 1)
+                if (generations & 1u) advance_pow2(j);
+            return true;
+        }
+
+        void advance_pow2(unsigned j)
+        {
+            // The root must be big enough for the jump and the pattern must
+            // sit inside its centre so the result does not lose cells.
+            while (nodes_[root_].level < j + 2 || !padded(root_))
+                root_ = expand(root_);
+            root_ = expand(root_);
+            root_ = result(root_, j);
+            generation_ += std::uint64_t{ 1 } << j;
+            if (nodes_.size() > maxNodes_)
+                collect();
+        }
+
+        template <typename Fn>
+        void for_each_live(Fn&& fn) const
+        {
+            const std::int64_t half = std::int64_t{ 1 } << (nodes_[root_].level - 1);
+            visit(root_, -half, -half, fn);
+        }
+
+    private:
+        static constexpr NodeId DeadCell = 0;
+        static constexpr NodeId AliveCell = 1;
+
+        struct Node
+        {
+            NodeId nw = 0, ne = 0, sw = 0, se = 0;
+            std::uint32_t level = 0;
+            std::uint64_t population = 0;
+        };
+
+        struct Quad
+        {
+            NodeId nw, ne, sw, se;
+            bool operator==(const Quad&) const = default;
+        };
+        struct QuadHash
+        {
+            std::size_t operator()(const Quad& q) const noexcept
+            {
+                std::uint64_t h = q.nw;
+                h = h * 0x9E3779B97F4A7C15ull + q.ne;
+                h = h * 0x9E3779B97F4A7C15ull + q.sw;
+                h = h * 0x9E3779B97F4A7C15ull + q.se;
+                return static_cast<std::size_t>(h ^ (h >> 29));
+            }
+        };
+
+        void reset_store()
+        {
+            nodes_.clear();
+            nodes_.push_back({ 0, 0, 0, 0, 0, 0 });  // DeadCell
+            nodes_.push_back({ 0, 0, 0, 0, 0, 1 });  // AliveCell
+            unique_.clear();
+            results_.clear();
+            empties_.assign(1, DeadCell);
+        }
+
+        NodeId make(NodeId nw, NodeId ne, NodeId sw, NodeId se)
+        {
+            const Quad q{ nw, ne, sw, se };
+            if (auto it = unique_.find(q); it != unique_.end())
+                return it->second;
+            Node nd{ nw, ne, sw, se, nodes_[nw].level + 1,
+                nodes_[nw].population + nodes_[ne].population + nodes_[sw].population + nodes_[se].population };
+            const NodeId id = static_cast<NodeId>(nodes_.size());
+            nodes_.push_back(nd);
+            unique_.emplace(q, id);
+            return id;
+        }
+
+        NodeId empty(std::uint32_t level)
+        {
+            while (empties_.size() <= level) {
+                const NodeId e = empties_.back();
+                empties_.push_back(make(e, e, e, e));
+            }
+            return empties_[level];
+        }
+
+        [[nodiscard]] bool contains(std::int64_t x, std::int64_t y) const noexcept
+        {
+            const std::int64_t half = std::int64_t{ 1 } << (nodes_[root_].level - 1);
+            return x >= -half && x < half && y >= -half && y < half;
+        }
+
+        NodeId expand(NodeId id)
+        {
+            const Node nd = nodes_[id];
+            const NodeId e = empty(nd.level - 1);
+            return make(make(e, e, e, nd.nw), make(e, e, nd.ne, e),
+                make(e, nd.sw, e, e), make(nd.se, e, e, e));
+        }
+
+        // True when all live cells are inside the centre half of the node.
+        [[nodiscard]] bool padded(NodeId id) const noexcept
+        {
+            const Node& nd = nodes_[id];
+            if (nd.level < 3) return nd.population == 0;
+            const Node& a = nodes_[nd.nw]; const Node& b = nodes_[nd.ne];
+            const Node& c = nodes_[nd.sw]; const Node& d = nodes_[nd.se];
+            const std::uint64_t inner = nodes_[a.se].population + nodes_[b.sw].population
+                + nodes_[c.ne].population + nodes_[d.nw].population;
+            return inner == nd.population;
+        }
+
+        NodeId set_in(NodeId id, std::int64_t x, std::int64_t y, bool alive)
+        {
+            const Node nd = nodes_[id];
+            if (nd.level == 0)
+                return alive ? AliveCell : DeadCell;
+            if (nd.level == 1) {
+                // Children are cells: x, y in [-1, 0].
+                NodeId q[4] = { nd.nw, nd.ne, nd.sw, nd.se };
+                q[(y >= 0 ? 2 : 0) + (x >= 0 ? 1 : 0)] = alive ? AliveCell : DeadCell;
+                return make(q[0], q[1], q[2], q[3]);
+            }
+            const std::int64_t quarter = std::int64_t{ 1 } << (nd.level - 2);
+            const bool east = x >= 0, south = y >= 0;
+            const std::int64_t cx = x + (east ? -quarter : quarter);
+            const std::int64_t cy = y + (south ? -quarter : quarter);
+            NodeId q[4] = { nd.nw, nd.ne, nd.sw, nd.se };
+            NodeId& child = q[(south ? 2 : 0) + (east ? 1 : 0)];
+            child = set_in(child, cx, cy, alive);
+            return make(q[0], q[1], q[2], q[3]);
+        }
+
+        // Level-2 node (4×4): centre 2×2 after one generation. The four
+        // rows go through the same life_next_word kernel as the boards,
+        // bit x of row[y] being cell (x, y).
+        NodeId base_step(NodeId id)
+        {
+            const Node& nd = nodes_[id];
+            std::uint64_t row[4]{};
+            const NodeId quads[4] = { nd.nw, nd.ne, nd.sw, nd.se };
+            for (int qi = 0; qi < 4; ++qi) {
+                const Node& q = nodes_[quads[qi]];
+                const int ox = (qi & 1) * 2, oy = (qi >> 1) * 2;
+                if (q.nw == AliveCell) row[oy] |= 1u << ox;
+                if (q.ne == AliveCell) row[oy] |= 1u << (ox + 1);
+                if (q.sw == AliveCell) row[oy + 1] |= 1u << ox;
+                if (q.se == AliveCell) row[oy + 1] |= 1u << (ox + 1);
+            }
+            auto next_row = [&](int y) {
+                const std::uint64_t u = row[y - 1], c = row[y], d = row[y + 1];
+                return rule_.is_conway()
+                    ? life_next_word<true>(u << 1, u, u >> 1, c << 1, c, c >> 1, d << 1, d, d >> 1, masks_)
+                    : life_next_word<false>(u << 1, u, u >> 1, c << 1, c, c >> 1, d << 1, d, d >> 1, masks_);
+            };
+            const std::uint64_t r1 = next_row(1), r2 = next_row(2);
+            auto cell = [](std::uint64_t bits, int x) { return ((bits >> x) & 1u) ? AliveCell : DeadCell; };
+            return make(cell(r1, 1), cell(r1, 2), cell(r2, 1), cell(r2, 2));
+        }
+
+        NodeId centre(NodeId id)
+        {
+            const Node& nd = nodes_[id];
+            return make(nodes_[nd.nw].se, nodes_[nd.ne].sw, nodes_[nd.sw].ne, nodes_[nd.se].nw);
+        }
+
+        // Centred level k-1 result of a level-k node after 2^j generations
+        // (j <= k-2). At j == k-2 both halves of the recursion advance time;
+        // below that the first half only re-centres.
+        NodeId result(NodeId id, unsigned j)
+        {
+            const Node nd = nodes_[id];
+            if (nd.population == 0)
+                return empty(nd.level - 1);
+            const std::uint64_t memoKey = (static_cast<std::uint64_t>(id) << 6) | j;
+            if (auto it = results_.find(memoKey); it != results_.end())
+                return it->second;
+
+            NodeId out;
+            if (nd.level == 2) {
+                out = base_step(id);
+            }
+            else {
+                const Node a = nodes_[nd.nw], b = nodes_[nd.ne], c = nodes_[nd.sw], d = nodes_[nd.se];
+                const NodeId n00 = nd.nw, n01 = make(a.ne, b.nw, a.se, b.sw), n02 = nd.ne;
+                const NodeId n10 = make(a.sw, a.se, c.nw, c.ne);
+                const NodeId n11 = make(a.se, b.sw, c.ne, d.nw);
+                const NodeId n12 = make(b.sw, b.se, d.nw, d.ne);
+                const NodeId n20 = nd.sw, n21 = make(c.ne, d.nw, c.se, d.sw), n22 = nd.se;
+
+                const bool full = j + 2 == nd.level;
+                auto first = [&](NodeId n) { return full ? result(n, j - 1) : centre(n); };
+                const NodeId r00 = first(n00), r01 = first(n01), r02 = first(n02);
+                const NodeId r10 = first(n10), r11 = first(n11), r12 = first(n12);
+                const NodeId r20 = first(n20), r21 = first(n21), r22 = first(n22);
+
+                const unsigned j2 = full ? j - 1 : j;
+                out = make(result(make(r00, r01, r10, r11), j2), result(make(r01, r02, r11, r12), j2),
+                    result(make(r10, r11, r20, r21), j2), result(make(r11, r12, r21, r22), j2));
+            }
+            results_.emplace(memoKey, out);
+            return out;
+        }
+
+        // Drops every node the root no longer references.
+        void collect()
+        {
+            std::vector<Node> old = std::move(nodes_);
+            reset_store();
+            std::unordered_map<NodeId, NodeId> remap{ { DeadCell, DeadCell }, { AliveCell, AliveCell } };
+            auto copy = [&](auto&& self, NodeId id) -> NodeId {
+                if (auto it = remap.find(id); it != remap.end()) return it->second;
+                const Node& nd = old[id];
+                const NodeId out = make(self(self, nd.nw), self(self, nd.ne), self(self, nd.sw), self(self, nd.se));
+                remap.emplace(id, out);
+                return out;
+            };
+            root_ = copy(copy, root_);
+        }
+
+        template <typename Fn>
+        void visit(NodeId id, std::int64_t x, std::int64_t y, Fn& fn) const
+        {
+            const Node& nd = nodes_[id];
+            if (nd.population == 0) return;
+            if (nd.level == 0) { fn(x, y); return; }
+            const std::int64_t half = std::int64_t{ 1 } << (nd.level - 1);
+            visit(nd.nw, x, y, fn);
+            visit(nd.ne, x + half, y, fn);
+            visit(nd.sw, x, y + half, fn);
+            visit(nd.se, x + half, y + half, fn);
+        }
+
+        LifeRule rule_{};
+        LifeRuleMasks masks_;
+        std::size_t maxNodes_ = 0;
+        std::vector<Node> nodes_{};
+        std::unordered_map<Quad, NodeId, QuadHash> unique_{};
+        std::unordered_map<std::uint64_t, NodeId> results_{};
+        std::vector<NodeId> empties_{};
+        NodeId root_ = 0;
+        std::uint64_t generation_ = 0;
+    };
+
+} // namespace almondnamespace::cellular
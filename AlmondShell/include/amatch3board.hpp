@@ -0,0 +1,310 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // amatch3board.hpp
+#pragma once
+
+#include "agamesim.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+
+namespace almondnamespace::match3
+{
+    inline constexpr int GRID_W = 8;
+    inline constexpr int GRID_H = 8;
+    inline constexpr int MAX_GEM_TYPE = 5;
+    inline constexpr int GEM_TYPES = MAX_GEM_TYPE + 1;
+
+    // Swap of `cell` (y * GRID_W + x) with its right neighbour, or the one
+    // below when `down` is set.
+    struct Swap
+    {
+        std::uint8_t cell = 0;
+        bool down = false;
+
+        [[nodiscard]] constexpr int x() const noexcept { return cell % GRID_W; }
+        [[nodiscard]] constexpr int y() const noexcept { return cell / GRID_W; }
+        [[nodiscard]] constexpr int other() const noexcept { return cell + (down ? GRID_W : 1); }
+        [[nodiscard]] constexpr bool valid() const noexcept { return down ? y() + 1 < GRID_H : x() + 1 < GRID_W; }
+    };
+
+    // ─── Board ────────────────────────────────────────────────────
+    // One 64-bit board per gem type, bit y * 8 + x. Runs are found with
+    // shifts and ANDs, gravity compacts whole columns, and nothing here
+    // allocates, so lookahead can copy boards freely.
+    struct Board
+    {
+        std::array<std::uint64_t, GEM_TYPES> gems{};
+        std::uint32_t score = 0;
+        gamesim::SimRng rng{};
+
+        // Gem type at (x, y), or -1 for an empty cell (never seen outside
+        // a resolve).
+        [[nodiscard]] constexpr int gem(int x, int y) const noexcept
+        {
+            const std::uint64_t bit = std::uint64_t{ 1 } << (y * GRID_W + x);
+            for (int g = 0; g < GEM_TYPES; ++g)
+                if (gems[std::size_t(g)] & bit) return g;
+            return -1;
+        }
+
+        [[nodiscard]] constexpr int gem_at(int cell) const noexcept { return gem(cell % GRID_W, cell / GRID_W); }
+
+        friend constexpr bool operator==(const Board&, const Board&) = default;
+    };
+
+    namespace detail
+    {
+        static_assert(GRID_W == 8 && GRID_H == 8, "one bit per cell of a 64-bit word");
+
+        inline constexpr std::uint64_t Column0 = 0x0101010101010101ull;
+        // Cells that can start a horizontal run of three (x <= 5).
+        inline constexpr std::uint64_t RunStartH = 0x3F3F3F3F3F3F3F3Full;
+
+        // Every cell that is part of a horizontal or vertical run of 3+.
+        [[nodiscard]] constexpr std::uint64_t runs(std::uint64_t b) noexcept
+        {
+            const std::uint64_t h = b & (b >> 1) & (b >> 2) & RunStartH;
+            const std::uint64_t v = b & (b >> 8) & (b >> 16);
+            return h | (h << 1) | (h << 2) | v | (v << 8) | (v << 16);
+        }
+
+        [[nodiscard]] constexpr std::uint64_t all_runs(const Board& b) noexcept
+        {
+            std::uint64_t m = 0;
+            for (const std::uint64_t g : b.gems) m |= runs(g);
+            return m;
+        }
+
+        // Column x as a byte, bit y = row y (the multiply lands each row
+        // bit in its own slot of the top byte with no carries).
+        [[nodiscard]] constexpr std::uint32_t column(std::uint64_t b, int x) noexcept
+        {
+            return std::uint32_t((((b >> x) & Column0) * 0x0102040810204080ull) >> 56);
+        }
+
+        inline constexpr auto SpreadColumn = [] {
+            std::array<std::uint64_t, 256> t{};
+            for (std::uint32_t c = 0; c < 256; ++c)
+                for (int y = 0; y < 8; ++y)
+                    if (c & (1u << y)) t[c] |= std::uint64_t{ 1 } << (8 * y);
+            return t;
+        }();
+
+        // Packs the bits of `value` selected by `mask` into the low bits.
+        [[nodiscard]] constexpr std::uint32_t extract(std::uint32_t value, std::uint32_t mask) noexcept
+        {
+            std::uint32_t out = 0, bit = 1;
+            for (; mask; mask &= mask - 1, bit <<= 1)
+                if (value & mask & (0u - mask)) out |= bit;
+            return out;
+        }
+
+        // Removes `cleared`, lets each column fall and tops it up with
+        // fresh gems.
+        constexpr void collapse(Board& b, std::uint64_t cleared) noexcept
+        {
+            for (auto& g : b.gems) g &= ~cleared;
+            for (int x = 0; x < GRID_W; ++x)
+            {
+                const std::uint32_t gone = column(cleared, x);
+                if (!gone)
+                    continue;
+                const std::uint32_t kept = ~gone & 0xFFu;
+                const int holes = std::popcount(gone);
+                const std::uint64_t colMask = Column0 << x;
+                for (auto& g : b.gems)
+                {
+                    const std::uint32_t packed = extract(column(g, x), kept) << holes;
+                    g = (g & ~colMask) | (SpreadColumn[packed] << x);
+                }
+                for (int y = 0; y < holes; ++y)
+                    b.gems[b.rng.below(GEM_TYPES)] |= std::uint64_t{ 1 } << (y * GRID_W + x);
+            }
+        }
+
+        // Clears runs until the board is stable; returns gems cleared.
+        constexpr std::uint32_t resolve(Board& b) noexcept
+        {
+            std::uint32_t cleared = 0;
+            for (std::uint64_t m = all_runs(b); m; m = all_runs(b))
+            {
+                cleared += std::uint32_t(std::popcount(m));
+                collapse(b, m);
+            }
+            return cleared;
+        }
+
+        // `b` with the gems on the two cells of `s` exchanged.
+        [[nodiscard]] constexpr Board swapped(Board b, Swap s) noexcept
+        {
+            const std::uint64_t both = (std::uint64_t{ 1 } << s.cell) | (std::uint64_t{ 1 } << s.other());
+            for (auto& g : b.gems)
+                if (const std::uint64_t in = g & both; in && in != both)
+                    g ^= both;
+            return b;
+        }
+    }
+
+    // A swap is legal when it lines up a run (boards are kept stable, so
+    // any run after the swap goes through one of the swapped cells).
+    [[nodiscard]] constexpr bool is_legal(const Board& b, Swap s) noexcept
+    {
+        return s.valid() && detail::all_runs(detail::swapped(b, s)) != 0;
+    }
+
+    [[nodiscard]] constexpr bool has_legal_swap(const Board& b) noexcept
+    {
+        for (int cell = 0; cell < GRID_W * GRID_H; ++cell)
+            for (const bool down : { false, true })
+                if (is_legal(b, { std::uint8_t(cell), down }))
+                    return true;
+        return false;
+    }
+
+    // Exchanges the two gems of `s` without matching or cascading, the
+    // free-swap play of the interactive scene.
+    constexpr void swap_gems(Board& b, Swap s) noexcept
+    {
+        if (s.valid())
+            b = detail::swapped(b, s);
+    }
+
+    // Applies a legal swap and its cascades; returns gems cleared, or 0
+    // (board untouched) when the swap makes no run.
+    constexpr std::uint32_t apply_swap(Board& b, Swap s) noexcept
+    {
+        if (!s.valid())
+            return 0;
+        Board next = detail::swapped(b, s);
+        if (detail::all_runs(next) == 0)
+            return 0;
+        const std::uint32_t cleared = detail::resolve(next);
+        next.score += cleared;
+        b = next;
+        return cleared;
+    }
+
+    // ─── Swap enumeration ─────────────────────────────────────────
+    inline constexpr int MaxSwaps = 2 * GRID_W * GRID_H - GRID_W - GRID_H;
+
+    struct SwapOption
+    {
+        Swap swap{};
+        std::uint32_t immediate = 0;   // gems in the runs the swap itself makes
+        std::uint32_t total = 0;       // including every cascade that follows
+    };
+
+    struct SwapList
+    {
+        std::array<SwapOption, MaxSwaps> items{};
+        std::size_t count = 0;
+
+        [[nodiscard]] constexpr const SwapOption* begin() const noexcept { return items.data(); }
+        [[nodiscard]] constexpr const SwapOption* end() const noexcept { return items.data() + count; }
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return count; }
+        [[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+    };
+
+    // Every legal swap with its score. Totals replay the cascade on a copy
+    // with the board's own RNG, so they are exactly what apply_swap() will
+    // score; skip them (`cascades = false`) when only hints are needed.
+    [[nodiscard]] constexpr SwapList legal_swaps(const Board& b, bool cascades = true) noexcept
+    {
+        SwapList list{};
+        for (int cell = 0; cell < GRID_W * GRID_H; ++cell)
+            for (const bool down : { false, true })
+            {
+                const Swap s{ std::uint8_t(cell), down };
+                if (!s.valid())
+                    continue;
+                Board next = detail::swapped(b, s);
+                const std::uint64_t first = detail::all_runs(next);
+                if (!first)
+                    continue;
+                SwapOption& option = list.items[list.count++];
+                option.swap = s;
+                option.immediate = std::uint32_t(std::popcount(first));
+                option.total = cascades ? detail::resolve(next) : option.immediate;
+            }
+        return list;
+    }
+
+    // Highest-scoring swap by total, for hints and greedy play.
+    [[nodiscard]] constexpr std::optional<SwapOption> best_swap(const Board& b) noexcept
+    {
+        const SwapList list = legal_swaps(b);
+        const SwapOption* best = nullptr;
+        for (const SwapOption& option : list)
+            if (!best || option.total > best->total)
+                best = &option;
+        return best ? std::optional<SwapOption>(*best) : std::nullopt;
+    }
+
+    // Random board with no runs on it and at least one legal swap.
+    [[nodiscard]] constexpr Board make_board(std::uint64_t seed) noexcept
+    {
+        Board b{};
+        b.rng = gamesim::SimRng(seed);
+        do
+        {
+            b.gems.fill(0);
+            for (int cell = 0; cell < GRID_W * GRID_H; ++cell)
+            {
+                const std::uint64_t bit = std::uint64_t{ 1 } << cell;
+                std::size_t g = 0;
+                do
+                {
+                    b.gems[g] &= ~bit;
+                    g = b.rng.below(GEM_TYPES);
+                    b.gems[g] |= bit;
+                } while (detail::runs(b.gems[g]) & bit);
+            }
+        } while (!has_legal_swap(b));
+        return b;
+    }
+
+    // ─── Rules for gamesim ────────────────────────────────────────
+    // Action i is cell i / 2 swapped right (even) or down (odd); illegal
+    // swaps are no-ops. Reward is gems cleared, done when no swap is legal.
+    struct Rules
+    {
+        using State = Board;
+        using Action = Swap;
+
+        [[nodiscard]] Board reset(std::uint64_t seed) const { return make_board(seed); }
+
+        gamesim::StepResult step(Board& b, Swap s) const
+        {
+            const std::uint32_t cleared = apply_swap(b, s);
+            return { float(cleared), cleared != 0 && !has_legal_swap(b) };
+        }
+
+        [[nodiscard]] std::size_t action_count() const noexcept { return 2 * GRID_W * GRID_H; }
+        [[nodiscard]] Swap action(std::size_t i) const noexcept { return { std::uint8_t(i / 2), (i & 1) != 0 }; }
+    };
+
+} // namespace almondnamespace::match3
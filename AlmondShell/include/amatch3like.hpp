@@ -33,8 +33,11 @@
 #include "aatlasmanager.hpp"
 #include "aimageloader.hpp"
 #include "aspritepool.hpp"
+#include "amatch3board.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <cmath>
 #include <cstdlib>
 #include <random>
@@ -46,12 +49,8 @@
 
 namespace almondnamespace::match3
 {
-    inline constexpr int GRID_W = 8;
-    inline constexpr int GRID_H = 8;
-    inline constexpr int MAX_GEM_TYPE = 5;
-
     struct GameState {
-        gamecore::grid_t<int> grid{ gamecore::make_grid<int>(GRID_W, GRID_H, 0) };
+        Board board{};
         int selectedX = -1;
         int selectedY = -1;
     };
@@ -97,7 +96,7 @@ namespace almondnamespace::match3
         std::uniform_int_distribution<int> gemDist{ 0, MAX_GEM_TYPE };
 
         void setupSprites() {
-            const bool createdAtlas = atlasmanager::create_atlas({
+            atlasmanager::create_atlas({
                 .name = "match3_atlas",
                 .width = 512,
                 .height = 512,
@@ -108,48 +107,24 @@ namespace almondnamespace::match3
             if (!registrar)
                 throw std::runtime_error("[Match3] Missing atlas registrar");
 
-            TextureAtlas& atlas = registrar->atlas;
-            bool registeredSprite = false;
-
+            std::vector<atlasmanager::AtlasRegistrar::SpriteFile> files;
             for (int i = 0; i <= MAX_GEM_TYPE; ++i) {
                 const std::string name = "gem" + std::to_string(i);
-
-                if (auto existing = atlasmanager::registry.get(name)) {
-                    auto handle = std::get<0>(*existing);
-                    if (spritepool::is_alive(handle)) {
-                        gemHandles[i] = handle;
-                        continue;
-                    }
-                }
-
-                auto img = a_loadImage("assets/match3/" + name + ".ppm", false);
-                if (img.pixels.empty())
-                    throw std::runtime_error("[Match3] Failed to load sprite: " + name);
-
-                auto handleOpt = registrar->register_atlas_sprites_by_image(
-                    name, img.pixels, img.width, img.height, atlas);
-                if (!handleOpt || !spritepool::is_alive(*handleOpt))
-                    throw std::runtime_error("[Match3] Failed to register sprite: " + name);
-
-                gemHandles[i] = *handleOpt;
-                registeredSprite = true;
+                files.push_back({ name, "assets/match3/" + name + ".ppm" });
             }
 
-            if (registeredSprite || createdAtlas) {
-                atlas.rebuild_pixels();
-                atlasmanager::ensure_uploaded(atlas);
+            const auto handles = registrar->load_atlas_sprites(files);
+            for (size_t i = 0; i < handles.size(); ++i) {
+                if (!handles[i] || !spritepool::is_alive(*handles[i]))
+                    throw std::runtime_error("[Match3] Failed to register sprite: " + files[i].name);
+                gemHandles[i] = *handles[i];
             }
         }
 
         void resetBoard() {
-            if (state.grid.empty())
-                state.grid = gamecore::make_grid<int>(GRID_W, GRID_H, 0);
-
-            for (int y = 0; y < GRID_H; ++y) {
-                for (int x = 0; x < GRID_W; ++x) {
-                    state.grid[gamecore::idx(GRID_W, x, y)] = gemDist(rng);
-                }
-            }
+            state.board = Board{};
+            for (int cell = 0; cell < GRID_W * GRID_H; ++cell)
+                state.board.gems[std::size_t(gemDist(rng))] |= std::uint64_t{ 1 } << cell;
             state.selectedX = -1;
             state.selectedY = -1;
         }
@@ -173,9 +148,9 @@ namespace almondnamespace::match3
                     else {
                         const int manhattan = std::abs(gx - state.selectedX) + std::abs(gy - state.selectedY);
                         if (manhattan == 1) {
-                            std::swap(
-                                state.grid[gamecore::idx(GRID_W, gx, gy)],
-                                state.grid[gamecore::idx(GRID_W, state.selectedX, state.selectedY)]);
+                            const int x0 = (std::min)(gx, state.selectedX);
+                            const int y0 = (std::min)(gy, state.selectedY);
+                            swap_gems(state.board, { std::uint8_t(y0 * GRID_W + x0), gx == state.selectedX });
                             state.selectedX = -1;
                             state.selectedY = -1;
                         }
@@ -201,7 +176,7 @@ namespace almondnamespace::match3
 
             for (int y = 0; y < GRID_H; ++y) {
                 for (int x = 0; x < GRID_W; ++x) {
-                    const int type = state.grid[gamecore::idx(GRID_W, x, y)];
+                    const int type = state.board.gem(x, y);
                     if (type < 0 || type > MAX_GEM_TYPE) continue;
 
                     const auto& handle = gemHandles[type];
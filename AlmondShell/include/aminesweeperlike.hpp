@@ -130,18 +130,16 @@ namespace almondnamespace::minesweeper
                             gameOver = true;
                         }
                         else if (state.count[idx] == 0) {
-                            auto flood = [&](auto&& self, int fx, int fy) -> void {
-                                if (!gamecore::in_bounds(GRID_W, GRID_H, fx, fy))
-                                    return;
-                                const auto i = gamecore::idx(GRID_W, fx, fy);
-                                if (state.revealed[i])
-                                    return;
-                                state.revealed[i] = true;
-                                if (state.count[i] == 0)
-                                    for (auto [nx, ny] : gamecore::neighbors(GRID_W, GRID_H, fx, fy))
-                                        self(self, int(nx), int(ny));
-                            };
-                            flood(flood, gx, gy);
+                            // Open the empty region and its numbered rim.
+                            gamecore::bfs(GRID_W, GRID_H, gx, gy, floodScratch,
+                                [&](std::size_t fx, std::size_t fy, std::uint32_t) {
+                                    const auto i = gamecore::idx(GRID_W, fx, fy);
+                                    if (state.mine[i])
+                                        return false;
+                                    state.revealed[i] = true;
+                                    return state.count[i] == 0;
+                                },
+                                gamecore::Connectivity::Four);
                         }
                     }
                 }
@@ -193,7 +191,7 @@ namespace almondnamespace::minesweeper
         void setupSprites() {
             sprites.clear();
 
-            const bool createdAtlas = atlasmanager::create_atlas({
+            atlasmanager::create_atlas({
                 .name = "minesweeper_atlas",
                 .width = 512,
                 .height = 512,
@@ -203,41 +201,20 @@ namespace almondnamespace::minesweeper
             if (!registrar)
                 throw std::runtime_error("[Minesweeper] Missing atlas registrar");
 
-            TextureAtlas& atlas = registrar->atlas;
-            bool registeredSprite = false;
-
-            auto ensureSprite = [&](std::string_view id) {
-                std::string name(id);
-                if (auto existing = atlasmanager::registry.get(name)) {
-                    auto handle = std::get<0>(*existing);
-                    if (spritepool::is_alive(handle)) {
-                        sprites[name] = handle;
-                        return;
-                    }
-                }
-
-                auto img = a_loadImage("assets/minesweeperlike/" + name + ".ppm", false);
-                if (img.pixels.empty())
-                    throw std::runtime_error("[Minesweeper] Missing image " + name);
-
-                auto handleOpt = registrar->register_atlas_sprites_by_image(
-                    name, img.pixels, img.width, img.height, atlas);
-                if (!handleOpt || !spritepool::is_alive(*handleOpt))
-                    throw std::runtime_error("[Minesweeper] Failed to register sprite " + name);
-
-                sprites[name] = *handleOpt;
-                registeredSprite = true;
+            std::vector<atlasmanager::AtlasRegistrar::SpriteFile> files;
+            auto addSprite = [&](std::string name) {
+                files.push_back({ name, "assets/minesweeperlike/" + name + ".ppm" });
             };
-
             for (int i = 0; i <= 8; ++i)
-                ensureSprite(std::to_string(i));
-
-            ensureSprite("covered");
-            ensureSprite("mine");
-
-            if (createdAtlas || registeredSprite) {
-                atlas.rebuild_pixels();
-                atlasmanager::ensure_uploaded(atlas);
+                addSprite(std::to_string(i));
+            addSprite("covered");
+            addSprite("mine");
+
+            const auto handles = registrar->load_atlas_sprites(files);
+            for (size_t i = 0; i < handles.size(); ++i) {
+                if (!handles[i] || !spritepool::is_alive(*handles[i]))
+                    throw std::runtime_error("[Minesweeper] Failed to register sprite " + files[i].name);
+                sprites[files[i].name] = *handles[i];
             }
         }
 
@@ -245,6 +222,7 @@ namespace almondnamespace::minesweeper
         std::unordered_map<std::string, SpriteHandle> sprites{};
         bool gameOver = false;
         bool mouseWasDown = false;
+        gamecore::grid_scratch floodScratch{};
     };
 
     inline bool run_minesweeper(std::shared_ptr<core::Context> ctx)
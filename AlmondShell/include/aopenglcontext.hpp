@@ -161,6 +161,7 @@ namespace almondnamespace::openglcontext
         glState.uUVRegionLoc = -1;
         glState.uTransformLoc = -1;
         glState.uSamplerLoc = -1;
+        glState.uDistanceFieldLoc = -1;
 
         if (glState.vao && glIsVertexArray(glState.vao)) {
             glDeleteVertexArrays(1, &glState.vao);
@@ -312,9 +313,16 @@ namespace almondnamespace::openglcontext
         out vec4 outColor;
 
         uniform sampler2D uTexture;
+        uniform vec2 uDistanceField; // x = 1 for distance-field atlases, y = edge value (0..1)
 
         void main() {
-            outColor = texture(uTexture, vUV);
+            vec4 texel = texture(uTexture, vUV);
+            if (uDistanceField.x > 0.5) {
+                // Alpha is a distance; fwidth keeps the edge one screen pixel wide at any scale.
+                float aa = max(fwidth(texel.a), 1e-4);
+                texel.a = smoothstep(uDistanceField.y - aa, uDistanceField.y + aa, texel.a);
+            }
+            outColor = texel;
         }
     )";
 
@@ -329,6 +337,7 @@ namespace almondnamespace::openglcontext
         glState.uUVRegionLoc = glGetUniformLocation(glState.shader, "uUVRegion");
         glState.uTransformLoc = glGetUniformLocation(glState.shader, "uTransform");
         glState.uSamplerLoc = glGetUniformLocation(glState.shader, "uTexture");
+        glState.uDistanceFieldLoc = glGetUniformLocation(glState.shader, "uDistanceField");
 
         if (glState.uSamplerLoc >= 0) {
             glUseProgram(glState.shader);
@@ -892,6 +901,8 @@ namespace almondnamespace::openglcontext
             return true;
         }
 
+        opengltextures::opengl_residency().begin_frame(ctx.get());
+
         std::vector<const TextureAtlas*> atlasesToReload;
         for (auto& [atlas, gpu] : backend.gpu_atlases)
         {
@@ -95,6 +95,7 @@ namespace almondnamespace::openglstate
         GLint uUVRegionLoc = -1;
         GLint uTransformLoc = -1;
         GLint uSamplerLoc = -1;
+        GLint uDistanceFieldLoc = -1;
         GLuint vao = 0;
         GLuint vbo = 0;
         GLuint ebo = 0;
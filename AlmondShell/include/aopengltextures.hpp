@@ -39,9 +39,11 @@
 #include "aatlasmanager.hpp"
 #include "aatlastexture.hpp"
 #include "aimageloader.hpp"
+#include "aasyncimagewriter.hpp"
 #include "atexture.hpp"
 #include "aspritehandle.hpp"
 #include "acommandline.hpp"
+#include "atextureresidency.hpp"
 
 
 #include <atomic>
@@ -168,15 +170,12 @@ namespace almondnamespace::opengltextures
     }
 
     inline void dump_atlas(const TextureAtlas& atlas, int atlasIdx) {
+        // Encoding and disk I/O happen on the image-writer thread; only the
+        // pixel copy is paid here.
         std::string filename = make_dump_name(atlasIdx, atlas.name);
-        std::ofstream out(filename, std::ios::binary);
-        out << "P6\n" << atlas.width << " " << atlas.height << "\n255\n";
-        for (size_t i = 0; i < atlas.pixel_data.size(); i += 4) {
-            out.put(atlas.pixel_data[i]);
-            out.put(atlas.pixel_data[i + 1]);
-            out.put(atlas.pixel_data[i + 2]);
-        }
-        std::cerr << "[Dump] Wrote: " << filename << "\n";
+        if (imagewriter::default_writer().submit(filename, atlas.pixel_data,
+            static_cast<int>(atlas.width), static_cast<int>(atlas.height)))
+            std::cerr << "[Dump] Queued: " << filename << "\n";
     }
 
     inline void upload_atlas_to_gpu(const TextureAtlas& atlas)
@@ -228,7 +227,35 @@ namespace almondnamespace::opengltextures
 
         glBindTexture(GL_TEXTURE_2D, gpu.textureHandle);
 
+        // Same-sized texture that is only a few edits behind (e.g. a glyph
+        // the dynamic glyph cache just rasterised): send the changed rect.
+        if (gpu.width == atlas.width && gpu.height == atlas.height) {
+            if (const auto dirty = atlas.dirty_since(gpu.version)) {
+                if (!dirty->rect.empty()) {
+                    const auto& r = dirty->rect;
+                    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(atlas.width));
+                    glTexSubImage2D(GL_TEXTURE_2D, 0,
+                        static_cast<GLint>(r.x), static_cast<GLint>(r.y),
+                        static_cast<GLsizei>(r.width), static_cast<GLsizei>(r.height),
+                        GL_RGBA, GL_UNSIGNED_BYTE,
+                        atlas.pixel_data.data() + (static_cast<size_t>(r.y) * atlas.width + r.x) * 4);
+                    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+                }
+                gpu.version = dirty->version;
+                glBindTexture(GL_TEXTURE_2D, 0);
+                return;
+            }
+        }
+
         if (gpu.width != atlas.width || gpu.height != atlas.height) {
+            if (gpu.width != 0 || gpu.height != 0) {
+                // Immutable storage cannot be respecified; a grown atlas
+                // gets a fresh texture object.
+                glBindTexture(GL_TEXTURE_2D, 0);
+                glDeleteTextures(1, &gpu.textureHandle);
+                glGenTextures(1, &gpu.textureHandle);
+                glBindTexture(GL_TEXTURE_2D, gpu.textureHandle);
+            }
 #ifdef GL_ARB_texture_storage
             glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, atlas.width, atlas.height);
 #else
@@ -286,6 +313,45 @@ namespace almondnamespace::opengltextures
 
 
 
+    // Releases one atlas' texture; the next draw re-uploads it from pixel_data.
+    // Must run on a thread with the GL context current.
+    inline void evict_atlas(const TextureAtlas* atlas)
+    {
+        BackendData* oglData = nullptr;
+        {
+            std::shared_lock lock(core::g_backendsMutex);
+            auto it = core::g_backends.find(core::ContextType::OpenGL);
+            if (it != core::g_backends.end()) {
+                oglData = static_cast<BackendData*>(it->second.data.get());
+            }
+        }
+        if (!oglData)
+            return;
+
+        std::lock_guard<std::mutex> gpuLock(oglData->gpuMutex);
+        auto it = oglData->gpu_atlases.find(atlas);
+        if (it == oglData->gpu_atlases.end())
+            return;
+        if (it->second.textureHandle)
+            glDeleteTextures(1, &it->second.textureHandle);
+        oglData->gpu_atlases.erase(it);
+    }
+
+    inline residency::ResidencyManager& opengl_residency()
+    {
+        static residency::ResidencyManager manager{ "OpenGL", [](const TextureAtlas* atlas) { evict_atlas(atlas); } };
+        return manager;
+    }
+
+    inline residency::GpuCopy gpu_copy(BackendData& backend, const TextureAtlas& atlas)
+    {
+        std::lock_guard<std::mutex> gpuLock(backend.gpuMutex);
+        auto it = backend.gpu_atlases.find(&atlas);
+        if (it == backend.gpu_atlases.end() || it->second.textureHandle == 0)
+            return {};
+        return { true, it->second.version };
+    }
+
     inline void clear_gpu_atlases() noexcept {
         BackendData* oglData = nullptr;
         {
@@ -305,6 +371,7 @@ namespace almondnamespace::opengltextures
             }
             oglData->gpu_atlases.clear();
         }
+        opengl_residency().clear();
 
         s_generation.fetch_add(1, std::memory_order_relaxed);
     }
@@ -439,7 +506,9 @@ namespace almondnamespace::opengltextures
             return;
         }
 
-        ensure_uploaded(*atlas);
+        if (!opengl_residency().acquire(*atlas, gpu_copy(backend, *atlas),
+                [atlas] { ensure_uploaded(*atlas); }))
+            return; // re-upload staged for a later frame
 
         // 🔑 FIX: use backend.gpu_atlases, not global opengl_gpu_atlases
         GLuint tex = 0;
@@ -470,9 +539,11 @@ namespace almondnamespace::opengltextures
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, tex);
 
-        // disable mipmapping for pixel perfect rendering
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        // disable mipmapping for pixel perfect rendering; distance fields
+        // need bilinear filtering so the threshold lands between texels
+        const GLint filter = atlas->distance_field ? GL_LINEAR : GL_NEAREST;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
@@ -499,6 +570,10 @@ namespace almondnamespace::opengltextures
 
         if (backend.glState.uUVRegionLoc >= 0)
             glUniform4f(backend.glState.uUVRegionLoc, u0, v0, du, dv);
+        if (backend.glState.uDistanceFieldLoc >= 0)
+            glUniform2f(backend.glState.uDistanceFieldLoc,
+                atlas->distance_field ? 1.0f : 0.0f,
+                static_cast<float>(atlas->distance_field_edge) / 255.0f);
 
         // Flip Y pixel coordinate *before* normalization
         float flippedY = h - (drawY + drawHeight * 0.5f);
@@ -26,15 +26,18 @@
 
 #include "aplatformpump.hpp"
 #include "arobusttime.hpp"
+#include "afixedtimestep.hpp"
 #include "acontext.hpp"
 #include "ainput.hpp"
 #include "agamecore.hpp"
+#include "agridpath.hpp"
 #include "aatlasmanager.hpp"
 #include "aspriteregistry.hpp"
 #include "aspritepool.hpp"
 #include "ascene.hpp"
 #include "aimageloader.hpp"
 
+#include <algorithm>
 #include <deque>
 #include <optional>
 #include <iostream>
@@ -76,9 +79,26 @@ namespace almondnamespace::pacman
 
         bool pellets_remaining() const
         {
-            for (size_t i = 0; i < pellet.size(); ++i)
-                if (pellet[i]) return true;
-            return false;
+            return pellet.any();
+        }
+
+        // One step per ghost along the shared chase field; a ghost waits
+        // rather than stack onto another.
+        void move_ghosts(const gamecore::FlowField& chase)
+        {
+            for (auto& ghost : ghosts) {
+                const auto next = chase.next_step(ghost.first, ghost.second);
+                if (!next)
+                    continue;
+                const std::pair<int, int> cell{ next->x, next->y };
+                if (std::find(ghosts.begin(), ghosts.end(), cell) == ghosts.end())
+                    ghost = cell;
+            }
+        }
+
+        bool caught() const
+        {
+            return std::find(ghosts.begin(), ghosts.end(), std::pair{ px, py }) != ghosts.end();
         }
     };
 
@@ -93,6 +113,7 @@ namespace almondnamespace::pacman
             setupSprites();
             state = {};
             won = false;
+            resetChase();
         }
 
         bool frame(std::shared_ptr<core::Context> ctx, core::WindowData*) override {
@@ -122,6 +143,8 @@ namespace almondnamespace::pacman
                 }
             }
 
+            const bool caught = state.caught();
+
             ctx->clear_safe(ctx);
 
             auto& atlasVec = atlasmanager::get_atlas_vector();
@@ -150,18 +173,38 @@ namespace almondnamespace::pacman
                     ctx->draw_sprite_safe(ghostHandle, atlasSpan, gx * cw, gy * ch, cw, ch);
 
             ctx->present_safe();
-            return !won;
+            return !won && !caught;
+        }
+
+        // Ghosts advance on the fixed-step clock, so headless runs replay
+        // identically; all of them read one flow field toward the player,
+        // rebuilt only when the player moves.
+        void update(double dt) override {
+            ghostClock += dt;
+            while (ghostClock >= GhostStepSeconds) {
+                ghostClock -= GhostStepSeconds;
+                state.move_ghosts(chase.toward(walkable, { state.px, state.py }));
+            }
         }
 
         void unload() override {
             Scene::unload();
             state = {};
             won = false;
+            chase.clear();
         }
 
     private:
+        static constexpr double GhostStepSeconds = 0.18;
+
+        void resetChase() {
+            walkable = gamecore::WalkGrid::from(state.map, GRID_W, GRID_H, [](int tile) { return tile != WALL; });
+            chase.clear();
+            ghostClock = 0.0;
+        }
+
         void setupSprites() {
-            const bool createdAtlas = atlasmanager::create_atlas({
+            atlasmanager::create_atlas({
                 .name = "pacman_atlas",
                 .width = 512,
                 .height = 512,
@@ -171,39 +214,19 @@ namespace almondnamespace::pacman
             if (!registrar)
                 throw std::runtime_error("[Pacman] Failed to get atlas registrar");
 
-            TextureAtlas& atlas = registrar->atlas;
-            bool registeredAny = false;
-
-            auto ensureSprite = [&](std::string_view name, SpriteHandle& outHandle) {
-                if (auto existing = atlasmanager::registry.get(std::string(name))) {
-                    auto handle = std::get<0>(*existing);
-                    if (spritepool::is_alive(handle)) {
-                        outHandle = handle;
-                        return;
-                    }
-                }
-
-                auto img = a_loadImage("assets/pacman/" + std::string(name) + ".ppm", false);
-                if (img.pixels.empty())
-                    throw std::runtime_error("[Pacman] Failed to load image '" + std::string(name) + "'");
-
-                auto handleOpt = registrar->register_atlas_sprites_by_image(
-                    std::string(name), img.pixels, img.width, img.height, atlas);
-                if (!handleOpt || !spritepool::is_alive(*handleOpt))
-                    throw std::runtime_error("[Pacman] Failed to register sprite '" + std::string(name) + "'");
-
-                outHandle = *handleOpt;
-                registeredAny = true;
+            const atlasmanager::AtlasRegistrar::SpriteFile files[] = {
+                { "pacman", "assets/pacman/pacman.ppm" },
+                { "ghost", "assets/pacman/ghost.ppm" },
+                { "pellet", "assets/pacman/pellet.ppm" },
+                { "wall", "assets/pacman/wall.ppm" },
             };
+            SpriteHandle* targets[] = { &pacmanHandle, &ghostHandle, &pelletHandle, &wallHandle };
 
-            ensureSprite("pacman", pacmanHandle);
-            ensureSprite("ghost", ghostHandle);
-            ensureSprite("pellet", pelletHandle);
-            ensureSprite("wall", wallHandle);
-
-            if (createdAtlas || registeredAny) {
-                atlas.rebuild_pixels();
-                atlasmanager::ensure_uploaded(atlas);
+            const auto handles = registrar->load_atlas_sprites(files);
+            for (size_t i = 0; i < handles.size(); ++i) {
+                if (!handles[i] || !spritepool::is_alive(*handles[i]))
+                    throw std::runtime_error("[Pacman] Failed to register sprite '" + files[i].name + "'");
+                *targets[i] = *handles[i];
             }
         }
 
@@ -213,6 +236,9 @@ namespace almondnamespace::pacman
         SpriteHandle pelletHandle{};
         SpriteHandle wallHandle{};
         bool won = false;
+        gamecore::WalkGrid walkable{};
+        gamecore::FlowFieldCache chase{ 2 };
+        double ghostClock = 0.0;
     };
 
     inline bool run_pacman(std::shared_ptr<core::Context> ctx)
@@ -221,9 +247,12 @@ namespace almondnamespace::pacman
         scene.load();
 
         auto* window = ctx ? ctx->windowData : nullptr;
+        time::FixedTimestep stepper{};
         bool running = true;
-        while (running && ctx)
+        while (running && ctx) {
+            stepper.advance([&](double dt) { scene.update(dt); });
             running = scene.frame(ctx, window);
+        }
 
         scene.unload();
         return running;
@@ -894,6 +894,8 @@ namespace almondnamespace::raylibcontext
         const unsigned char g = static_cast<unsigned char>((0.5 + 0.5 * std::sin(t * 0.7 + 2.0)) * 255);
         const unsigned char b = static_cast<unsigned char>((0.5 + 0.5 * std::sin(t * 1.3 + 4.0)) * 255);
 
+        raylibtextures::raylib_residency().begin_frame(ctx.get());
+
         BeginDrawing();
         ClearBackground(Color{ r, g, b, 255 });
 
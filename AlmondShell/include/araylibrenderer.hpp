@@ -130,8 +130,10 @@ namespace almondnamespace::raylibcontext
         AtlasRegion r{};
         if (!atlas->try_get_entry_info(i, r)) return;
 
-        // Ensure GPU upload
-        almondnamespace::raylibtextures::ensure_uploaded(*atlas);
+        // Ensure GPU upload (deferred to a later frame if staging is saturated)
+        namespace rt = almondnamespace::raylibtextures;
+        if (!rt::raylib_residency().acquire(*atlas, rt::gpu_copy(*atlas), [atlas] { rt::ensure_uploaded(*atlas); }))
+            return;
         auto it = almondnamespace::raylibtextures::raylib_gpu_atlases.find(atlas);
         if (it == almondnamespace::raylibtextures::raylib_gpu_atlases.end() || it->second.texture.id == 0) return;
 
@@ -186,7 +188,10 @@ namespace almondnamespace::raylibcontext
         }
 
         Raylib_Rectangle dst{ px, py, pw, ph };
+        const Shader* sdf = atlas->distance_field ? rt::distance_field_shader(*atlas) : nullptr;
+        if (sdf) BeginShaderMode(*sdf);
         DrawTexturePro(tex, src, dst, Vector2{ 0,0 }, 0.0f, WHITE);
+        if (sdf) EndShaderMode();
     }
 
 } // namespace almondnamespace::raylibcontext
@@ -34,7 +34,9 @@
 #include "aatlasmanager.hpp"
 #include "aatlastexture.hpp"
 #include "aimageloader.hpp"
+#include "aasyncimagewriter.hpp"
 #include "atexture.hpp"
+#include "atextureresidency.hpp"
 
 #include <atomic>
 #include <filesystem>
@@ -144,17 +146,12 @@ namespace almondnamespace::raylibtextures
         return std::format("atlas_dump/{}_{}_{}.ppm", tag, atlasIdx, s_dumpSerial.fetch_add(1, std::memory_order_relaxed));
     }
 
-    inline void dump_atlas(const TextureAtlas& atlas, int atlasIdx) 
+    inline void dump_atlas(const TextureAtlas& atlas, int atlasIdx)
     {
         std::string filename = make_dump_name(atlasIdx, atlas.name);
-        std::ofstream out(filename, std::ios::binary);
-        out << "P6\n" << atlas.width << " " << atlas.height << "\n255\n";
-        for (size_t i = 0; i < atlas.pixel_data.size(); i += 4) {
-            out.put(atlas.pixel_data[i]);
-            out.put(atlas.pixel_data[i + 1]);
-            out.put(atlas.pixel_data[i + 2]);
-        }
-        std::cerr << "[Dump] Wrote: " << filename << "\n";
+        if (imagewriter::default_writer().submit(filename, atlas.pixel_data,
+            static_cast<int>(atlas.width), static_cast<int>(atlas.height)))
+            std::cerr << "[Dump] Queued: " << filename << "\n";
     }
 
     inline void upload_atlas_to_gpu(const TextureAtlas& atlas) 
@@ -170,6 +167,23 @@ namespace almondnamespace::raylibtextures
             return;
         }
 
+        // Same-sized texture that is only a few edits behind: send the
+        // changed rect instead of recreating the texture.
+        if (gpu.texture.id != 0 && gpu.width == atlas.width && gpu.height == atlas.height) {
+            if (const auto dirty = atlas.dirty_since(gpu.version)) {
+                if (!dirty->rect.empty()) {
+                    const auto& r = dirty->rect;
+                    const auto packed = pack_rect(atlas, r);
+                    UpdateTextureRec(gpu.texture,
+                        Rectangle{ static_cast<float>(r.x), static_cast<float>(r.y),
+                                   static_cast<float>(r.width), static_cast<float>(r.height) },
+                        packed.data());
+                }
+                gpu.version = dirty->version;
+                return;
+            }
+        }
+
         if (gpu.texture.id != 0) {
             UnloadTexture(gpu.texture);
         }
@@ -182,6 +196,8 @@ namespace almondnamespace::raylibtextures
         img.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
 
         gpu.texture = LoadTextureFromImage(img);
+        if (atlas.distance_field)
+            SetTextureFilter(gpu.texture, TEXTURE_FILTER_BILINEAR);
         gpu.version = atlas.version;
         gpu.width = atlas.width;
         gpu.height = atlas.height;
@@ -191,6 +207,30 @@ namespace almondnamespace::raylibtextures
         std::cerr << "[Raylib] Uploaded atlas '" << atlas.name << "' (tex id " << gpu.texture.id << ")\n";
     }
 
+    inline void evict_atlas(const TextureAtlas* atlas)
+    {
+        auto it = raylib_gpu_atlases.find(atlas);
+        if (it == raylib_gpu_atlases.end())
+            return;
+        if (it->second.texture.id != 0)
+            UnloadTexture(it->second.texture);
+        raylib_gpu_atlases.erase(it);
+    }
+
+    inline residency::ResidencyManager& raylib_residency()
+    {
+        static residency::ResidencyManager manager{ "Raylib", [](const TextureAtlas* atlas) { evict_atlas(atlas); } };
+        return manager;
+    }
+
+    inline residency::GpuCopy gpu_copy(const TextureAtlas& atlas)
+    {
+        auto it = raylib_gpu_atlases.find(&atlas);
+        if (it == raylib_gpu_atlases.end() || it->second.texture.id == 0)
+            return {};
+        return { true, it->second.version };
+    }
+
     inline void ensure_uploaded(const TextureAtlas& atlas) {
         auto it = raylib_gpu_atlases.find(&atlas);
         if (it != raylib_gpu_atlases.end()) {
@@ -200,13 +240,63 @@ namespace almondnamespace::raylibtextures
         upload_atlas_to_gpu(atlas);
     }
 
+    // ─── Distance-field shader ─────────────────────────────────────
+    // Alpha in a distance-field atlas is a distance, not coverage; this
+    // thresholds it at the atlas edge with a one-pixel fwidth ramp, as the
+    // OpenGL quad shader does. Built on first use.
+    inline Shader raylib_sdf_shader{};
+    inline int raylib_sdf_edge_loc = -1;
+    inline bool raylib_sdf_shader_tried = false;
+
+    inline constexpr const char* RaylibSdfFragment = R"(
+        #version 330
+        in vec2 fragTexCoord;
+        in vec4 fragColor;
+        uniform sampler2D texture0;
+        uniform vec4 colDiffuse;
+        uniform float edge;
+        out vec4 finalColor;
+
+        void main() {
+            vec4 texel = texture(texture0, fragTexCoord);
+            float aa = max(fwidth(texel.a), 1e-4);
+            texel.a = smoothstep(edge - aa, edge + aa, texel.a);
+            finalColor = texel * colDiffuse * fragColor;
+        }
+    )";
+
+    // Null when the shader failed to build; callers then draw the raw field.
+    inline const Shader* distance_field_shader(const TextureAtlas& atlas)
+    {
+        if (!raylib_sdf_shader_tried) {
+            raylib_sdf_shader_tried = true;
+            raylib_sdf_shader = LoadShaderFromMemory(nullptr, RaylibSdfFragment);
+            // A failed build hands back raylib's default shader, which has no `edge`.
+            raylib_sdf_edge_loc = GetShaderLocation(raylib_sdf_shader, "edge");
+            if (raylib_sdf_edge_loc < 0)
+                std::cerr << "[Raylib] Distance-field shader unavailable; SDF text draws unthresholded\n";
+        }
+        if (raylib_sdf_edge_loc < 0)
+            return nullptr;
+        const float edge = static_cast<float>(atlas.distance_field_edge) / 255.0f;
+        SetShaderValue(raylib_sdf_shader, raylib_sdf_edge_loc, &edge, SHADER_UNIFORM_FLOAT);
+        return &raylib_sdf_shader;
+    }
+
     inline void clear_gpu_atlases() noexcept {
+        if (raylib_sdf_shader_tried) {
+            UnloadShader(raylib_sdf_shader);   // leaves raylib's default shader alone
+            raylib_sdf_shader = {};
+            raylib_sdf_edge_loc = -1;
+            raylib_sdf_shader_tried = false;
+        }
         for (auto& [_, gpu] : raylib_gpu_atlases) {
             if (gpu.texture.id != 0) {
                 UnloadTexture(gpu.texture);
             }
         }
         raylib_gpu_atlases.clear();
+        raylib_residency().clear();
         s_generation.fetch_add(1, std::memory_order_relaxed);
     }
 
@@ -23,6 +23,7 @@
  **************************************************************/
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <unordered_map>
 #include <string>
@@ -33,9 +34,35 @@ namespace almondnamespace::time
 
     using Clock = std::chrono::steady_clock;
 
+    //── Manual clock (deterministic runs) ───────────────────────//
+    // Headless benchmarks and image-diff runs drive time by hand so every
+    // Timer observes the same fixed-step sequence regardless of host speed.
+    inline std::atomic<bool> manualClockEnabled{ false };
+    inline std::atomic<Clock::rep> manualClockTicks{ 0 };
+
+    inline Clock::time_point now() noexcept
+    {
+        if (manualClockEnabled.load(std::memory_order_acquire))
+            return Clock::time_point{ Clock::duration{ manualClockTicks.load(std::memory_order_acquire) } };
+        return Clock::now();
+    }
+
+    inline void enableManualClock(bool enabled) noexcept
+    {
+        if (enabled)
+            manualClockTicks.store(Clock::now().time_since_epoch().count(), std::memory_order_release);
+        manualClockEnabled.store(enabled, std::memory_order_release);
+    }
+
+    inline void advanceManualClock(double seconds) noexcept
+    {
+        const auto step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        manualClockTicks.fetch_add(step.count(), std::memory_order_acq_rel);
+    }
+
     struct Timer 
     {
-        Clock::time_point baseStart{ Clock::now() };
+        Clock::time_point baseStart{ now() };
         double accumulatedTime = 0.0;
         double timeScale = 1.0;
         bool paused = false;
@@ -54,15 +81,15 @@ namespace almondnamespace::time
     inline double elapsed(const Timer& t) 
     {
         if (t.paused) return t.accumulatedTime;
-        auto now = Clock::now();
-        auto realElapsed = std::chrono::duration<double>(now - t.baseStart).count();
+        auto current = now();
+        auto realElapsed = std::chrono::duration<double>(current - t.baseStart).count();
         return t.accumulatedTime + (realElapsed * t.timeScale) + t.manualElapsed;
     }
 
     inline double realElapsed(const Timer& t) 
     {
         if (t.paused) return t.accumulatedTime / t.timeScale;
-        return std::chrono::duration<double>(Clock::now() - t.baseStart).count();
+        return std::chrono::duration<double>(now() - t.baseStart).count();
     }
 
     inline void pause(Timer& t) 
@@ -76,14 +103,14 @@ namespace almondnamespace::time
     inline void resume(Timer& t) 
     {
         if (t.paused) {
-            t.baseStart = Clock::now();
+            t.baseStart = now();
             t.paused = false;
         }
     }
 
     inline void reset(Timer& t) 
     {
-        t.baseStart = Clock::now();
+        t.baseStart = now();
         t.accumulatedTime = 0.0;
         t.manualElapsed = 0.0;
         t.paused = false;
@@ -98,7 +125,7 @@ namespace almondnamespace::time
     {
         auto unscaled = elapsed(t);
         t.timeScale = newScale;
-        t.baseStart = Clock::now();
+        t.baseStart = now();
         t.accumulatedTime = unscaled;
         t.manualElapsed = 0.0;
     }
@@ -29,22 +29,26 @@
 #include "ainput.hpp"
 #include "aplatformpump.hpp"
 #include "arobusttime.hpp"
+#include "afixedtimestep.hpp"
 #include "aatlasmanager.hpp"
 #include "aspritepool.hpp"
 #include "ascene.hpp"
 #include "aimageloader.hpp" // For a_loadImage
+#include "asandworld.hpp"
+#include "agridtexture.hpp"
 
+#include <array>
 #include <chrono>
 #include <span>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 
 namespace almondnamespace::sandsim
 {
     static SpriteRegistry registry;
 
     constexpr int W = 120, H = 80;
-    constexpr double STEP_S = 0.016;
 
     struct SandSimScene : public scene::Scene {
         SandSimScene(Logger* L = nullptr, time::Timer* C = nullptr)
@@ -55,10 +59,15 @@ namespace almondnamespace::sandsim
         void load() override {
             Scene::load();
             setupSprites();
-            grid = gamecore::make_grid<bool>(W, H, false);
-            timer = time::createTimer(0.25);
-            time::setScale(timer, 0.25);
-            acc = 0.0;
+            world.resize(W, H);
+            if (!board.resize(W, H))
+                std::cerr << "[SandSim] Board texture unavailable, drawing per-cell sprites\n";
+        }
+
+        // Driven by the engine's FixedTimestep; frame() only handles input
+        // and drawing, so mirrored contexts no longer step the grid again.
+        void update(double) override {
+            stepSimulation();
         }
 
         bool frame(std::shared_ptr<core::Context> ctx, core::WindowData*) override {
@@ -82,37 +91,33 @@ namespace almondnamespace::sandsim
             gx = std::clamp(gx, 0, W - 1);
             gy = std::clamp(gy, 0, H - 1);
 
+            constexpr std::array<std::pair<input::Key, Material>, 6> brushes{ {
+                { input::Key::Num1, Material::Sand }, { input::Key::Num2, Material::Water },
+                { input::Key::Num3, Material::Stone }, { input::Key::Num4, Material::Wood },
+                { input::Key::Num5, Material::Fire }, { input::Key::Num6, Material::Empty } } };
+            for (const auto& [key, material] : brushes)
+                if (ctx->is_key_down_safe(key)) brush = material;
+
             if (ctx->is_mouse_button_down_safe(input::MouseButton::MouseLeft) &&
                 gamecore::in_bounds(W, H, gx, gy)) {
-                gamecore::at(grid, W, H, gx, gy) = true;
-            }
-
-            advance(timer, STEP_S);
-            acc += time::elapsed(timer);
-            reset(timer);
-
-            while (acc >= STEP_S) {
-                acc -= STEP_S;
-                stepSimulation();
+                world.paint(gx, gy, brush == Material::Sand ? 0 : 1, brush, brush == Material::Empty);
             }
 
             ctx->clear_safe(ctx);
             auto& atlasVec = atlasmanager::get_atlas_vector();
             std::span<const TextureAtlas* const> atlasSpan(atlasVec.data(), atlasVec.size());
 
-            const float cw = float(ctx->get_width_safe()) / W;
-            const float ch = float(ctx->get_height_safe()) / H;
-
-            if (!spritepool::is_alive(sandHandle))
-                return true;
-
-            for (int y = 0; y < H; ++y) {
-                for (int x = 0; x < W; ++x) {
-                    if (gamecore::at(grid, W, H, x, y)) {
-                        ctx->draw_sprite_safe(sandHandle, atlasSpan,
-                            x * cw, y * ch, cw, ch);
-                    }
-                }
+            // One texel per cell drawn as a single quad; the per-cell
+            // sprite path remains for when the texture is unavailable.
+            const auto cells = world.cells();
+            const float boardW = float(ctx->get_width_safe());
+            const float boardH = float(ctx->get_height_safe());
+            if (board.ready() && board.update_indexed(cells, std::span<const std::uint32_t>(palette))) {
+                board.draw(*ctx, atlasSpan, 0.0f, 0.0f, boardW, boardH);
+            }
+            else {
+                gamecore::draw_tiles(*ctx, atlasSpan, cells, W, H,
+                    std::span<const SpriteHandle>(materialHandles), 0.0f, 0.0f, boardW, boardH);
             }
 
             ctx->present_safe();
@@ -121,8 +126,7 @@ namespace almondnamespace::sandsim
 
         void unload() override {
             Scene::unload();
-            grid.clear();
-            acc = 0.0;
+            world = {};
         }
 
     private:
@@ -160,6 +164,35 @@ namespace almondnamespace::sandsim
                 sandHandle = *handleOpt;
                 registered = true;
             }
+            materialHandles[static_cast<std::size_t>(Material::Sand)] = sandHandle;
+
+            // The other materials are flat colours generated here.
+            struct Swatch { Material material; const char* name; std::uint8_t r, g, b; };
+            constexpr Swatch swatches[] = {
+                { Material::Water, "sand_water", 40, 110, 220 },
+                { Material::Stone, "sand_stone", 120, 120, 128 },
+                { Material::Wood, "sand_wood", 110, 70, 35 },
+                { Material::Fire, "sand_fire", 250, 120, 20 },
+                { Material::Smoke, "sand_smoke", 70, 70, 70 },
+            };
+            for (const auto& swatch : swatches) {
+                SpriteHandle& handle = materialHandles[static_cast<std::size_t>(swatch.material)];
+                if (auto existing = atlasmanager::registry.get(swatch.name)) {
+                    handle = std::get<0>(*existing);
+                    if (spritepool::is_alive(handle)) continue;
+                }
+                std::vector<u8> pixels(4 * 4 * 4);
+                for (std::size_t i = 0; i < pixels.size(); i += 4) {
+                    pixels[i] = swatch.r; pixels[i + 1] = swatch.g; pixels[i + 2] = swatch.b; pixels[i + 3] = 255;
+                }
+                if (auto handleOpt = registrar->register_atlas_sprites_by_image(swatch.name, pixels, 4, 4, atlas)) {
+                    handle = *handleOpt;
+                    registered = true;
+                }
+                else {
+                    std::cerr << "[SandSim] Failed to register " << swatch.name << " sprite\n";
+                }
+            }
 
             if (createdAtlas || registered) {
                 atlas.rebuild_pixels();
@@ -168,32 +201,24 @@ namespace almondnamespace::sandsim
         }
 
         void stepSimulation() {
-            auto next = grid;
-            for (int y = H - 1; y >= 0; --y) {
-                for (int x = 0; x < W; ++x) {
-                    if (gamecore::at(grid, W, H, x, y)) {
-                        if (gamecore::is_free(grid, W, H, x, y + 1, false)) {
-                            gamecore::at(next, W, H, x, y + 1) = true;
-                            gamecore::at(next, W, H, x, y) = false;
-                        }
-                        else if (gamecore::is_free(grid, W, H, x - 1, y + 1, false)) {
-                            gamecore::at(next, W, H, x - 1, y + 1) = true;
-                            gamecore::at(next, W, H, x, y) = false;
-                        }
-                        else if (gamecore::is_free(grid, W, H, x + 1, y + 1, false)) {
-                            gamecore::at(next, W, H, x + 1, y + 1) = true;
-                            gamecore::at(next, W, H, x, y) = false;
-                        }
-                    }
-                }
-            }
-            grid = std::move(next);
+            world.step();
         }
 
-        gamecore::grid_t<bool> grid{};
+        SandWorld world{};
+        Material brush = Material::Sand;
+        std::array<SpriteHandle, static_cast<std::size_t>(Material::Count)> materialHandles{};
         SpriteHandle sandHandle{};
-        time::Timer timer{};
-        double acc = 0.0;
+        gamecore::GridTexture board{};
+
+        static constexpr std::array<std::uint32_t, static_cast<std::size_t>(Material::Count)> palette{
+            0u,
+            gamecore::rgba(194, 178, 128),
+            gamecore::rgba(40, 110, 220),
+            gamecore::rgba(120, 120, 128),
+            gamecore::rgba(110, 70, 35),
+            gamecore::rgba(250, 120, 20),
+            gamecore::rgba(70, 70, 70),
+        };
     };
 
     inline bool run_sand(std::shared_ptr<core::Context> ctx)
@@ -202,9 +227,12 @@ namespace almondnamespace::sandsim
         scene.load();
 
         auto* window = ctx ? ctx->windowData : nullptr;
+        time::FixedTimestep stepper{};
         bool running = true;
-        while (running && ctx)
+        while (running && ctx) {
+            stepper.advance([&](double dt) { scene.update(dt); });
             running = scene.frame(ctx, window);
+        }
 
         scene.unload();
         return running;
@@ -0,0 +1,312 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // asandworld.hpp
+#pragma once
+
+#include "aenginesystems.hpp"   // scheduler_parallel_for
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace almondnamespace::sandsim
+{
+    enum class Material : std::uint8_t
+    {
+        Empty,
+        Sand,
+        Water,
+        Stone,
+        Wood,
+        Fire,
+        Smoke,
+        Count
+    };
+
+    // ─── Falling-sand world ─────────────────────────────────────────
+    // One material byte per cell, updated in place. Rows are scanned bottom
+    // to top with the horizontal direction alternating per row and tick, and
+    // a per-cell stamp stops a particle from moving twice in one tick.
+    //
+    // The grid is split into 32×32 chunks. Only chunks that changed last
+    // tick (or border one that did) are scanned, so settled regions cost
+    // nothing. Chunks are updated in four checkerboard phases: chunks of
+    // one phase are two chunks apart and a particle moves at most
+    // `MaxReach` cells, so a phase can run on the worker pool without two
+    // jobs touching the same cell.
+    class SandWorld
+    {
+    public:
+        static constexpr int ChunkSize = 32;
+        static constexpr int MaxReach = 4;               // lateral liquid spread per tick
+        static constexpr std::size_t ParallelChunks = 8;  // per phase; fewer run inline
+
+        static_assert(MaxReach < ChunkSize / 2, "phase chunks must not reach the same cell");
+
+        SandWorld() = default;
+        SandWorld(int width, int height) { resize(width, height); }
+
+        void resize(int width, int height)
+        {
+            width_ = (std::max)(1, width);
+            height_ = (std::max)(1, height);
+            chunksX_ = (width_ + ChunkSize - 1) / ChunkSize;
+            chunksY_ = (height_ + ChunkSize - 1) / ChunkSize;
+            const std::size_t cells = static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_);
+            cells_.assign(cells, Material::Empty);
+            stamps_.assign(cells, 0);
+            const std::size_t chunks = static_cast<std::size_t>(chunksX_) * static_cast<std::size_t>(chunksY_);
+            dirty_.assign(chunks, 0);
+            nextDirty_ = std::make_unique<std::atomic<std::uint8_t>[]>(chunks);
+            tick_ = 0;
+        }
+
+        [[nodiscard]] int width() const noexcept { return width_; }
+        [[nodiscard]] int height() const noexcept { return height_; }
+        [[nodiscard]] std::uint64_t tick() const noexcept { return tick_; }
+        [[nodiscard]] std::size_t active_chunks() const noexcept { return activeChunks_; }
+        [[nodiscard]] std::span<const Material> cells() const noexcept { return cells_; }
+
+        [[nodiscard]] Material get(int x, int y) const noexcept
+        {
+            return in_bounds(x, y) ? cells_[index(x, y)] : Material::Stone;
+        }
+
+        void set(int x, int y, Material m) noexcept
+        {
+            if (!in_bounds(x, y) || cells_[index(x, y)] == m) return;
+            cells_[index(x, y)] = m;
+            mark_changed(x, y);
+        }
+
+        // Fills a disc; only empty cells are overwritten unless `replace`.
+        void paint(int cx, int cy, int radius, Material m, bool replace = false) noexcept
+        {
+            for (int y = cy - radius; y <= cy + radius; ++y)
+                for (int x = cx - radius; x <= cx + radius; ++x)
+                    if ((x - cx) * (x - cx) + (y - cy) * (y - cy) <= radius * radius
+                        && (replace || get(x, y) == Material::Empty))
+                        set(x, y, m);
+        }
+
+        void step(bool parallel = true)
+        {
+            ++tick_;
+            stamp_ = static_cast<std::uint16_t>(tick_ & 0xFFFF);
+            if (stamp_ == 0) {
+                // Wrapped: forget old stamps so none matches by accident.
+                std::fill(stamps_.begin(), stamps_.end(), std::uint16_t{ 0 });
+                stamp_ = 1;
+            }
+
+            const std::size_t chunks = dirty_.size();
+            activeChunks_ = 0;
+            for (std::size_t i = 0; i < chunks; ++i) {
+                dirty_[i] = nextDirty_[i].exchange(0, std::memory_order_relaxed);
+                activeChunks_ += dirty_[i];
+            }
+            if (activeChunks_ == 0)
+                return;
+
+            for (int phase = 0; phase < 4; ++phase) {
+                phaseChunks_.clear();
+                for (int cy = phase >> 1; cy < chunksY_; cy += 2)
+                    for (int cx = phase & 1; cx < chunksX_; cx += 2)
+                        if (dirty_[static_cast<std::size_t>(cy) * chunksX_ + cx])
+                            phaseChunks_.push_back(cy * chunksX_ + cx);
+
+                if (parallel && phaseChunks_.size() >= ParallelChunks) {
+                    scheduler_parallel_for(phaseChunks_.size(), [this](std::size_t i) { update_chunk(phaseChunks_[i]); });
+                }
+                else {
+                    for (int chunk : phaseChunks_) update_chunk(chunk);
+                }
+            }
+        }
+
+    private:
+        [[nodiscard]] bool in_bounds(int x, int y) const noexcept { return x >= 0 && y >= 0 && x < width_ && y < height_; }
+        [[nodiscard]] std::size_t index(int x, int y) const noexcept
+        {
+            return static_cast<std::size_t>(y) * static_cast<std::size_t>(width_) + static_cast<std::size_t>(x);
+        }
+
+        // Deterministic per-cell noise, so results do not depend on which
+        // worker ran a chunk.
+        [[nodiscard]] std::uint32_t noise(int x, int y) const noexcept
+        {
+            std::uint64_t h = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) ^ static_cast<std::uint32_t>(y);
+            h ^= tick_ * 0x9E3779B97F4A7C15ull;
+            h ^= h >> 33; h *= 0xFF51AFD7ED558CCDull;
+            h ^= h >> 33; h *= 0xC4CEB9FE1A85EC53ull;
+            return static_cast<std::uint32_t>(h ^ (h >> 33));
+        }
+
+        // A change can unblock any neighbour, so the chunks of all eight
+        // neighbours are scanned next tick.
+        void mark_changed(int x, int y) noexcept
+        {
+            const int cx0 = (std::max)(0, x - 1) / ChunkSize, cx1 = (std::min)(width_ - 1, x + 1) / ChunkSize;
+            const int cy0 = (std::max)(0, y - 1) / ChunkSize, cy1 = (std::min)(height_ - 1, y + 1) / ChunkSize;
+            for (int cy = cy0; cy <= cy1; ++cy)
+                for (int cx = cx0; cx <= cx1; ++cx)
+                    nextDirty_[static_cast<std::size_t>(cy) * chunksX_ + cx].store(1, std::memory_order_relaxed);
+        }
+
+        void move(int x, int y, int tx, int ty) noexcept
+        {
+            const std::size_t a = index(x, y), b = index(tx, ty);
+            std::swap(cells_[a], cells_[b]);
+            stamps_[a] = stamps_[b] = stamp_;
+            mark_changed(x, y);
+            mark_changed(tx, ty);
+        }
+
+        void transform(int x, int y, Material m) noexcept
+        {
+            const std::size_t i = index(x, y);
+            cells_[i] = m;
+            stamps_[i] = stamp_;
+            mark_changed(x, y);
+        }
+
+        // Powders and liquids fall into empty cells and displace gas;
+        // sand also sinks through water.
+        [[nodiscard]] bool can_enter(Material mover, int x, int y) const noexcept
+        {
+            if (!in_bounds(x, y)) return false;
+            const Material m = cells_[index(x, y)];
+            if (m == Material::Empty || m == Material::Smoke) return true;
+            return mover == Material::Sand && m == Material::Water;
+        }
+
+        void update_chunk(int chunk) noexcept
+        {
+            const int cx = chunk % chunksX_, cy = chunk / chunksX_;
+            const int x0 = cx * ChunkSize, x1 = (std::min)(width_, x0 + ChunkSize);
+            const int y0 = cy * ChunkSize, y1 = (std::min)(height_, y0 + ChunkSize);
+
+            for (int y = y1 - 1; y >= y0; --y) {
+                const bool leftToRight = ((tick_ + static_cast<std::uint64_t>(y)) & 1u) != 0;
+                for (int i = 0; i < x1 - x0; ++i) {
+                    const int x = leftToRight ? x0 + i : x1 - 1 - i;
+                    const std::size_t idx = index(x, y);
+                    if (stamps_[idx] == stamp_) continue;
+                    switch (cells_[idx]) {
+                    case Material::Sand:  update_powder(x, y); break;
+                    case Material::Water: update_liquid(x, y); break;
+                    case Material::Fire:  update_fire(x, y); break;
+                    case Material::Smoke: update_gas(x, y); break;
+                    default: break;
+                    }
+                }
+            }
+        }
+
+        bool fall(Material m, int x, int y) noexcept
+        {
+            if (can_enter(m, x, y + 1)) { move(x, y, x, y + 1); return true; }
+            const int first = (noise(x, y) & 1u) ? 1 : -1;
+            if (can_enter(m, x + first, y + 1)) { move(x, y, x + first, y + 1); return true; }
+            if (can_enter(m, x - first, y + 1)) { move(x, y, x - first, y + 1); return true; }
+            return false;
+        }
+
+        void update_powder(int x, int y) noexcept { fall(Material::Sand, x, y); }
+
+        void update_liquid(int x, int y) noexcept
+        {
+            if (fall(Material::Water, x, y))
+                return;
+            // Spread sideways up to MaxReach cells, stopping at obstacles.
+            const int dir = (noise(x, y) & 2u) ? 1 : -1;
+            for (int pass = 0; pass < 2; ++pass) {
+                const int d = pass ? -dir : dir;
+                int target = x;
+                for (int step = 1; step <= MaxReach && can_enter(Material::Water, x + d * step, y); ++step)
+                    target = x + d * step;
+                if (target != x) { move(x, y, target, y); return; }
+            }
+        }
+
+        void update_gas(int x, int y) noexcept
+        {
+            const std::uint32_t n = noise(x, y);
+            if ((n & 63u) == 0) { transform(x, y, Material::Empty); return; }
+            const int side = (n & 64u) ? 1 : -1;
+            const int moves[4][2] = { { 0, -1 }, { side, -1 }, { -side, -1 }, { side, 0 } };
+            for (const auto& mv : moves) {
+                const int tx = x + mv[0], ty = y + mv[1];
+                if (in_bounds(tx, ty) && cells_[index(tx, ty)] == Material::Empty) {
+                    move(x, y, tx, ty);
+                    return;
+                }
+            }
+            mark_changed(x, y); // drifting gas keeps its chunk awake until it fades
+        }
+
+        void update_fire(int x, int y) noexcept
+        {
+            const std::uint32_t n = noise(x, y);
+            const int around[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+            for (const auto& o : around) {
+                const int tx = x + o[0], ty = y + o[1];
+                if (!in_bounds(tx, ty)) continue;
+                const Material m = cells_[index(tx, ty)];
+                if (m == Material::Water) { transform(x, y, Material::Smoke); return; }
+                if (m == Material::Wood && ((n >> 8) & 7u) == 0) transform(tx, ty, Material::Fire);
+            }
+            if ((n & 15u) == 0) { transform(x, y, Material::Smoke); return; }
+            if (above_is_empty(x, y) && ((n >> 4) & 3u) == 0) {
+                transform(x, y - 1, Material::Smoke);
+                return;
+            }
+            mark_changed(x, y); // burning cells stay active
+        }
+
+        [[nodiscard]] bool above_is_empty(int x, int y) const noexcept
+        {
+            return in_bounds(x, y - 1) && cells_[index(x, y - 1)] == Material::Empty;
+        }
+
+        int width_ = 0;
+        int height_ = 0;
+        int chunksX_ = 0;
+        int chunksY_ = 0;
+        std::vector<Material> cells_{};
+        std::vector<std::uint16_t> stamps_{};    // tick stamp of the last move into/out of a cell
+        std::vector<std::uint8_t> dirty_{};      // chunks scanned this tick
+        std::unique_ptr<std::atomic<std::uint8_t>[]> nextDirty_{};
+        std::vector<int> phaseChunks_{};
+        std::size_t activeChunks_ = 0;
+        std::uint64_t tick_ = 0;
+        std::uint16_t stamp_ = 0;
+    };
+
+} // namespace almondnamespace::sandsim
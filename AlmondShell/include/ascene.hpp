@@ -78,6 +78,15 @@ namespace almondnamespace::scene
             return true; // default: no-op
         }
 
+        // Fixed-step simulation hook. The engine's FixedTimestep calls this at
+        // the configured tick rate, independently of how often frame() runs.
+        virtual void update(double /*dt*/) {}
+
+        // Fraction of a tick elapsed since the last update(); frame() may use
+        // it to interpolate between the previous and current simulation state.
+        void setInterpolationAlpha(double alpha) noexcept { interpolationAlpha = alpha; }
+        double getInterpolationAlpha() const noexcept { return interpolationAlpha; }
+
         // Entity management
         ecs::Entity createEntity() {
             ecs::Entity e = ecs::create_entity(reg);
@@ -131,6 +140,7 @@ namespace almondnamespace::scene
         Logger* logger = nullptr;       // optional shared logger
         time::Timer* clock = nullptr;   // optional time reference
         LogLevel sceneLogLevel;         // per-scene verbosity threshold
+        double interpolationAlpha = 0.0;
     };
 
 } // namespace almondnamespace
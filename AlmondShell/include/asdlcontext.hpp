@@ -365,6 +365,7 @@ namespace almondnamespace::sdlcontext
         }
 
         atlasmanager::process_pending_uploads(core::ContextType::SDL);
+        sdltextures::sdl_residency().begin_frame(ctx.get());
 
         SDL_Event e;
         const bool* keys = SDL_GetKeyboardState(nullptr);
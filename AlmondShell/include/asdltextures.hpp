@@ -32,8 +32,10 @@
 #include "aatlasmanager.hpp"
 #include "aatlastexture.hpp"
 #include "aimageloader.hpp"
+#include "aasyncimagewriter.hpp"
 #include "atexture.hpp"
 #include "asdlstate.hpp"
+#include "atextureresidency.hpp"
 
 #include <atomic>
 #include <filesystem>
@@ -118,24 +120,10 @@ namespace almondnamespace::sdltextures
 
     inline void dump_atlas(const TextureAtlas& atlas, int atlasIdx)
     {
-        const std::string filename = make_dump_name(atlasIdx, atlas.name);
-        std::ofstream out(filename, std::ios::binary);
-        if (!out) {
-            std::cerr << "[Dump] Failed to open: " << filename << "\n";
-            return;
-        }
-
-        // Write P6 header
-        out << "P6\n" << atlas.width << " " << atlas.height << "\n255\n";
-
-        // Dump RGB only (skip A)
-        for (size_t i = 0; i < atlas.pixel_data.size(); i += 4) {
-            out.put(static_cast<char>(atlas.pixel_data[i]));
-            out.put(static_cast<char>(atlas.pixel_data[i + 1]));
-            out.put(static_cast<char>(atlas.pixel_data[i + 2]));
-        }
-
-        std::cerr << "[Dump] Wrote: " << filename << "\n";
+        std::string filename = make_dump_name(atlasIdx, atlas.name);
+        if (imagewriter::default_writer().submit(filename, atlas.pixel_data,
+            static_cast<int>(atlas.width), static_cast<int>(atlas.height)))
+            std::cerr << "[Dump] Queued: " << filename << "\n";
     }
 
 
@@ -156,6 +144,24 @@ namespace almondnamespace::sdltextures
             return;
         }
 
+        // Same-sized RGBA texture that is only a few edits behind: send the
+        // changed rect instead of recreating the texture.
+        if (gpu.textureHandle && gpu.textureHandle->format == SDL_PIXELFORMAT_RGBA32
+            && gpu.width == atlas.width && gpu.height == atlas.height) {
+            if (const auto dirty = atlas.dirty_since(gpu.version)) {
+                if (!dirty->rect.empty()) {
+                    const auto& r = dirty->rect;
+                    const SDL_Rect dst{ static_cast<int>(r.x), static_cast<int>(r.y),
+                        static_cast<int>(r.width), static_cast<int>(r.height) };
+                    SDL_UpdateTexture(gpu.textureHandle, &dst,
+                        atlas.pixel_data.data() + (static_cast<size_t>(r.y) * atlas.width + r.x) * 4,
+                        static_cast<int>(atlas.width * 4));
+                }
+                gpu.version = dirty->version;
+                return;
+            }
+        }
+
         if (gpu.textureHandle) {
             SDL_DestroyTexture(gpu.textureHandle);
             gpu.textureHandle = nullptr;
@@ -178,6 +184,13 @@ namespace almondnamespace::sdltextures
         if (!gpu.textureHandle)
             throw std::runtime_error("[SDL] Failed: SDL_CreateTextureFromSurface");
 
+        // SDL3 textures default to linear filtering; every other backend
+        // samples plain atlases with nearest, so match that. SDL_Renderer has
+        // no per-draw shader, so distance-field atlases are drawn as-is (soft
+        // alpha); linear filtering at least keeps them smooth.
+        SDL_SetTextureScaleMode(gpu.textureHandle,
+            atlas.distance_field ? SDL_SCALEMODE_LINEAR : SDL_SCALEMODE_NEAREST);
+
         gpu.width = atlas.width;
         gpu.height = atlas.height;
         gpu.version = atlas.version;
@@ -187,6 +200,30 @@ namespace almondnamespace::sdltextures
         std::cerr << "[SDL] Uploaded atlas '" << atlas.name << "'\n";
     }
 
+    inline void evict_atlas(const TextureAtlas* atlas)
+    {
+        auto it = sdl_gpu_atlases.find(atlas);
+        if (it == sdl_gpu_atlases.end())
+            return;
+        if (it->second.textureHandle)
+            SDL_DestroyTexture(it->second.textureHandle);
+        sdl_gpu_atlases.erase(it);
+    }
+
+    inline residency::ResidencyManager& sdl_residency()
+    {
+        static residency::ResidencyManager manager{ "SDL", [](const TextureAtlas* atlas) { evict_atlas(atlas); } };
+        return manager;
+    }
+
+    inline residency::GpuCopy gpu_copy(const TextureAtlas& atlas)
+    {
+        auto it = sdl_gpu_atlases.find(&atlas);
+        if (it == sdl_gpu_atlases.end() || it->second.textureHandle == nullptr)
+            return {};
+        return { true, it->second.version };
+    }
+
     inline void ensure_uploaded(const TextureAtlas& atlas) 
     {
         auto it = sdl_gpu_atlases.find(&atlas);
@@ -231,6 +268,7 @@ namespace almondnamespace::sdltextures
             }
         }
         sdl_gpu_atlases.clear();
+        sdl_residency().clear();
         s_generation.fetch_add(1, std::memory_order_relaxed);
     }
 
@@ -274,7 +312,8 @@ namespace almondnamespace::sdltextures
 
         //std::cerr << "[SDL_DrawSprite] Using atlas: '" << atlas->name << "', sprite: '" << atlas->entries[localIdx].name << "'\n";
 
-        ensure_uploaded(*atlas); // Your SDL texture upload variant
+        if (!sdl_residency().acquire(*atlas, gpu_copy(*atlas), [atlas] { ensure_uploaded(*atlas); }))
+            return; // re-upload staged for a later frame
 
         auto it = sdl_gpu_atlases.find(atlas);
         if (it == sdl_gpu_atlases.end()) {
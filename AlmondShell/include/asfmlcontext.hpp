@@ -169,6 +169,8 @@ namespace almondnamespace::sfmlcontext
             return false;
         }
 
+        sfml_residency().begin_frame(ctx.get());
+
         if (!sfmlcontext.window->setActive(true)) {
             std::cerr << "[SFMLRender] Failed to activate SFML window\n";
             sfmlcontext.running = false;
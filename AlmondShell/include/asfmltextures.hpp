@@ -32,12 +32,16 @@
 #include "aatlasmanager.hpp"
 #include "aatlastexture.hpp"
 #include "aimageloader.hpp"
+#include "aasyncimagewriter.hpp"
 #include "atexture.hpp"
+#include "atextureresidency.hpp"
 
 #include <atomic>
 #include <filesystem>
 #include <format>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <iostream>
@@ -117,14 +121,9 @@ namespace almondnamespace::sfmlcontext
 
     inline void dump_atlas(const TextureAtlas& atlas, int atlasIdx) {
         std::string filename = make_dump_name(atlasIdx, atlas.name);
-        std::ofstream out(filename, std::ios::binary);
-        out << "P6\n" << atlas.width << " " << atlas.height << "\n255\n";
-        for (size_t i = 0; i < atlas.pixel_data.size(); i += 4) {
-            out.put(atlas.pixel_data[i]);
-            out.put(atlas.pixel_data[i + 1]);
-            out.put(atlas.pixel_data[i + 2]);
-        }
-        std::cerr << "[Dump] Wrote: " << filename << "\n";
+        if (imagewriter::default_writer().submit(filename, atlas.pixel_data,
+            static_cast<int>(atlas.width), static_cast<int>(atlas.height)))
+            std::cerr << "[Dump] Queued: " << filename << "\n";
     }
 
     inline void upload_atlas_to_gpu(const TextureAtlas& atlas) {
@@ -140,12 +139,27 @@ namespace almondnamespace::sfmlcontext
             return;
         }
 
+        // Same-sized texture that is only a few edits behind: send the
+        // changed rect instead of reloading the whole image.
+        if (gpu.texture.getSize().x > 0 && gpu.width == atlas.width && gpu.height == atlas.height) {
+            if (const auto dirty = atlas.dirty_since(gpu.version)) {
+                if (!dirty->rect.empty()) {
+                    const auto& r = dirty->rect;
+                    const auto packed = pack_rect(atlas, r);
+                    gpu.texture.update(packed.data(), { r.width, r.height }, { r.x, r.y });
+                }
+                gpu.version = dirty->version;
+                return;
+            }
+        }
+
         sf::Image image({ atlas.width, atlas.height }, atlas.pixel_data.data());
 
         if (!gpu.texture.loadFromImage(image)) {
             throw std::runtime_error("[SFML] Failed to load GPU texture from pixel_data for atlas: " + atlas.name);
         }
 
+        gpu.texture.setSmooth(atlas.distance_field);
         gpu.width = atlas.width;
         gpu.height = atlas.height;
         gpu.version = atlas.version;
@@ -155,6 +169,25 @@ namespace almondnamespace::sfmlcontext
     }
 
 
+    inline void evict_atlas(const TextureAtlas* atlas)
+    {
+        sfml_gpu_atlases.erase(atlas); // sf::Texture releases its GL handle
+    }
+
+    inline residency::ResidencyManager& sfml_residency()
+    {
+        static residency::ResidencyManager manager{ "SFML", [](const TextureAtlas* atlas) { evict_atlas(atlas); } };
+        return manager;
+    }
+
+    inline residency::GpuCopy gpu_copy(const TextureAtlas& atlas)
+    {
+        auto it = sfml_gpu_atlases.find(&atlas);
+        if (it == sfml_gpu_atlases.end() || it->second.texture.getSize().x == 0)
+            return {};
+        return { true, it->second.version };
+    }
+
     inline void ensure_uploaded(const TextureAtlas& atlas) {
         auto it = sfml_gpu_atlases.find(&atlas);
         if (it != sfml_gpu_atlases.end()) {
@@ -164,8 +197,49 @@ namespace almondnamespace::sfmlcontext
         upload_atlas_to_gpu(atlas);
     }
 
+    // ─── Distance-field shader ─────────────────────────────────────
+    // Alpha in a distance-field atlas is a distance; threshold it at the
+    // atlas edge with a one-pixel fwidth ramp (the OpenGL quad shader's
+    // rule, in SFML's compatibility GLSL). Built on first use.
+    inline std::unique_ptr<sf::Shader> sfml_sdf_shader;
+    inline bool sfml_sdf_shader_tried = false;
+
+    inline constexpr std::string_view SfmlSdfFragment = R"(
+        uniform sampler2D texture;
+        uniform float edge;
+
+        void main() {
+            vec4 texel = texture2D(texture, gl_TexCoord[0].xy);
+            float aa = max(fwidth(texel.a), 1e-4);
+            texel.a = smoothstep(edge - aa, edge + aa, texel.a);
+            gl_FragColor = gl_Color * texel;
+        }
+    )";
+
+    // Null when shaders are unsupported or failed to build; callers then
+    // draw the raw field.
+    inline const sf::Shader* distance_field_shader(const TextureAtlas& atlas)
+    {
+        if (!sfml_sdf_shader_tried) {
+            sfml_sdf_shader_tried = true;
+            auto shader = std::make_unique<sf::Shader>();
+            if (sf::Shader::isAvailable() && shader->loadFromMemory(SfmlSdfFragment, sf::Shader::Type::Fragment))
+                sfml_sdf_shader = std::move(shader);
+            else
+                std::cerr << "[SFML] Distance-field shader unavailable; SDF text draws unthresholded\n";
+        }
+        if (!sfml_sdf_shader)
+            return nullptr;
+        sfml_sdf_shader->setUniform("texture", sf::Shader::CurrentTexture);
+        sfml_sdf_shader->setUniform("edge", static_cast<float>(atlas.distance_field_edge) / 255.0f);
+        return sfml_sdf_shader.get();
+    }
+
     inline void clear_gpu_atlases() noexcept {
+        sfml_sdf_shader.reset();
+        sfml_sdf_shader_tried = false;
         sfml_gpu_atlases.clear();
+        sfml_residency().clear();
         s_generation.fetch_add(1, std::memory_order_relaxed);
     }
 
@@ -230,7 +304,8 @@ namespace almondnamespace::sfmlcontext
             return;
         }
 
-        ensure_uploaded(*atlas);
+        if (!sfml_residency().acquire(*atlas, gpu_copy(*atlas), [atlas] { ensure_uploaded(*atlas); }))
+            return; // re-upload staged for a later frame
 
         auto it = sfml_gpu_atlases.find(atlas);
         if (it == sfml_gpu_atlases.end())
@@ -273,6 +348,8 @@ namespace almondnamespace::sfmlcontext
         // necessary static definition. Constructing the states locally avoids that dependency
         // while preserving the default rendering behaviour.
         sf::RenderStates renderStates{};
+        if (atlas->distance_field)
+            renderStates.shader = distance_field_shader(*atlas);
         s_sfmlstate.window.sfml_window->draw(sprite, renderStates);
         //draw test rectangle for debugging
 //sf::RectangleShape test(sf::Vector2f(50, 50));
@@ -183,7 +183,7 @@ namespace almondnamespace::sliding
             const int tileWidth = tileImg.width / GRID_W;
             const int tileHeight = tileImg.height / GRID_H;
 
-            const bool createdAtlas = atlasmanager::create_atlas({
+            atlasmanager::create_atlas({
                 .name = "sliding_atlas",
                 .width = 512,
                 .height = 512,
@@ -193,20 +193,11 @@ namespace almondnamespace::sliding
             if (!registrar)
                 throw std::runtime_error("[Sliding] Missing atlas registrar");
 
-            TextureAtlas& atlas = registrar->atlas;
-            bool registeredTile = false;
+            std::vector<ImageData> tileImages;
+            tileImages.reserve(GRID_W * GRID_H);
+            std::vector<atlasmanager::AtlasRegistrar::SpriteImage> sprites;
 
             for (int tileId = 1; tileId < GRID_W * GRID_H; ++tileId) {
-                const std::string spriteName = "tile" + std::to_string(tileId);
-
-                if (auto existing = atlasmanager::registry.get(spriteName)) {
-                    auto handle = std::get<0>(*existing);
-                    if (spritepool::is_alive(handle)) {
-                        tiles[tileId] = handle;
-                        continue;
-                    }
-                }
-
                 std::vector<unsigned char> tilePixels(tileWidth * tileHeight * 4);
 
                 const int tx = tileId % GRID_W;
@@ -214,32 +205,19 @@ namespace almondnamespace::sliding
 
                 for (int y = 0; y < tileHeight; ++y) {
                     const int srcY = ty * tileHeight + y;
-                    for (int x = 0; x < tileWidth; ++x) {
-                        const int srcX = tx * tileWidth + x;
-                        const int srcIdx = (srcY * tileImg.width + srcX) * 4;
-                        const int dstIdx = (y * tileWidth + x) * 4;
-                        for (int c = 0; c < 4; ++c)
-                            tilePixels[dstIdx + c] = tileImg.pixels[srcIdx + c];
-                    }
+                    const auto* src = tileImg.pixels.data() + (srcY * tileImg.width + tx * tileWidth) * 4;
+                    std::copy_n(src, tileWidth * 4, tilePixels.data() + y * tileWidth * 4);
                 }
 
-                auto handleOpt = registrar->register_atlas_sprites_by_image(
-                    spriteName,
-                    tilePixels,
-                    tileWidth,
-                    tileHeight,
-                    atlas);
-
-                if (!handleOpt || !spritepool::is_alive(*handleOpt))
-                    throw std::runtime_error("[Sliding] Failed to register tile sprite: " + spriteName);
-
-                tiles[tileId] = *handleOpt;
-                registeredTile = true;
+                tileImages.emplace_back(std::move(tilePixels), tileWidth, tileHeight, 4);
+                sprites.push_back({ "tile" + std::to_string(tileId), &tileImages.back() });
             }
 
-            if (createdAtlas || registeredTile) {
-                atlas.rebuild_pixels();
-                atlasmanager::ensure_uploaded(atlas);
+            const auto handles = registrar->register_atlas_sprites_by_images(sprites);
+            for (size_t i = 0; i < handles.size(); ++i) {
+                if (!handles[i] || !spritepool::is_alive(*handles[i]))
+                    throw std::runtime_error("[Sliding] Failed to register tile sprite: " + sprites[i].name);
+                tiles[static_cast<int>(i) + 1] = *handles[i];
             }
         }
 
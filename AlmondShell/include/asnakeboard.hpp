@@ -0,0 +1,184 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // asnakeboard.hpp
+#pragma once
+
+#include "agamesim.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace almondnamespace::snake
+{
+    enum class Dir : std::uint8_t { Up, Down, Left, Right };
+
+    [[nodiscard]] constexpr bool opposite(Dir a, Dir b) noexcept
+    {
+        return (a == Dir::Up && b == Dir::Down) || (a == Dir::Down && b == Dir::Up)
+            || (a == Dir::Left && b == Dir::Right) || (a == Dir::Right && b == Dir::Left);
+    }
+
+    // ─── Board ────────────────────────────────────────────────────
+    // The body is a ring buffer of cell indices (tail first) next to an
+    // occupancy bitset; the whole state is flat arrays, so copies are a
+    // memcpy. Edges wrap around, as in the scene.
+    template <int W, int H>
+    struct Board
+    {
+        static_assert(W * H <= 65535, "cells are 16-bit");
+        static constexpr int Cells = W * H;
+
+        std::array<std::uint16_t, Cells> body{};
+        std::array<std::uint64_t, (Cells + 63) / 64> occupied{};
+        std::uint16_t tail = 0;       // ring index of the tail segment
+        std::uint16_t length = 0;
+        std::uint16_t food = 0;
+        Dir dir = Dir::Left;
+        bool over = false;
+        std::uint32_t score = 0;
+        gamesim::SimRng rng{};
+
+        [[nodiscard]] constexpr int segment(int i) const noexcept { return body[std::size_t((tail + i) % Cells)]; }
+        [[nodiscard]] constexpr int head() const noexcept { return segment(length - 1); }
+        [[nodiscard]] constexpr bool filled(int cell) const noexcept { return (occupied[std::size_t(cell) >> 6] >> (cell & 63)) & 1; }
+
+        constexpr void mark(int cell, bool on) noexcept
+        {
+            const std::uint64_t bit = std::uint64_t{ 1 } << (cell & 63);
+            if (on) occupied[std::size_t(cell) >> 6] |= bit;
+            else occupied[std::size_t(cell) >> 6] &= ~bit;
+        }
+
+        // Random free cell for the food; false when the snake fills the board.
+        constexpr bool place_food() noexcept
+        {
+            if (length >= Cells)
+                return false;
+            for (int tries = 0; tries < 64; ++tries)
+                if (const int c = int(rng.below(Cells)); !filled(c))
+                {
+                    food = std::uint16_t(c);
+                    return true;
+                }
+            // Crowded board: scan from a random start instead.
+            const int start = int(rng.below(Cells));
+            for (int i = 0; i < Cells; ++i)
+                if (const int c = (start + i) % Cells; !filled(c))
+                {
+                    food = std::uint16_t(c);
+                    return true;
+                }
+            return false;
+        }
+
+        friend constexpr bool operator==(const Board&, const Board&) = default;
+    };
+
+    template <int W, int H>
+    [[nodiscard]] constexpr Board<W, H> make_board(std::uint64_t seed) noexcept
+    {
+        Board<W, H> b{};
+        b.rng = gamesim::SimRng(seed);
+        const int start = (H / 2) * W + W / 2;
+        b.body[0] = std::uint16_t(start);
+        b.length = 1;
+        b.mark(start, true);
+        b.place_food();
+        return b;
+    }
+
+    struct StepOutcome
+    {
+        bool ate = false;
+        bool died = false;
+        bool filled = false;   // no room left for food: the board is won
+    };
+
+    // Turns toward `turn` unless it would reverse onto the neck, then
+    // advances one cell. Running into the body ends the game.
+    template <int W, int H>
+    constexpr StepOutcome advance(Board<W, H>& b, Dir turn) noexcept
+    {
+        if (b.over)
+            return { false, true, false };
+        if (!opposite(turn, b.dir))
+            b.dir = turn;
+
+        const int h = b.head();
+        int x = h % W, y = h / W;
+        switch (b.dir)
+        {
+        case Dir::Up: y = (y + H - 1) % H; break;
+        case Dir::Down: y = (y + 1) % H; break;
+        case Dir::Left: x = (x + W - 1) % W; break;
+        case Dir::Right: x = (x + 1) % W; break;
+        }
+        const int next = y * W + x;
+        if (b.filled(next))
+        {
+            b.over = true;
+            return { false, true, false };
+        }
+
+        b.body[std::size_t((b.tail + b.length) % Board<W, H>::Cells)] = std::uint16_t(next);
+        ++b.length;
+        b.mark(next, true);
+
+        if (next == b.food)
+        {
+            ++b.score;
+            if (!b.place_food())
+            {
+                b.over = true;
+                return { true, false, true };
+            }
+            return { true, false, false };
+        }
+        b.mark(b.segment(0), false);
+        b.tail = std::uint16_t((b.tail + 1) % Board<W, H>::Cells);
+        --b.length;
+        return {};
+    }
+
+    // ─── Rules for gamesim ────────────────────────────────────────
+    // Reward +1 per food and −1 for dying; done on death or a full board.
+    template <int W, int H>
+    struct Rules
+    {
+        using State = Board<W, H>;
+        using Action = Dir;
+
+        [[nodiscard]] State reset(std::uint64_t seed) const { return make_board<W, H>(seed); }
+
+        gamesim::StepResult step(State& b, Dir turn) const
+        {
+            const StepOutcome o = advance(b, turn);
+            return { o.died ? -1.0f : (o.ate ? 1.0f : 0.0f), o.died || o.filled };
+        }
+
+        [[nodiscard]] std::size_t action_count() const noexcept { return 4; }
+        [[nodiscard]] Dir action(std::size_t i) const noexcept { return static_cast<Dir>(i & 3); }
+    };
+
+} // namespace almondnamespace::snake
@@ -29,11 +29,11 @@
 #include "arobusttime.hpp"
 #include "acontext.hpp"
 #include "agamecore.hpp"
-#include "aecs.hpp"
 #include "aeventsystem.hpp"
 #include "ainput.hpp"
 #include "aatlasmanager.hpp"
 #include "aopengltextures.hpp"
+#include "asnakeboard.hpp"
 
 #include <deque>
 #include <random>
@@ -78,25 +78,25 @@ namespace almondnamespace::snake {
 
             ctx->clear_safe(ctx);
 
-            // Body
-            for (auto it = snakeSegments.begin(); it != snakeSegments.end(); ++it) {
-                auto& p = ecs::get_component<Position>(world, *it);
-                bool isHead = (std::next(it) == snakeSegments.end());
-                if (!isHead)
-                    ctx->draw_sprite_safe(bodyHandle, atlasSpan, p.x * cw, p.y * ch, cw, ch);
+            // Body (tail first), then the head
+            for (int i = 0; i + 1 < board.length; ++i) {
+                const int c = board.segment(i);
+                ctx->draw_sprite_safe(bodyHandle, atlasSpan, (c % GRID_W) * cw, (c / GRID_W) * ch, cw, ch);
             }
 
-            // Head
             {
-                auto& p = ecs::get_component<Position>(world, snakeSegments.back());
-                ctx->draw_sprite_safe(headHandle, atlasSpan, p.x * cw, p.y * ch, cw, ch);
-
-                int tx = (p.x + dir.x + GRID_W) % GRID_W;
-                int ty = (p.y + dir.y + GRID_H) % GRID_H;
-
-                SpriteHandle tongueHandle = (dir.x == -1) ? tongueLeftHandle :
-                    (dir.x == 1) ? tongueRightHandle :
-                    (dir.y == -1) ? tongueUpHandle :
+                const int h = board.head();
+                const int hx = h % GRID_W, hy = h / GRID_W;
+                ctx->draw_sprite_safe(headHandle, atlasSpan, hx * cw, hy * ch, cw, ch);
+
+                const int dx = board.dir == Dir::Left ? -1 : board.dir == Dir::Right ? 1 : 0;
+                const int dy = board.dir == Dir::Up ? -1 : board.dir == Dir::Down ? 1 : 0;
+                const int tx = (hx + dx + GRID_W) % GRID_W;
+                const int ty = (hy + dy + GRID_H) % GRID_H;
+
+                SpriteHandle tongueHandle = (dx == -1) ? tongueLeftHandle :
+                    (dx == 1) ? tongueRightHandle :
+                    (dy == -1) ? tongueUpHandle :
                     tongueDownHandle;
 
                 if (tongueFrame == 1)
@@ -105,10 +105,8 @@ namespace almondnamespace::snake {
             }
 
             // Food
-            {
-                auto& p = ecs::get_component<Position>(world, food);
-                ctx->draw_sprite_safe(foodHandle, atlasSpan, p.x * cw, p.y * ch, cw, ch);
-            }
+            ctx->draw_sprite_safe(foodHandle, atlasSpan,
+                (board.food % GRID_W) * cw, (board.food / GRID_W) * ch, cw, ch);
 
             ctx->present_safe();
             return !game_over;
@@ -116,7 +114,7 @@ namespace almondnamespace::snake {
 
         void unload() override {
             Scene::unload();
-            snakeSegments.clear();
+            board = {};
         }
 
     private:
@@ -127,18 +125,10 @@ namespace almondnamespace::snake {
         static constexpr int tongueFrameCount = 2;
         static constexpr double tongueStep = 0.25;
 
-        struct Position { int x, y; };
-        using Entity = ecs::Entity;
-
-        // === ECS world ===
-        ecs::reg_ex<Position> world;
-        std::deque<Entity> snakeSegments;
-        Entity food{ 0 };
-
         // === Game state ===
-        gamecore::grid_t<bool> occupied;
-        Position dir{ -1, 0 };
-        Position lastdir{ 0, 0 };
+        // Rules live in asnakeboard.hpp; the scene only feeds turns in.
+        Board<GRID_W, GRID_H> board{};
+        Dir dir = Dir::Left;
 
         time::Timer timer{};
         double acc = 0.0;
@@ -157,21 +147,7 @@ namespace almondnamespace::snake {
 
         // === Helpers ===
         inline void setupSprites() {
-            const auto headImg = a_loadImage("assets/snake/head.ppm", true);
-            const auto bodyImg = a_loadImage("assets/snake/body.ppm", true);
-            const auto foodImg = a_loadImage("assets/snake/food.ppm");
-            const auto tongueUp = a_loadImage("assets/snake/tongue_up.ppm");
-            const auto tongueDn = a_loadImage("assets/snake/tongue_down.ppm");
-            const auto tongueLt = a_loadImage("assets/snake/tongue_left.ppm");
-            const auto tongueRt = a_loadImage("assets/snake/tongue_right.ppm");
-
-            if (headImg.pixels.empty() || bodyImg.pixels.empty() || foodImg.pixels.empty() ||
-                tongueUp.pixels.empty() || tongueDn.pixels.empty() ||
-                tongueLt.pixels.empty() || tongueRt.pixels.empty()) {
-                throw std::runtime_error("Failed to load snake textures");
-            }
-
-            const bool createdAtlas = atlasmanager::create_atlas({
+            atlasmanager::create_atlas({
                 .name = "snakeatlas",
                 .width = 1024,
                 .height = 1024,
@@ -182,58 +158,31 @@ namespace almondnamespace::snake {
                 throw std::runtime_error("Failed to get snake atlas registrar");
             }
 
-            TextureAtlas& atlas = registrarPtr->atlas;
-            bool registeredAny = false;
-
-            auto ensureSprite = [&](std::string_view name, const ImageData& img, SpriteHandle& handle) {
-                if (auto existing = atlasmanager::registry.get(std::string(name))) {
-                    auto candidate = std::get<0>(*existing);
-                    if (spritepool::is_alive(candidate)) {
-                        handle = candidate;
-                        return;
-                    }
-                }
-
-                auto h = registrarPtr->register_atlas_sprites_by_image(std::string(name), img.pixels, img.width, img.height, atlas);
-                if (!h || !spritepool::is_alive(*h)) {
-                    throw std::runtime_error("Invalid sprite handle for '" + std::string(name) + "'");
-                }
-
-                handle = *h;
-                registeredAny = true;
+            const atlasmanager::AtlasRegistrar::SpriteFile files[] = {
+                { "snake_head", "assets/snake/head.ppm", true },
+                { "snake_body", "assets/snake/body.ppm", true },
+                { "snake_food", "assets/snake/food.ppm" },
+                { "snake_tongue_up", "assets/snake/tongue_up.ppm" },
+                { "snake_tongue_down", "assets/snake/tongue_down.ppm" },
+                { "snake_tongue_left", "assets/snake/tongue_left.ppm" },
+                { "snake_tongue_right", "assets/snake/tongue_right.ppm" },
+            };
+            SpriteHandle* targets[] = {
+                &headHandle, &bodyHandle, &foodHandle,
+                &tongueUpHandle, &tongueDownHandle, &tongueLeftHandle, &tongueRightHandle,
             };
 
-            ensureSprite("snake_head", headImg, headHandle);
-            ensureSprite("snake_body", bodyImg, bodyHandle);
-            ensureSprite("snake_food", foodImg, foodHandle);
-            ensureSprite("snake_tongue_up", tongueUp, tongueUpHandle);
-            ensureSprite("snake_tongue_down", tongueDn, tongueDownHandle);
-            ensureSprite("snake_tongue_left", tongueLt, tongueLeftHandle);
-            ensureSprite("snake_tongue_right", tongueRt, tongueRightHandle);
-
-            if (createdAtlas || registeredAny) {
-                atlas.rebuild_pixels();
-                atlasmanager::ensure_uploaded(atlas);
+            const auto handles = registrarPtr->load_atlas_sprites(files);
+            for (size_t i = 0; i < handles.size(); ++i) {
+                if (!handles[i] || !spritepool::is_alive(*handles[i])) {
+                    throw std::runtime_error("Invalid sprite handle for '" + files[i].name + "'");
+                }
+                *targets[i] = *handles[i];
             }
         }
 
         inline void initGame() {
-            world = ecs::make_registry<Position>();
-            occupied = gamecore::make_grid<bool>(GRID_W, GRID_H, false);
-            snakeSegments.clear();
-
-            auto spawn = [&](int gx, int gy) {
-                auto e = ecs::create_entity(world);
-                ecs::add_component(world, e, Position{ gx, gy });
-                snakeSegments.push_back(e);
-                gamecore::at(occupied, GRID_W, GRID_H, gx, gy) = true;
-                };
-
-            spawn(GRID_W / 2, GRID_H / 2);
-
-            food = ecs::create_entity(world);
-            ecs::add_component(world, food, Position{ 0, 0 });
-            place_food();
+            board = make_board<GRID_W, GRID_H>(std::random_device{}());
 
             timer = time::createTimer(0.25);
             time::setScale(timer, 0.25);
@@ -241,16 +190,15 @@ namespace almondnamespace::snake {
             tongueTimer = 0.0;
             tongueFrame = 0;
             game_over = false;
-            dir = { -1, 0 };
-            lastdir = { 0, 0 };
+            dir = Dir::Left;
         }
 
         inline void handleInput(std::shared_ptr<core::Context> ctx) {
-            if ((ctx->is_key_held(input::Key::A) || ctx->is_key_down(input::Key::Left)) && lastdir.x != 1)  dir = { -1, 0 };
-            if ((ctx->is_key_down(input::Key::D) || ctx->is_key_down(input::Key::Right)) && lastdir.x != -1) dir = { 1, 0 };
-            if ((ctx->is_key_down(input::Key::W) || ctx->is_key_down(input::Key::Up)) && lastdir.y != 1)  dir = { 0, -1 };
-            if ((ctx->is_key_down(input::Key::S) || ctx->is_key_down(input::Key::Down)) && lastdir.y != -1) dir = { 0, 1 };
-            lastdir = dir;
+            // advance() ignores a turn back onto the neck.
+            if (ctx->is_key_held(input::Key::A) || ctx->is_key_down(input::Key::Left))  dir = Dir::Left;
+            if (ctx->is_key_down(input::Key::D) || ctx->is_key_down(input::Key::Right)) dir = Dir::Right;
+            if (ctx->is_key_down(input::Key::W) || ctx->is_key_down(input::Key::Up))    dir = Dir::Up;
+            if (ctx->is_key_down(input::Key::S) || ctx->is_key_down(input::Key::Down))  dir = Dir::Down;
         }
 
         inline void tickTimers() {
@@ -269,42 +217,9 @@ namespace almondnamespace::snake {
             if (acc < STEP_S) return;   // not enough time elapsed yet
             acc -= STEP_S;
 
-            auto headE = snakeSegments.back();
-            auto headP = ecs::get_component<Position>(world, headE);
-
-            int nx = (headP.x + dir.x + GRID_W) % GRID_W;
-            int ny = (headP.y + dir.y + GRID_H) % GRID_H;
-
-            if (gamecore::at(occupied, GRID_W, GRID_H, nx, ny)) {
+            const StepOutcome outcome = advance(board, dir);
+            if (outcome.died || outcome.filled)
                 game_over = true;
-                return;
-            }
-
-            auto e = ecs::create_entity(world);
-            ecs::add_component(world, e, Position{ nx, ny });
-            snakeSegments.push_back(e);
-            gamecore::at(occupied, GRID_W, GRID_H, nx, ny) = true;
-
-            auto& fp = ecs::get_component<Position>(world, food);
-            if (nx == fp.x && ny == fp.y) {
-                place_food();
-            }
-            else {
-                auto tailE = snakeSegments.front();
-                auto tailP = ecs::get_component<Position>(world, tailE);
-                gamecore::at(occupied, GRID_W, GRID_H, tailP.x, tailP.y) = false;
-                ecs::destroy_entity(world, tailE);
-                snakeSegments.pop_front();
-            }
-        }
-
-
-        inline void place_food() {
-            std::mt19937_64 rng{ std::random_device{}() };
-            std::uniform_int_distribution<int> dX(0, GRID_W - 1), dY(0, GRID_H - 1);
-            int fx, fy;
-            do { fx = dX(rng); fy = dY(rng); } while (gamecore::at(occupied, GRID_W, GRID_H, fx, fy));
-            ecs::get_component<Position>(world, food) = { fx, fy };
         }
     };
 
@@ -91,7 +91,8 @@ namespace almondnamespace::anativecontext
         unsigned int w = 400, unsigned int h = 300,
         std::function<void(int, int)> onResize = nullptr)
     {
-        if (!ctx || !ctx->hwnd) {
+        const bool headless = s_softrendererstate.headless;
+        if (!ctx || (!ctx->hwnd && !headless)) {
             std::cerr << "[SoftRenderer] Invalid context hwnd\n";
             return false;
         }
@@ -197,7 +198,10 @@ namespace almondnamespace::anativecontext
         s_softrendererstate.bmi.bmiHeader.biCompression = BI_RGB;
 #endif
 
-        std::cout << "[SoftRenderer] Initialized on HWND=" << ctx->hwnd << "\n";
+        if (headless)
+            std::cout << "[SoftRenderer] Initialized headless " << w << "x" << h << "\n";
+        else
+            std::cout << "[SoftRenderer] Initialized on HWND=" << ctx->hwnd << "\n";
 
         atlasmanager::register_backend_uploader(core::ContextType::Software,
             [](const TextureAtlas& atlas) {
@@ -246,6 +250,66 @@ namespace almondnamespace::anativecontext
         }
     }
 
+    // Distance-field sprites: the alpha channel is sampled bilinearly and
+    // thresholded at the atlas' edge value with a ramp one destination pixel
+    // wide, so glyphs stay sharp at any draw size.
+    inline void blit_distance_field(const TextureAtlas& atlas, const AtlasRegion& region,
+        int destX, int destY, int destW, int destH,
+        int clipX0, int clipY0, int clipX1, int clipY1) noexcept
+    {
+        auto& sr = s_softrendererstate;
+        const int srcW = static_cast<int>((std::max)(1u, region.width));
+        const int srcH = static_cast<int>((std::max)(1u, region.height));
+        const float texelsPerPixel = static_cast<float>(srcW) / static_cast<float>(destW);
+        const float halfRamp = (std::max)(1.0f, 0.5f * atlas.distance_field_scale * texelsPerPixel);
+        const float edge = static_cast<float>(atlas.distance_field_edge);
+        const size_t stride = static_cast<size_t>(atlas.width) * 4;
+        const uint8_t* base = atlas.pixel_data.data()
+            + static_cast<size_t>(region.y) * stride + static_cast<size_t>(region.x) * 4;
+        if (atlas.pixel_data.size() < (static_cast<size_t>(region.y) + srcH) * stride)
+            return;
+
+        auto alpha_at = [&](int sx, int sy) {
+            sx = std::clamp(sx, 0, srcW - 1);
+            sy = std::clamp(sy, 0, srcH - 1);
+            return static_cast<float>(base[static_cast<size_t>(sy) * stride + static_cast<size_t>(sx) * 4 + 3]);
+        };
+
+        for (int py = clipY0; py < clipY1; ++py) {
+            const float fy = (static_cast<float>(py - destY) + 0.5f) * static_cast<float>(srcH) / static_cast<float>(destH) - 0.5f;
+            const int sy = static_cast<int>(std::floor(fy));
+            const float ty = fy - static_cast<float>(sy);
+            for (int px = clipX0; px < clipX1; ++px) {
+                const float fx = (static_cast<float>(px - destX) + 0.5f) * texelsPerPixel - 0.5f;
+                const int sx = static_cast<int>(std::floor(fx));
+                const float tx = fx - static_cast<float>(sx);
+
+                const float top = alpha_at(sx, sy) + (alpha_at(sx + 1, sy) - alpha_at(sx, sy)) * tx;
+                const float bottom = alpha_at(sx, sy + 1) + (alpha_at(sx + 1, sy + 1) - alpha_at(sx, sy + 1)) * tx;
+                const float distance = top + (bottom - top) * ty;
+                const float alpha = std::clamp((distance - edge) / (2.0f * halfRamp) + 0.5f, 0.0f, 1.0f);
+                if (alpha <= 0.0f)
+                    continue;
+
+                const uint8_t* src = base
+                    + static_cast<size_t>(std::clamp(sy, 0, srcH - 1)) * stride
+                    + static_cast<size_t>(std::clamp(sx, 0, srcW - 1)) * 4;
+                const size_t dstIndex = static_cast<size_t>(py) * static_cast<size_t>(sr.width) + static_cast<size_t>(px);
+                const uint32_t dst = sr.framebuffer[dstIndex];
+                const float invAlpha = 1.0f - alpha;
+                const float outR = src[0] * alpha + static_cast<float>((dst >> 16) & 0xFF) * invAlpha;
+                const float outG = src[1] * alpha + static_cast<float>((dst >> 8) & 0xFF) * invAlpha;
+                const float outB = src[2] * alpha + static_cast<float>(dst & 0xFF) * invAlpha;
+                const float outA = (alpha + static_cast<float>((dst >> 24) & 0xFF) / 255.0f * invAlpha) * 255.0f;
+
+                sr.framebuffer[dstIndex] = (static_cast<uint32_t>(outA + 0.5f) << 24)
+                    | (static_cast<uint32_t>(outR + 0.5f) << 16)
+                    | (static_cast<uint32_t>(outG + 0.5f) << 8)
+                    | static_cast<uint32_t>(outB + 0.5f);
+            }
+        }
+    }
+
     inline void draw_sprite(SpriteHandle handle,
         std::span<const TextureAtlas* const> atlases,
         float x, float y, float width, float height) noexcept
@@ -319,6 +383,11 @@ namespace almondnamespace::anativecontext
             return;
         }
 
+        if (atlas->distance_field) {
+            blit_distance_field(*atlas, region, destX, destY, destW, destH, clipX0, clipY0, clipX1, clipY1);
+            return;
+        }
+
         const int srcW = static_cast<int>((std::max)(1u, region.width));
         const int srcH = static_cast<int>((std::max)(1u, region.height));
         const float invDestW = 1.0f / static_cast<float>(destW);
@@ -0,0 +1,267 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // SoftRenderer - Headless offscreen target + deterministic frame capture
+#pragma once
+
+#include "aplatform.hpp"
+#include "aengineconfig.hpp"
+
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+
+#include "acontext.hpp"
+#include "awindowdata.hpp"
+#include "ascene.hpp"
+#include "arobusttime.hpp"
+#include "afixedtimestep.hpp"
+#include "aimagewriter.hpp"
+#include "aasyncimagewriter.hpp"
+#include "aatlasmanager.hpp"
+#include "asoftrenderer_context.hpp"
+#include "asoftrenderer_renderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace almondnamespace::anativecontext
+{
+    // Headless runs render into the software framebuffer without a display
+    // server. Time is driven through the manual clock so every run of the same
+    // scene observes an identical fixed-step sequence.
+    struct HeadlessRunConfig
+    {
+        int width = 800;
+        int height = 600;
+        int frames = 600;
+        double fixedStep = 1.0 / 60.0;          // seconds advanced per frame
+        std::filesystem::path captureDir;       // empty = no frame dumps
+        int captureEvery = 0;                   // 0 = only the final frame
+        std::string captureExtension = ".png";  // any format a_writeImage accepts
+        int pngCompressionLevel = 1;            // fast; captures are for diffing, not shipping
+    };
+
+    struct HeadlessFrameTiming
+    {
+        int frame = 0;
+        double frameMs = 0.0;   // Scene::update() ticks + Scene::frame() rasterisation
+        double drainMs = 0.0;   // queued GUI commands replayed after frame()
+        double captureMs = 0.0; // framebuffer readback + hand-off to the writer thread
+    };
+
+    struct HeadlessRunReport
+    {
+        std::vector<HeadlessFrameTiming> frames;
+        bool sceneExited = false;
+
+        [[nodiscard]] double average_frame_ms() const noexcept
+        {
+            if (frames.empty()) return 0.0;
+            double total = 0.0;
+            for (const auto& f : frames) total += f.frameMs + f.drainMs;
+            return total / static_cast<double>(frames.size());
+        }
+
+        // p in [0, 1]; nearest-rank percentile over frame + drain time.
+        [[nodiscard]] double percentile_frame_ms(double p) const
+        {
+            if (frames.empty()) return 0.0;
+            std::vector<double> samples;
+            samples.reserve(frames.size());
+            for (const auto& f : frames) samples.push_back(f.frameMs + f.drainMs);
+            std::sort(samples.begin(), samples.end());
+            const double rank = std::clamp(p, 0.0, 1.0) * static_cast<double>(samples.size() - 1);
+            return samples[static_cast<size_t>(rank + 0.5)];
+        }
+    };
+
+    // Copy of the current software framebuffer (0xAARRGGBB per pixel).
+    inline Framebuffer snapshot_framebuffer()
+    {
+        const auto& sr = s_softrendererstate;
+        Framebuffer fb{};
+        fb.width = sr.width;
+        fb.height = sr.height;
+        fb.pixels = sr.framebuffer;
+        return fb;
+    }
+
+    // Expand 0xAARRGGBB pixels into the RGBA8 byte order the image writers expect.
+    inline std::vector<uint8_t> framebuffer_to_rgba(const Framebuffer& fb)
+    {
+        std::vector<uint8_t> rgba(fb.pixels.size() * 4);
+        for (size_t i = 0; i < fb.pixels.size(); ++i) {
+            const uint32_t p = fb.pixels[i];
+            rgba[i * 4 + 0] = static_cast<uint8_t>((p >> 16) & 0xFF);
+            rgba[i * 4 + 1] = static_cast<uint8_t>((p >> 8) & 0xFF);
+            rgba[i * 4 + 2] = static_cast<uint8_t>(p & 0xFF);
+            rgba[i * 4 + 3] = static_cast<uint8_t>((p >> 24) & 0xFF);
+        }
+        return rgba;
+    }
+
+    inline bool write_framebuffer(const Framebuffer& fb, const std::filesystem::path& path)
+    {
+        if (fb.width <= 0 || fb.height <= 0 || fb.pixels.empty())
+            return false;
+        return a_writeImage(path, framebuffer_to_rgba(fb), fb.width, fb.height);
+    }
+
+    // Context wired to the software rasteriser with no window and no live input.
+    inline std::shared_ptr<core::Context> create_headless_context()
+    {
+        auto ctx = std::make_shared<core::Context>();
+        ctx->type = core::ContextType::Software;
+        ctx->backendName = "Software (headless)";
+        ctx->get_width = get_width;
+        ctx->get_height = get_height;
+        ctx->draw_sprite = draw_sprite;
+        ctx->registry_get = [](const char*) { return 0; };
+
+        ctx->is_key_held = [](input::Key) { return false; };
+        ctx->is_key_down = [](input::Key) { return false; };
+        ctx->get_mouse_position = [](int& x, int& y) { x = -1; y = -1; };
+        ctx->is_mouse_button_held = [](input::MouseButton) { return false; };
+        ctx->is_mouse_button_down = [](input::MouseButton) { return false; };
+
+        ctx->add_texture = [](TextureAtlas&, const std::string&, const ImageData&) { return 0u; };
+        ctx->add_atlas = [](const TextureAtlas& atlas) {
+            atlasmanager::ensure_uploaded(atlas);
+            atlasmanager::process_pending_uploads(core::ContextType::Software);
+            const int atlasIndex = atlas.get_index();
+            return static_cast<uint32_t>(atlasIndex >= 0 ? atlasIndex + 1 : 1);
+        };
+        ctx->add_model = [](const char*, const char*) { return 0; };
+        return ctx;
+    }
+
+    inline bool softrenderer_initialize_headless(std::shared_ptr<core::Context> ctx, int width, int height)
+    {
+        s_softrendererstate.headless = true;
+        const unsigned w = static_cast<unsigned>((std::max)(1, width));
+        const unsigned h = static_cast<unsigned>((std::max)(1, height));
+        if (!softrenderer_initialize(ctx, nullptr, w, h)) {
+            s_softrendererstate.headless = false;
+            return false;
+        }
+        if (ctx) {
+            ctx->width = ctx->framebufferWidth = ctx->virtualWidth = static_cast<int>(w);
+            ctx->height = ctx->framebufferHeight = ctx->virtualHeight = static_cast<int>(h);
+        }
+        return true;
+    }
+
+    // Runs `scene` for `config.frames` fixed-step frames into the offscreen
+    // framebuffer, optionally dumping frames, and returns per-frame timings.
+    inline HeadlessRunReport run_headless(scene::Scene& scene, const HeadlessRunConfig& config)
+    {
+        using SteadyClock = std::chrono::steady_clock;
+        auto ms_since = [](SteadyClock::time_point start) {
+            return std::chrono::duration<double, std::milli>(SteadyClock::now() - start).count();
+        };
+
+        HeadlessRunReport report{};
+
+        auto ctx = create_headless_context();
+        core::WindowData window{};
+        window.context = ctx;
+        window.type = core::ContextType::Software;
+        window.width = config.width;
+        window.height = config.height;
+        ctx->windowData = &window;
+
+        if (!softrenderer_initialize_headless(ctx, config.width, config.height)) {
+            ctx->windowData = nullptr;
+            return report;
+        }
+
+        // Frames are encoded on the image-writer thread so capture does not
+        // show up in the frame timings; the run waits for it at the end.
+        std::optional<imagewriter::FrameSequence> captures;
+        if (!config.captureDir.empty())
+            captures.emplace(config.captureDir, "frame", config.captureExtension, config.pngCompressionLevel);
+
+        time::enableManualClock(true);
+        time::FixedTimestep stepper{ 1.0 / (std::max)(1e-6, config.fixedStep) };
+        scene.load();
+        atlasmanager::process_pending_uploads(core::ContextType::Software);
+
+        const int frameCount = (std::max)(0, config.frames);
+        report.frames.reserve(static_cast<size_t>(frameCount));
+        auto& sr = s_softrendererstate;
+
+        for (int frame = 0; frame < frameCount; ++frame) {
+            time::advanceManualClock(config.fixedStep);
+            std::fill(sr.framebuffer.begin(), sr.framebuffer.end(), 0xFF000000);
+
+            HeadlessFrameTiming timing{};
+            timing.frame = frame;
+
+            auto start = SteadyClock::now();
+            stepper.advance(config.fixedStep, [&](double dt) { scene.update(dt); });
+            scene.setInterpolationAlpha(stepper.alpha());
+            const bool keepRunning = scene.frame(ctx, &window);
+            timing.frameMs = ms_since(start);
+
+            start = SteadyClock::now();
+            atlasmanager::process_pending_uploads(core::ContextType::Software);
+            window.commandQueue.drain();
+            timing.drainMs = ms_since(start);
+
+            const bool lastFrame = !keepRunning || frame + 1 == frameCount;
+            const bool capture = captures
+                && (config.captureEvery > 0 ? ((frame + 1) % config.captureEvery == 0) : lastFrame);
+            if (capture) {
+                start = SteadyClock::now();
+                captures->push_at(static_cast<uint64_t>(frame),
+                    framebuffer_to_rgba(snapshot_framebuffer()), sr.width, sr.height);
+                timing.captureMs = ms_since(start);
+            }
+
+            report.frames.push_back(timing);
+            if (!keepRunning) {
+                report.sceneExited = true;
+                break;
+            }
+        }
+
+        if (captures)
+            captures->flush();
+
+        scene.unload();
+        time::enableManualClock(false);
+        window.commandQueue.clear();
+        softrenderer_cleanup(ctx);
+        ctx->windowData = nullptr;
+        return report;
+    }
+}
+
+#endif // ALMOND_USING_SOFTWARE_RENDERER
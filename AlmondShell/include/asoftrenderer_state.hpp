@@ -55,6 +55,7 @@ namespace almondnamespace::anativecontext
         int width{ 400 };
         int height{ 300 };
         bool running{ false };
+        bool headless{ false }; // no native window; frames stay in `framebuffer` for capture
         std::vector<uint32_t> framebuffer;
 
         // Input states
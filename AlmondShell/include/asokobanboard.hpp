@@ -0,0 +1,229 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // asokobanboard.hpp
+#pragma once
+
+#include "agamesim.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace almondnamespace::sokoban
+{
+    // Levels up to 1024 cells (e.g. 32×32); cell = y * width + x.
+    inline constexpr int MaxCells = 1024;
+
+    // Fixed-size cell bitset, so states copy without touching the heap.
+    struct CellSet
+    {
+        std::array<std::uint64_t, MaxCells / 64> words{};
+
+        [[nodiscard]] constexpr bool test(int cell) const noexcept { return (words[std::size_t(cell) >> 6] >> (cell & 63)) & 1; }
+        constexpr void set(int cell) noexcept { words[std::size_t(cell) >> 6] |= std::uint64_t{ 1 } << (cell & 63); }
+        constexpr void reset(int cell) noexcept { words[std::size_t(cell) >> 6] &= ~(std::uint64_t{ 1 } << (cell & 63)); }
+
+        [[nodiscard]] constexpr int count() const noexcept
+        {
+            int n = 0;
+            for (const std::uint64_t w : words) n += std::popcount(w);
+            return n;
+        }
+
+        // Every set cell of *this is also set in `other`.
+        [[nodiscard]] constexpr bool subset_of(const CellSet& other) const noexcept
+        {
+            for (std::size_t i = 0; i < words.size(); ++i)
+                if (words[i] & ~other.words[i]) return false;
+            return true;
+        }
+
+        template <typename Fn>
+        constexpr void for_each(Fn&& fn) const
+        {
+            for (std::size_t i = 0; i < words.size(); ++i)
+                for (std::uint64_t w = words[i]; w; w &= w - 1)
+                    fn(int(i * 64) + std::countr_zero(w));
+        }
+
+        friend constexpr bool operator==(const CellSet&, const CellSet&) = default;
+    };
+
+    enum class Dir : std::uint8_t { Up, Down, Left, Right };
+
+    // ─── Level ────────────────────────────────────────────────────
+    // The static part of a puzzle: walls, goals and the start position.
+    struct Level
+    {
+        int width = 0;
+        int height = 0;
+        CellSet walls;
+        CellSet goals;
+        CellSet boxes;    // start
+        int player = 0;   // start
+
+        [[nodiscard]] constexpr int cell(int x, int y) const noexcept { return y * width + x; }
+        [[nodiscard]] constexpr bool contains(int x, int y) const noexcept
+        {
+            return unsigned(x) < unsigned(width) && unsigned(y) < unsigned(height);
+        }
+        // Neighbour of `c` toward `d`, or -1 off the board.
+        [[nodiscard]] constexpr int step(int c, Dir d) const noexcept
+        {
+            const int x = c % width, y = c / width;
+            const int nx = x + (d == Dir::Left ? -1 : d == Dir::Right ? 1 : 0);
+            const int ny = y + (d == Dir::Up ? -1 : d == Dir::Down ? 1 : 0);
+            return contains(nx, ny) ? cell(nx, ny) : -1;
+        }
+
+        // Standard XSB text, one string per row: '#' wall, ' ' or '-' floor,
+        // '.' goal, '$' box, '*' box on goal, '@' player, '+' player on goal.
+        // Cells outside the board's rows are walls.
+        [[nodiscard]] static std::optional<Level> parse(std::span<const std::string_view> rows)
+        {
+            Level level{};
+            level.height = int(rows.size());
+            for (const auto row : rows)
+                level.width = (std::max)(level.width, int(row.size()));
+            if (level.width == 0 || level.width * level.height > MaxCells)
+                return std::nullopt;
+
+            int players = 0;
+            for (int y = 0; y < level.height; ++y)
+                for (int x = 0; x < level.width; ++x)
+                {
+                    const auto& row = rows[std::size_t(y)];
+                    const char ch = std::size_t(x) < row.size() ? row[std::size_t(x)] : '#';
+                    const int c = level.cell(x, y);
+                    switch (ch)
+                    {
+                    case '#': level.walls.set(c); break;
+                    case '.': level.goals.set(c); break;
+                    case '$': level.boxes.set(c); break;
+                    case '*': level.boxes.set(c); level.goals.set(c); break;
+                    case '@': level.player = c; ++players; break;
+                    case '+': level.player = c; level.goals.set(c); ++players; break;
+                    case ' ': case '-': case '_': break;
+                    default: return std::nullopt;
+                    }
+                }
+            if (players != 1 || level.boxes.count() == 0 || level.boxes.count() > level.goals.count())
+                return std::nullopt;
+            return level;
+        }
+    };
+
+    // ─── State ────────────────────────────────────────────────────
+    struct State
+    {
+        CellSet boxes;
+        std::uint16_t player = 0;
+        std::uint32_t moves = 0;
+        std::uint32_t pushes = 0;
+
+        friend constexpr bool operator==(const State&, const State&) = default;
+    };
+
+    [[nodiscard]] constexpr State start_state(const Level& level) noexcept
+    {
+        return { level.boxes, std::uint16_t(level.player), 0, 0 };
+    }
+
+    [[nodiscard]] constexpr bool solved(const Level& level, const State& s) noexcept
+    {
+        return s.boxes.subset_of(level.goals);
+    }
+
+    struct MoveResult
+    {
+        bool moved = false;
+        bool pushed = false;
+        int goalDelta = 0;   // +1 box pushed onto a goal, −1 pushed off one
+    };
+
+    // Walks the player one cell, pushing a box if one is in the way and
+    // the cell behind it is free.
+    constexpr MoveResult apply_move(const Level& level, State& s, Dir d) noexcept
+    {
+        const int next = level.step(s.player, d);
+        if (next < 0 || level.walls.test(next))
+            return {};
+        MoveResult result{ true, false, 0 };
+        if (s.boxes.test(next))
+        {
+            const int beyond = level.step(next, d);
+            if (beyond < 0 || level.walls.test(beyond) || s.boxes.test(beyond))
+                return {};
+            s.boxes.reset(next);
+            s.boxes.set(beyond);
+            ++s.pushes;
+            result.pushed = true;
+            result.goalDelta = int(level.goals.test(beyond)) - int(level.goals.test(next));
+        }
+        s.player = std::uint16_t(next);
+        ++s.moves;
+        return result;
+    }
+
+    // ─── Rules for gamesim ────────────────────────────────────────
+    // Every episode replays the same level. Reward +1/−1 for a box onto or
+    // off a goal and +10 for solving it, which ends the episode.
+    struct Rules
+    {
+        using State = sokoban::State;
+        using Action = Dir;
+
+        std::shared_ptr<const Level> level;
+
+        // A Rules always has a level; there is no default constructor.
+        explicit Rules(std::shared_ptr<const Level> lvl)
+            : level(std::move(lvl))
+        {
+            if (!level)
+                throw std::invalid_argument("[Sokoban] Rules needs a level");
+        }
+
+        [[nodiscard]] State reset(std::uint64_t) const { return start_state(*level); }
+
+        gamesim::StepResult step(State& s, Dir d) const
+        {
+            const MoveResult move = apply_move(*level, s, d);
+            if (!move.pushed)
+                return {};
+            const bool done = solved(*level, s);
+            return { float(move.goalDelta) + (done ? 10.0f : 0.0f), done };
+        }
+
+        [[nodiscard]] std::size_t action_count() const noexcept { return 4; }
+        [[nodiscard]] Dir action(std::size_t i) const noexcept { return static_cast<Dir>(i & 3); }
+    };
+
+} // namespace almondnamespace::sokoban
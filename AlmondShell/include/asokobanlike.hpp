@@ -33,49 +33,36 @@
 #include "aspritepool.hpp"
 #include "ascene.hpp"
 #include "aimageloader.hpp"
+#include "asokobanboard.hpp"
+#include "asokobansolver.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <span>
 #include <stdexcept>
 
 namespace almondnamespace::sokoban
 {
-    constexpr int GRID_W = 16;
-    constexpr int GRID_H = 12;
-    enum Cell { FLOOR, WALL, GOAL };
-
-    struct State
-    {
-        almondnamespace::gamecore::grid_t<int> map;
-        almondnamespace::gamecore::grid_t<bool> box;
-        int px, py;
-
-        State()
-            : map(almondnamespace::gamecore::make_grid<int>(GRID_W, GRID_H, FLOOR)),
-            box(almondnamespace::gamecore::make_grid<bool>(GRID_W, GRID_H, false)),
-            px(1), py(1)
-        {
-            // Walls around edges
-            for (int x = 0; x < GRID_W; ++x) {
-                map[x + 0 * GRID_W] = WALL;
-                map[x + (GRID_H - 1) * GRID_W] = WALL;
-            }
-            for (int y = 0; y < GRID_H; ++y) {
-                map[0 + y * GRID_W] = WALL;
-                map[(GRID_W - 1) + y * GRID_W] = WALL;
-            }
-
-            // Sample goal and box positions
-            map[7 + 5 * GRID_W] = GOAL;
-            box[6 + 5 * GRID_W] = true;
-
-            px = 4;
-            py = 5;
-        }
+    // The sample room: a walled 16×12 floor with one box left of its goal.
+    inline constexpr std::string_view SampleLevel[] = {
+        "################",
+        "#              #",
+        "#              #",
+        "#              #",
+        "#              #",
+        "#   @ $.       #",
+        "#              #",
+        "#              #",
+        "#              #",
+        "#              #",
+        "#              #",
+        "################",
     };
 
     struct SokobanScene : public scene::Scene {
@@ -87,7 +74,14 @@ namespace almondnamespace::sokoban
         void load() override {
             Scene::load();
             setupSprites();
-            state = {};
+            if (!level) {
+                auto parsed = Level::parse(SampleLevel);
+                if (!parsed)
+                    throw std::runtime_error("[Sokoban] Invalid sample level");
+                level = std::make_shared<const Level>(*parsed);
+            }
+            state = start_state(*level);
+            solver = std::make_shared<Solver>(*level);
         }
 
         bool frame(std::shared_ptr<core::Context> ctx, core::WindowData*) override {
@@ -98,70 +92,56 @@ namespace almondnamespace::sokoban
             if (ctx->is_key_down_safe(input::Key::Escape))
                 return false;
 
-            int dx = 0;
-            int dy = 0;
-            if (ctx->is_key_down_safe(input::Key::A) || ctx->is_key_down_safe(input::Key::Left))  dx = -1;
-            if (ctx->is_key_down_safe(input::Key::D) || ctx->is_key_down_safe(input::Key::Right)) dx = 1;
-            if (ctx->is_key_down_safe(input::Key::W) || ctx->is_key_down_safe(input::Key::Up))    dy = -1;
-            if (ctx->is_key_down_safe(input::Key::S) || ctx->is_key_down_safe(input::Key::Down))  dy = 1;
-
-            int nx = state.px + dx;
-            int ny = state.py + dy;
-
-            bool blocked = false;
-            if (nx < 0 || nx >= GRID_W || ny < 0 || ny >= GRID_H) blocked = true;
-            else if (state.map[nx + ny * GRID_W] == WALL) blocked = true;
-
-            if (!blocked && state.box[nx + ny * GRID_W]) {
-                int bx = nx + dx;
-                int by = ny + dy;
-
-                bool boxBlocked = (bx < 0 || bx >= GRID_W || by < 0 || by >= GRID_H) ||
-                    (state.map[bx + by * GRID_W] == WALL) ||
-                    state.box[bx + by * GRID_W];
-
-                if (!boxBlocked) {
-                    state.box[bx + by * GRID_W] = true;
-                    state.box[nx + ny * GRID_W] = false;
-                }
-                else {
-                    blocked = true;
-                }
-            }
-
-            if (!blocked) {
-                state.px = nx;
-                state.py = ny;
+            // One direction per frame; horizontal wins when both are held.
+            std::optional<Dir> dir;
+            if (ctx->is_key_down_safe(input::Key::W) || ctx->is_key_down_safe(input::Key::Up))    dir = Dir::Up;
+            if (ctx->is_key_down_safe(input::Key::S) || ctx->is_key_down_safe(input::Key::Down))  dir = Dir::Down;
+            if (ctx->is_key_down_safe(input::Key::A) || ctx->is_key_down_safe(input::Key::Left))  dir = Dir::Left;
+            if (ctx->is_key_down_safe(input::Key::D) || ctx->is_key_down_safe(input::Key::Right)) dir = Dir::Right;
+            // H takes one step along a solution. The plan is searched for on
+            // the worker pool and the step is taken once it is ready; it is
+            // then replayed while the board is where the plan left it, and
+            // any other move invalidates it.
+            if (dir)
+                hintRequested = false;
+            else if (ctx->is_key_down_safe(input::Key::H))
+                hintRequested = true;
+            const bool hinting = !dir && hintRequested;
+            if (hinting) {
+                dir = nextHint();
+                if (dir || !hintSearch)
+                    hintRequested = false;
             }
+            if (dir)
+                apply_move(*level, state, *dir);
+            if (hinting && dir)
+                hintState = state;
 
             ctx->clear_safe(ctx);
 
             auto& atlasVec = atlasmanager::get_atlas_vector();
             std::span<const TextureAtlas* const> atlasSpan(atlasVec.data(), atlasVec.size());
 
-            const float cw = float((std::max)(1, ctx->get_width_safe())) / GRID_W;
-            const float ch = float((std::max)(1, ctx->get_height_safe())) / GRID_H;
-
-            for (int y = 0; y < GRID_H; ++y) {
-                for (int x = 0; x < GRID_W; ++x) {
-                    SpriteHandle handle = floorHandle;
-                    switch (state.map[x + y * GRID_W]) {
-                    case FLOOR: handle = floorHandle; break;
-                    case WALL:  handle = wallHandle;  break;
-                    case GOAL:  handle = goalHandle;  break;
-                    default:    handle = floorHandle; break;
-                    }
+            const float cw = float((std::max)(1, ctx->get_width_safe())) / level->width;
+            const float ch = float((std::max)(1, ctx->get_height_safe())) / level->height;
+
+            for (int y = 0; y < level->height; ++y) {
+                for (int x = 0; x < level->width; ++x) {
+                    const int c = level->cell(x, y);
+                    const SpriteHandle handle = level->walls.test(c) ? wallHandle
+                        : level->goals.test(c) ? goalHandle : floorHandle;
 
                     if (spritepool::is_alive(handle))
                         ctx->draw_sprite_safe(handle, atlasSpan, x * cw, y * ch, cw, ch);
 
-                    if (state.box[x + y * GRID_W] && spritepool::is_alive(boxHandle))
+                    if (state.boxes.test(c) && spritepool::is_alive(boxHandle))
                         ctx->draw_sprite_safe(boxHandle, atlasSpan, x * cw, y * ch, cw, ch);
                 }
             }
 
             if (spritepool::is_alive(playerHandle))
-                ctx->draw_sprite_safe(playerHandle, atlasSpan, state.px * cw, state.py * ch, cw, ch);
+                ctx->draw_sprite_safe(playerHandle, atlasSpan,
+                    (state.player % level->width) * cw, (state.player / level->width) * ch, cw, ch);
 
             ctx->present_safe();
             return true;
@@ -170,11 +150,72 @@ namespace almondnamespace::sokoban
         void unload() override {
             Scene::unload();
             state = {};
+            solver.reset();
+            hintSearch.reset();     // a running search finishes on its own copy
+            hintPlan.clear();
+            hintStep = 0;
+            hintValid = false;
+            hintRequested = false;
         }
 
     private:
+        // One background solve. The job owns the solver and the result
+        // until `done` is set; only one search runs at a time, so the
+        // solver's tables are never shared between threads.
+        struct HintSearch
+        {
+            State from{};
+            std::size_t nodeLimit = 0;
+            Solution result{};
+            std::atomic<bool> done{ false };
+        };
+
+        // Next step of the hint plan, or nullopt while a search is still
+        // running (or none exists). A truncated search is retried with a
+        // larger budget; a board proven unsolvable is not searched again
+        // until it changes.
+        std::optional<Dir> nextHint() {
+            if (!solver)
+                return std::nullopt;
+            const bool planMatches = hintValid && state == hintState;
+            if (planMatches)
+                return hintStep < hintPlan.size() ? std::optional<Dir>(hintPlan[hintStep++]) : std::nullopt;
+
+            if (hintSearch && hintSearch->done.load(std::memory_order_acquire)) {
+                const auto search = std::move(hintSearch);
+                if (search->from == state) {
+                    const Solution& plan = search->result;
+                    const bool truncated = plan.status == SolveStatus::LimitReached;
+                    if (truncated && search->nodeLimit < MaxHintNodeLimit) {
+                        startHintSearch(search->nodeLimit * 4);
+                        return std::nullopt;
+                    }
+                    hintPlan = plan.status == SolveStatus::Solved ? plan.moves : std::vector<Dir>{};
+                    hintStep = 0;
+                    hintState = state;
+                    hintValid = true;
+                    return nextHint();
+                }
+            }
+            if (!hintSearch)
+                startHintSearch(HintNodeLimit);
+            return std::nullopt;
+        }
+
+        void startHintSearch(std::size_t nodeLimit) {
+            auto search = std::make_shared<HintSearch>();
+            search->from = state;
+            search->nodeLimit = (std::min)(nodeLimit, MaxHintNodeLimit);
+            hintSearch = search;
+            scheduler_ensure_started();
+            scheduler_enqueue([search, solver = solver] {
+                search->result = solver->solve(search->from, { search->nodeLimit, 1 });
+                search->done.store(true, std::memory_order_release);
+            });
+        }
+
         void setupSprites() {
-            const bool createdAtlas = atlasmanager::create_atlas({
+            atlasmanager::create_atlas({
                 .name = "sokoban_atlas",
                 .width = 512,
                 .height = 512,
@@ -184,44 +225,35 @@ namespace almondnamespace::sokoban
             if (!registrar)
                 throw std::runtime_error("[Sokoban] Failed to get atlas registrar");
 
-            TextureAtlas& atlas = registrar->atlas;
-            bool registeredAny = false;
-
-            auto ensureSprite = [&](const char* name, const char* path, SpriteHandle& out) {
-                if (auto existing = atlasmanager::registry.get(std::string(name))) {
-                    auto handle = std::get<0>(*existing);
-                    if (spritepool::is_alive(handle)) {
-                        out = handle;
-                        return;
-                    }
-                }
-
-                auto img = a_loadImage(std::string(path), false);
-                if (img.pixels.empty())
-                    throw std::runtime_error("[Sokoban] Failed to load sprite asset: " + std::string(path));
-
-                auto handleOpt = registrar->register_atlas_sprites_by_image(
-                    std::string(name), img.pixels, img.width, img.height, atlas);
-                if (!handleOpt || !spritepool::is_alive(*handleOpt))
-                    throw std::runtime_error("[Sokoban] Failed to register sprite: " + std::string(name));
-
-                out = *handleOpt;
-                registeredAny = true;
+            const atlasmanager::AtlasRegistrar::SpriteFile files[] = {
+                { "wall", "assets/atestimage.ppm" },
+                { "floor", "assets/defaults/default.ppm" },
+                { "goal", "assets/atestimage.ppm" },
+                { "box", "assets/atestimage.ppm" },
+                { "player", "assets/defaults/yellow.ppm" },
             };
+            SpriteHandle* targets[] = { &wallHandle, &floorHandle, &goalHandle, &boxHandle, &playerHandle };
 
-            ensureSprite("wall", "assets/atestimage.ppm", wallHandle);
-            ensureSprite("floor", "assets/defaults/default.ppm", floorHandle);
-            ensureSprite("goal", "assets/atestimage.ppm", goalHandle);
-            ensureSprite("box", "assets/atestimage.ppm", boxHandle);
-            ensureSprite("player", "assets/defaults/yellow.ppm", playerHandle);
-
-            if (createdAtlas || registeredAny) {
-                atlas.rebuild_pixels();
-                atlasmanager::ensure_uploaded(atlas);
+            const auto handles = registrar->load_atlas_sprites(files);
+            for (size_t i = 0; i < handles.size(); ++i) {
+                if (!handles[i] || !spritepool::is_alive(*handles[i]))
+                    throw std::runtime_error("[Sokoban] Failed to register sprite: " + files[i].name);
+                *targets[i] = *handles[i];
             }
         }
 
+        static constexpr std::size_t HintNodeLimit = 50'000;
+        static constexpr std::size_t MaxHintNodeLimit = 3'200'000;
+
+        std::shared_ptr<const Level> level;
         State state{};
+        std::shared_ptr<Solver> solver;
+        std::shared_ptr<HintSearch> hintSearch;
+        std::vector<Dir> hintPlan;
+        std::size_t hintStep = 0;
+        State hintState{};
+        bool hintValid = false;
+        bool hintRequested = false;
         SpriteHandle wallHandle{};
         SpriteHandle floorHandle{};
         SpriteHandle goalHandle{};
@@ -0,0 +1,464 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // asokobansolver.hpp
+#pragma once
+
+#include "agridscratch.hpp"      // gamecore::grid_scratch
+#include "agamesim.hpp"         // splitmix64, scheduler_parallel_for
+#include "asokobanboard.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace almondnamespace::sokoban
+{
+    enum class SolveStatus : std::uint8_t { Solved, Unsolvable, LimitReached };
+
+    struct SolverOptions
+    {
+        std::size_t maxNodes = 1'000'000;   // stored states before giving up
+        // Search order is pushes + weight × lower bound: 1 is A* and finds
+        // push-optimal solutions, 0 is breadth-first over pushes, and larger
+        // weights find some solution faster.
+        std::uint32_t weight = 1;
+    };
+
+    struct Solution
+    {
+        SolveStatus status = SolveStatus::Unsolvable;
+        std::vector<Dir> moves;     // every step, walks included; empty unless solved
+        std::uint32_t pushes = 0;
+        std::size_t nodes = 0;      // states stored by the search
+    };
+
+    // ─── Solver ───────────────────────────────────────────────────
+    // Searches push by push. A state is the box set plus the region the
+    // player can reach, named by its lowest cell, so walks never become
+    // search nodes. States are Zobrist-hashed into an open-addressing
+    // transposition table; pushes onto dead squares (no goal reachable by
+    // pushing) or into freeze deadlocks are never generated.
+    //
+    // A Solver holds per-level tables and scratch; keep one per thread.
+    class Solver
+    {
+    public:
+        explicit Solver(const Level& level)
+            : level_(level)
+            , cells_(std::size_t(level.width * level.height))
+        {
+            boxKeys_.resize(cells_);
+            playerKeys_.resize(cells_);
+            std::uint64_t seed = 0x50C0BA4ull;
+            for (std::size_t c = 0; c < cells_; ++c)
+            {
+                boxKeys_[c] = gamesim::splitmix64(seed++);
+                playerKeys_[c] = gamesim::splitmix64(seed++);
+            }
+            build_goal_distances();
+        }
+
+        [[nodiscard]] const Level& level() const noexcept { return level_; }
+
+        // No goal can be reached by pushing a box from `cell`.
+        [[nodiscard]] bool dead(int cell) const noexcept { return goalDistance_[std::size_t(cell)] == Unreachable; }
+
+        // Pushes still needed, ignoring the other boxes; never overestimates.
+        [[nodiscard]] std::uint32_t lower_bound(const CellSet& boxes) const noexcept
+        {
+            std::uint32_t h = 0;
+            boxes.for_each([&](int c) { h += goalDistance_[std::size_t(c)]; });
+            return h;
+        }
+
+        [[nodiscard]] Solution solve(const State& from, const SolverOptions& options = {})
+        {
+            Solution out{};
+            nodes_.clear();
+            boxes_.clear();
+            open_.clear();
+            table_.assign(1024, 0);
+
+            std::vector<std::uint16_t> child;
+            std::uint64_t boxHash = 0;
+            bool deadStart = false;
+            from.boxes.for_each([&](int c) {
+                child.push_back(std::uint16_t(c));
+                boxHash ^= boxKeys_[std::size_t(c)];
+                deadStart |= dead(c);
+            });
+            boxCount_ = child.size();
+            if (deadStart)
+                return out;
+
+            const int player = reach(from.boxes, from.player, reach_);
+            insert(boxHash, player, NoParent, 0, 0, 0, options.weight, lower_bound(from.boxes), child.data());
+            while (!open_.empty())
+            {
+                std::pop_heap(open_.begin(), open_.end(), OpenOrder{});
+                const OpenEntry entry = open_.back();
+                open_.pop_back();
+                if (nodes_[entry.node].closed || entry.g != nodes_[entry.node].g)
+                    continue;   // stale: reached again more cheaply
+                nodes_[entry.node].closed = true;
+
+                if (entry.h == 0)
+                {
+                    out.status = SolveStatus::Solved;
+                    out.pushes = entry.g;
+                    out.nodes = nodes_.size();
+                    replay(from, entry.node, out.moves);
+                    return out;
+                }
+
+                const Node node = nodes_[entry.node];
+                const std::uint16_t* list = &boxes_[std::size_t(entry.node) * boxCount_];
+                CellSet boxes{};
+                for (std::size_t k = 0; k < boxCount_; ++k)
+                    boxes.set(list[k]);
+                reach(boxes, node.player, reach_);
+
+                for (std::size_t k = 0; k < boxCount_; ++k)
+                {
+                    const int b = list[k];
+                    for (const Dir d : { Dir::Up, Dir::Down, Dir::Left, Dir::Right })
+                    {
+                        const int t = level_.step(b, d);
+                        const int behind = level_.step(b, opposite(d));
+                        if (t < 0 || behind < 0 || level_.walls.test(t) || boxes.test(t) || dead(t)
+                            || !reach_.visited(std::size_t(behind)))
+                            continue;
+
+                        boxes.reset(b);
+                        boxes.set(t);
+                        if (!freeze_deadlock(boxes, t))
+                        {
+                            std::copy(list, list + boxCount_, child.begin());
+                            child[k] = std::uint16_t(t);
+                            std::sort(child.begin(), child.end());
+                            const std::uint32_t h = entry.h - goalDistance_[std::size_t(b)] + goalDistance_[std::size_t(t)];
+                            insert(node.boxHash ^ boxKeys_[std::size_t(b)] ^ boxKeys_[std::size_t(t)],
+                                reach(boxes, b, childReach_), entry.node, std::uint16_t(b), std::uint16_t(t),
+                                entry.g + 1, options.weight, h, child.data());
+                            // insert() may have grown boxes_.
+                            list = &boxes_[std::size_t(entry.node) * boxCount_];
+                        }
+                        boxes.reset(t);
+                        boxes.set(b);
+                    }
+                }
+
+                if (nodes_.size() >= options.maxNodes)
+                {
+                    out.status = SolveStatus::LimitReached;
+                    out.nodes = nodes_.size();
+                    return out;
+                }
+            }
+            out.nodes = nodes_.size();
+            return out;
+        }
+
+    private:
+        static constexpr std::uint32_t Unreachable = (std::numeric_limits<std::uint32_t>::max)();
+        static constexpr std::uint32_t NoParent = Unreachable;
+
+        struct Node
+        {
+            std::uint64_t hash = 0;      // boxHash ^ player key
+            std::uint64_t boxHash = 0;
+            std::uint32_t parent = NoParent;
+            std::uint32_t g = 0;         // pushes from the start
+            std::uint16_t player = 0;    // lowest reachable cell
+            std::uint16_t from = 0;      // the push that led here
+            std::uint16_t to = 0;
+            bool closed = false;
+        };
+
+        struct OpenEntry
+        {
+            std::uint32_t f = 0;
+            std::uint32_t h = 0;
+            std::uint32_t g = 0;
+            std::uint32_t node = 0;
+        };
+
+        // Min-heap on f, ties to the state nearer the goal.
+        struct OpenOrder
+        {
+            bool operator()(const OpenEntry& a, const OpenEntry& b) const noexcept
+            {
+                return a.f != b.f ? a.f > b.f : a.h > b.h;
+            }
+        };
+
+        [[nodiscard]] static constexpr Dir opposite(Dir d) noexcept
+        {
+            switch (d)
+            {
+            case Dir::Up: return Dir::Down;
+            case Dir::Down: return Dir::Up;
+            case Dir::Left: return Dir::Right;
+            default: return Dir::Left;
+            }
+        }
+
+        // Reverse search from every goal by pulling a box: the box can be
+        // pulled from b to p when the player has room at the cell past p.
+        void build_goal_distances()
+        {
+            goalDistance_.assign(cells_, Unreachable);
+            std::vector<int> queue;
+            level_.goals.for_each([&](int c) {
+                goalDistance_[std::size_t(c)] = 0;
+                queue.push_back(c);
+            });
+            for (std::size_t head = 0; head < queue.size(); ++head)
+            {
+                const int b = queue[head];
+                for (const Dir d : { Dir::Up, Dir::Down, Dir::Left, Dir::Right })
+                {
+                    const int p = level_.step(b, d);
+                    if (p < 0 || level_.walls.test(p) || goalDistance_[std::size_t(p)] != Unreachable)
+                        continue;
+                    const int past = level_.step(p, d);
+                    if (past < 0 || level_.walls.test(past))
+                        continue;
+                    goalDistance_[std::size_t(p)] = goalDistance_[std::size_t(b)] + 1;
+                    queue.push_back(p);
+                }
+            }
+        }
+
+        // Floods the player's region into `scratch`; returns its lowest cell.
+        int reach(const CellSet& boxes, int start, gamecore::grid_scratch& scratch) const
+        {
+            scratch.begin(cells_);
+            scratch.mark(std::size_t(start));
+            scratch.queue.push_back(std::uint32_t(start));
+            int lowest = start;
+            for (std::size_t head = 0; head < scratch.queue.size(); ++head)
+            {
+                const int c = int(scratch.queue[head]);
+                lowest = (std::min)(lowest, c);
+                for (const Dir d : { Dir::Up, Dir::Down, Dir::Left, Dir::Right })
+                {
+                    const int n = level_.step(c, d);
+                    if (n < 0 || scratch.visited(std::size_t(n)) || level_.walls.test(n) || boxes.test(n))
+                        continue;
+                    scratch.mark(std::size_t(n));
+                    scratch.queue.push_back(std::uint32_t(n));
+                }
+            }
+            return lowest;
+        }
+
+        // ─── Freeze deadlocks ─────────────────────────────────────
+        // A box is frozen when it can move along neither axis. An axis is
+        // blocked by a wall on either side, dead squares on both, or a
+        // neighbouring box that is itself frozen; boxes under examination
+        // count as walls, which ends the recursion. Only a frozen group
+        // with a box off its goal is a deadlock.
+        [[nodiscard]] bool freeze_deadlock(const CellSet& boxes, int cell)
+        {
+            bool offGoal = false;
+            return frozen(boxes, cell, offGoal) && offGoal;
+        }
+
+        bool frozen(const CellSet& boxes, int cell, bool& offGoal)
+        {
+            examining_.set(cell);
+            bool off = !level_.goals.test(cell);
+            const bool result = axis_blocked(boxes, cell, Dir::Left, Dir::Right, off)
+                && axis_blocked(boxes, cell, Dir::Up, Dir::Down, off);
+            examining_.reset(cell);
+            if (result)
+                offGoal |= off;
+            return result;
+        }
+
+        bool axis_blocked(const CellSet& boxes, int cell, Dir a, Dir b, bool& offGoal)
+        {
+            const int na = level_.step(cell, a);
+            const int nb = level_.step(cell, b);
+            auto solid = [&](int c) { return c < 0 || level_.walls.test(c) || examining_.test(c); };
+            if (solid(na) || solid(nb))
+                return true;
+            if (dead(na) && dead(nb))
+                return true;
+            return (boxes.test(na) && frozen(boxes, na, offGoal))
+                || (boxes.test(nb) && frozen(boxes, nb, offGoal));
+        }
+
+        // ─── Transposition table ──────────────────────────────────
+        // Adds the state or, if it is known but still open, lowers its push
+        // count; either way queues it for expansion.
+        void insert(std::uint64_t boxHash, int player, std::uint32_t parent,
+            std::uint16_t from, std::uint16_t to, std::uint32_t g,
+            std::uint32_t weight, std::uint32_t h, const std::uint16_t* boxes)
+        {
+            const std::uint64_t hash = boxHash ^ playerKeys_[std::size_t(player)];
+            const std::size_t mask = table_.size() - 1;
+            std::size_t slot = std::size_t(hash) & mask;
+            for (; table_[slot]; slot = (slot + 1) & mask)
+            {
+                Node& n = nodes_[table_[slot] - 1];
+                if (n.hash != hash || n.player != player
+                    || !std::equal(boxes, boxes + boxCount_, &boxes_[std::size_t(table_[slot] - 1) * boxCount_]))
+                    continue;
+                if (n.closed || n.g <= g)
+                    return;
+                n.g = g;
+                n.parent = parent;
+                n.from = from;
+                n.to = to;
+                open_.push_back({ g + weight * h, h, g, table_[slot] - 1 });
+                std::push_heap(open_.begin(), open_.end(), OpenOrder{});
+                return;
+            }
+
+            const std::uint32_t index = std::uint32_t(nodes_.size());
+            nodes_.push_back({ hash, boxHash, parent, g, std::uint16_t(player), from, to, false });
+            boxes_.insert(boxes_.end(), boxes, boxes + boxCount_);
+            table_[slot] = index + 1;
+            open_.push_back({ g + weight * h, h, g, index });
+            std::push_heap(open_.begin(), open_.end(), OpenOrder{});
+
+            if (nodes_.size() * 2 > table_.size())
+                grow_table();
+        }
+
+        void grow_table()
+        {
+            table_.assign(table_.size() * 2, 0);
+            const std::size_t mask = table_.size() - 1;
+            for (std::uint32_t i = 0; i < nodes_.size(); ++i)
+            {
+                std::size_t slot = std::size_t(nodes_[i].hash) & mask;
+                while (table_[slot])
+                    slot = (slot + 1) & mask;
+                table_[slot] = i + 1;
+            }
+        }
+
+        // Turns the chain of pushes ending at `goal` into player steps.
+        void replay(const State& from, std::uint32_t goal, std::vector<Dir>& moves) const
+        {
+            std::vector<std::uint32_t> chain;
+            for (std::uint32_t n = goal; nodes_[n].parent != NoParent; n = nodes_[n].parent)
+                chain.push_back(n);
+
+            CellSet boxes = from.boxes;
+            int player = from.player;
+            std::vector<int> cameFrom(cells_);
+            std::vector<int> queue;
+            for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+            {
+                const Node& n = nodes_[*it];
+                Dir push = Dir::Up;
+                for (const Dir d : { Dir::Up, Dir::Down, Dir::Left, Dir::Right })
+                    if (level_.step(n.from, d) == n.to)
+                        push = d;
+                const int target = level_.step(n.from, opposite(push));
+
+                // Breadth-first walk to the pushing position.
+                std::fill(cameFrom.begin(), cameFrom.end(), -1);
+                queue.assign(1, player);
+                cameFrom[std::size_t(player)] = player;
+                for (std::size_t head = 0; head < queue.size() && cameFrom[std::size_t(target)] < 0; ++head)
+                    for (const Dir d : { Dir::Up, Dir::Down, Dir::Left, Dir::Right })
+                    {
+                        const int c = level_.step(queue[head], d);
+                        if (c < 0 || cameFrom[std::size_t(c)] >= 0 || level_.walls.test(c) || boxes.test(c))
+                            continue;
+                        cameFrom[std::size_t(c)] = queue[head];
+                        queue.push_back(c);
+                    }
+
+                const std::size_t walkStart = moves.size();
+                for (int c = target; c != player; c = cameFrom[std::size_t(c)])
+                {
+                    const int prev = cameFrom[std::size_t(c)];
+                    for (const Dir d : { Dir::Up, Dir::Down, Dir::Left, Dir::Right })
+                        if (level_.step(prev, d) == c)
+                            moves.push_back(d);
+                }
+                std::reverse(moves.begin() + std::ptrdiff_t(walkStart), moves.end());
+
+                moves.push_back(push);
+                boxes.reset(n.from);
+                boxes.set(n.to);
+                player = n.from;
+            }
+        }
+
+        Level level_;
+        std::size_t cells_ = 0;
+        std::size_t boxCount_ = 0;
+        std::vector<std::uint32_t> goalDistance_;
+        std::vector<std::uint64_t> boxKeys_;
+        std::vector<std::uint64_t> playerKeys_;
+
+        std::vector<Node> nodes_;
+        std::vector<std::uint16_t> boxes_;   // boxCount_ sorted cells per node
+        std::vector<std::uint32_t> table_;   // node index + 1, 0 = empty
+        std::vector<OpenEntry> open_;
+        gamecore::grid_scratch reach_;
+        gamecore::grid_scratch childReach_;
+        CellSet examining_;
+    };
+
+    // ─── Convenience ──────────────────────────────────────────────
+    [[nodiscard]] inline Solution solve(const Level& level, const SolverOptions& options = {})
+    {
+        Solver solver(level);
+        return solver.solve(start_state(level), options);
+    }
+
+    // Next step toward a solution from `state`, if one is found in budget.
+    [[nodiscard]] inline std::optional<Dir> hint(const Level& level, const State& state, const SolverOptions& options = {})
+    {
+        Solver solver(level);
+        const Solution solution = solver.solve(state, options);
+        if (solution.status != SolveStatus::Solved || solution.moves.empty())
+            return std::nullopt;
+        return solution.moves.front();
+    }
+
+    // Solves a batch of levels, one per worker task; for validating
+    // generated level sets.
+    [[nodiscard]] inline std::vector<Solution> solve_levels(std::span<const Level> levels, const SolverOptions& options = {})
+    {
+        std::vector<Solution> results(levels.size());
+        scheduler_parallel_for(levels.size(), [&](std::size_t i) {
+            results[i] = solve(levels[i], options);
+        });
+        return results;
+    }
+
+} // namespace almondnamespace::sokoban
@@ -32,10 +32,12 @@
 #include <iostream>
 #include <optional>
 #include <shared_mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace almondnamespace {
 
@@ -111,6 +113,37 @@ namespace almondnamespace {
 #endif
         }
 
+        struct BatchEntry {
+            std::string_view name;
+            SpriteHandle handle;
+            float u0 = 0.f, v0 = 0.f, width = 0.f, height = 0.f;
+        };
+
+        // add() for a whole set under one lock; the duplicate-handle scan is
+        // done once for the batch instead of once per sprite.
+        void add_batch(std::span<const BatchEntry> batch) {
+            std::unique_lock lock(mutex);
+
+            std::unordered_map<SpriteHandle, std::string_view, SpriteHandleHash> owners;
+            owners.reserve(sprites.size() + batch.size());
+            for (const auto& [existingName, entry] : sprites)
+                owners.emplace(std::get<0>(entry), existingName);
+
+            for (const auto& item : batch) {
+                if (!item.handle.is_valid() || !spritepool::is_alive(item.handle)) {
+                    std::cerr << "[SpriteRegistry] Rejecting invalid handle for sprite '" << std::string{ item.name } << "'\n";
+                    continue;
+                }
+                auto [owner, inserted] = owners.emplace(item.handle, item.name);
+                if (!inserted && owner->second != item.name) {
+                    std::cerr << "[SpriteRegistry] Duplicate handle detected for sprite '" << std::string{ item.name } << "'\n";
+                    continue;
+                }
+                sprites.emplace(std::string{ item.name },
+                    Entry{ item.handle, item.u0, item.v0, item.u0 + item.width, item.v0 + item.height, 0.f, 0.f });
+            }
+        }
+
         [[nodiscard]]
         std::optional<Entry> get(std::string_view name) const noexcept {
             std::shared_lock lock(mutex);
@@ -0,0 +1,292 @@
+/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // atetrisboard.hpp
+#pragma once
+
+#include "agamesim.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace almondnamespace::tetris
+{
+    // ─── Pieces ───────────────────────────────────────────────────
+    // 4×4 cells per rotation, row-major, as drawn.
+    inline constexpr std::array<std::array<std::array<int, 16>, 4>, 7> TETRAMINOS = { {
+            // I
+            {{{0,1,0,0,  0,1,0,0,  0,1,0,0,  0,1,0,0},
+              {0,0,0,0,  1,1,1,1,  0,0,0,0,  0,0,0,0},
+              {0,0,1,0,  0,0,1,0,  0,0,1,0,  0,0,1,0},
+              {0,0,0,0,  0,0,0,0,  1,1,1,1,  0,0,0,0}}},
+              // O
+              {{{0,0,0,0,  0,1,1,0,  0,1,1,0,  0,0,0,0},
+                {0,0,0,0,  0,1,1,0,  0,1,1,0,  0,0,0,0},
+                {0,0,0,0,  0,1,1,0,  0,1,1,0,  0,0,0,0},
+                {0,0,0,0,  0,1,1,0,  0,1,1,0,  0,0,0,0}}},
+                // T
+                {{{0,0,0,0,  1,1,1,0,  0,1,0,0,  0,0,0,0},
+                  {0,0,1,0,  0,1,1,0,  0,0,1,0,  0,0,0,0},
+                  {0,0,0,0,  0,1,0,0,  1,1,1,0,  0,0,0,0},
+                  {0,1,0,0,  1,1,0,0,  0,1,0,0,  0,0,0,0}}},
+                  // S
+                  {{{0,0,0,0,  0,1,1,0,  1,1,0,0,  0,0,0,0},
+                    {0,1,0,0,  0,1,1,0,  0,0,1,0,  0,0,0,0},
+                    {0,0,0,0,  0,1,1,0,  1,1,0,0,  0,0,0,0},
+                    {0,1,0,0,  0,1,1,0,  0,0,1,0,  0,0,0,0}}},
+                    // Z
+                    {{{0,0,0,0,  1,1,0,0,  0,1,1,0,  0,0,0,0},
+                      {0,0,1,0,  0,1,1,0,  0,1,0,0,  0,0,0,0},
+                      {0,0,0,0,  1,1,0,0,  0,1,1,0,  0,0,0,0},
+                      {0,0,1,0,  0,1,1,0,  0,1,0,0,  0,0,0,0}}},
+                      // J
+                      {{{0,0,0,0,  1,0,0,0,  1,1,1,0,  0,0,0,0},
+                        {0,0,1,1,  0,0,1,0,  0,0,1,0,  0,0,0,0},
+                        {0,0,0,0,  1,1,1,0,  0,0,1,0,  0,0,0,0},
+                        {0,0,1,0,  0,0,1,0,  0,1,1,0,  0,0,0,0}}},
+                        // L
+                        {{{0,0,0,0,  0,0,1,0,  1,1,1,0,  0,0,0,0},
+                          {0,0,1,0,  0,0,1,0,  0,0,1,1,  0,0,0,0},
+                          {0,0,0,0,  1,1,1,0,  1,0,0,0,  0,0,0,0},
+                          {0,1,1,0,  0,0,1,0,  0,0,1,0,  0,0,0,0}}}
+                    } };
+
+    // A rotation as four row masks (bit j = column j of the 4×4 box) plus
+    // the occupied column/row extents used for the bounds test.
+    struct PieceMask
+    {
+        std::array<std::uint8_t, 4> rows{};
+        int minCol = 4, maxCol = -1;
+        int minRow = 4, maxRow = -1;
+    };
+
+    inline constexpr auto PIECE_MASKS = [] {
+        std::array<std::array<PieceMask, 4>, 7> masks{};
+        for (std::size_t s = 0; s < 7; ++s)
+            for (std::size_t r = 0; r < 4; ++r)
+            {
+                PieceMask& m = masks[s][r];
+                for (int i = 0; i < 4; ++i)
+                    for (int j = 0; j < 4; ++j)
+                        if (TETRAMINOS[s][r][std::size_t(i * 4 + j)])
+                        {
+                            m.rows[std::size_t(i)] |= std::uint8_t(1u << j);
+                            m.minCol = j < m.minCol ? j : m.minCol;
+                            m.maxCol = j > m.maxCol ? j : m.maxCol;
+                            m.minRow = i < m.minRow ? i : m.minRow;
+                            m.maxRow = i > m.maxRow ? i : m.maxRow;
+                        }
+            }
+        return masks;
+    }();
+
+    enum class Action : std::uint8_t { None, Left, Right, Rotate, SoftDrop, HardDrop };
+
+    struct StepOutcome
+    {
+        bool locked = false;      // the piece came to rest this step
+        int linesCleared = 0;
+        bool gameOver = false;    // the next piece could not spawn
+    };
+
+    // ─── Board ────────────────────────────────────────────────────
+    // One 64-bit mask per row: collision is an AND per piece row, a full
+    // line is a compare, and clears compact the rows in a single pass.
+    template <int W, int H>
+    struct Board
+    {
+        static_assert(W >= 4 && W <= 64 && H >= 4, "rows are single 64-bit words");
+        static constexpr std::uint64_t FullRow = W == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << W) - 1;
+
+        std::array<std::uint64_t, H> rows{};
+
+        [[nodiscard]] constexpr bool filled(int x, int y) const noexcept { return (rows[std::size_t(y)] >> x) & 1; }
+
+        [[nodiscard]] constexpr bool collides(const PieceMask& piece, int px, int py) const noexcept
+        {
+            if (px + piece.minCol < 0 || px + piece.maxCol >= W || py + piece.minRow < 0 || py + piece.maxRow >= H)
+                return true;
+            for (int i = piece.minRow; i <= piece.maxRow; ++i)
+                if (rows[std::size_t(py + i)] & shifted(piece.rows[std::size_t(i)], px))
+                    return true;
+            return false;
+        }
+
+        constexpr void place(const PieceMask& piece, int px, int py) noexcept
+        {
+            for (int i = piece.minRow; i <= piece.maxRow; ++i)
+                rows[std::size_t(py + i)] |= shifted(piece.rows[std::size_t(i)], px);
+        }
+
+        // Drops full rows and slides the rest down; returns how many went.
+        constexpr int clear_lines() noexcept
+        {
+            int write = H - 1;
+            for (int y = H - 1; y >= 0; --y)
+                if (rows[std::size_t(y)] != FullRow)
+                    rows[std::size_t(write--)] = rows[std::size_t(y)];
+            const int cleared = write + 1;
+            for (int y = 0; y <= write; ++y)
+                rows[std::size_t(y)] = 0;
+            return cleared;
+        }
+
+        // Lowest py the piece can rest at when dropped from (px, py).
+        [[nodiscard]] constexpr int drop_row(const PieceMask& piece, int px, int py) const noexcept
+        {
+            while (!collides(piece, px, py + 1))
+                ++py;
+            return py;
+        }
+
+        friend constexpr bool operator==(const Board&, const Board&) = default;
+
+    private:
+        [[nodiscard]] static constexpr std::uint64_t shifted(std::uint8_t row, int px) noexcept
+        {
+            return px >= 0 ? std::uint64_t(row) << px : std::uint64_t(row) >> -px;
+        }
+    };
+
+    // ─── Headless game ────────────────────────────────────────────
+    // Plain copyable state (the RNG is a gamesim::SimRng), so search code
+    // can clone it freely and call step() millions of times a second.
+    template <int W, int H>
+    struct Game
+    {
+        Board<W, H> board{};
+        int shape = 0, rot = 0;
+        int px = SpawnX, py = 0;
+        gamesim::SimRng rng{};
+        std::uint64_t lines = 0;
+        std::uint64_t pieces = 0;
+        bool over = false;
+
+        static constexpr int SpawnX = W / 2 - 2;
+
+        constexpr explicit Game(std::uint64_t seed = 0) noexcept
+            : rng(seed)
+        {
+            shape = next_shape();
+        }
+
+        [[nodiscard]] constexpr const PieceMask& piece() const noexcept { return PIECE_MASKS[std::size_t(shape)][std::size_t(rot)]; }
+
+        constexpr StepOutcome step(Action action) noexcept
+        {
+            StepOutcome result{};
+            if (over)
+            {
+                result.gameOver = true;
+                return result;
+            }
+
+            switch (action)
+            {
+            case Action::Left:
+                if (!board.collides(piece(), px - 1, py)) --px;
+                break;
+            case Action::Right:
+                if (!board.collides(piece(), px + 1, py)) ++px;
+                break;
+            case Action::Rotate:
+                if (const int r = (rot + 1) & 3; !board.collides(PIECE_MASKS[std::size_t(shape)][std::size_t(r)], px, py))
+                    rot = r;
+                break;
+            case Action::SoftDrop:
+                if (!board.collides(piece(), px, py + 1))
+                    ++py;
+                else
+                    lock(result);
+                break;
+            case Action::HardDrop:
+                py = board.drop_row(piece(), px, py);
+                lock(result);
+                break;
+            case Action::None:
+                break;
+            }
+            return result;
+        }
+
+        // Bot entry point: drop the current piece straight down at
+        // rotation `r`, column offset `x`. Illegal placements change nothing.
+        constexpr StepOutcome place(int r, int x) noexcept
+        {
+            const PieceMask& mask = PIECE_MASKS[std::size_t(shape)][std::size_t(r & 3)];
+            if (over || board.collides(mask, x, py))
+                return { false, 0, over };
+            rot = r & 3;
+            px = x;
+            return step(Action::HardDrop);
+        }
+
+    private:
+        constexpr int next_shape() noexcept
+        {
+            return int(rng.below(7));
+        }
+
+        constexpr void lock(StepOutcome& result) noexcept
+        {
+            board.place(piece(), px, py);
+            result.locked = true;
+            result.linesCleared = board.clear_lines();
+            lines += std::uint64_t(result.linesCleared);
+            ++pieces;
+
+            shape = next_shape();
+            rot = 0;
+            px = SpawnX;
+            py = 0;
+            if (board.collides(piece(), px, py))
+            {
+                over = true;
+                result.gameOver = true;
+            }
+        }
+    };
+
+    // ─── Rules for gamesim ────────────────────────────────────────
+    // Actions are the Action enum in order. Reward is lines cleared, and
+    // the episode ends when a piece cannot spawn.
+    template <int W, int H>
+    struct Rules
+    {
+        using State = Game<W, H>;
+        using Action = tetris::Action;
+
+        [[nodiscard]] State reset(std::uint64_t seed) const { return State(seed); }
+
+        gamesim::StepResult step(State& g, Action a) const
+        {
+            const StepOutcome o = g.step(a);
+            return { float(o.linesCleared), o.gameOver };
+        }
+
+        [[nodiscard]] std::size_t action_count() const noexcept { return 6; }
+        [[nodiscard]] Action action(std::size_t i) const noexcept { return static_cast<Action>(i % 6); }
+    };
+
+} // namespace almondnamespace::tetris
@@ -33,8 +33,11 @@
 #include "aatlasmanager.hpp"
 #include "aopengltextures.hpp"
 #include "aspritepool.hpp"
+#include "atetrisboard.hpp"
 
 #include <array>
+#include <bit>
+#include <cstdint>
 #include <random>
 #include <stdexcept>
 #include <span>
@@ -50,7 +53,7 @@ namespace almondnamespace::tetris
             Scene::load();
             if (!setup_sprites())
                 throw std::runtime_error("Failed to setup Tetris sprites");
-            state = {};
+            state = Game(std::random_device{}());
             timer = time::createTimer(0.25);
             time::setScale(timer, 0.25);
             acc = 0.0;
@@ -65,20 +68,18 @@ namespace almondnamespace::tetris
             if (ctx->is_key_down_safe(input::Key::Escape)) return false;
 
             // --- Input ---
-            if (ctx->is_key_down_safe(input::Key::Left) &&
-                !collides(state, state.px - 1, state.py, state.rot))
-                --state.px;
+            if (ctx->is_key_down_safe(input::Key::Left))
+                state.step(Action::Left);
 
-            if (ctx->is_key_down_safe(input::Key::Right) &&
-                !collides(state, state.px + 1, state.py, state.rot))
-                ++state.px;
+            if (ctx->is_key_down_safe(input::Key::Right))
+                state.step(Action::Right);
 
             if (ctx->is_key_down_safe(input::Key::Up))
-                state.rot = (state.rot + 1) % 4;
+                state.step(Action::Rotate);
 
             if (ctx->is_key_down_safe(input::Key::Down) &&
-                !collides(state, state.px, state.py + 1, state.rot))
-                ++state.py;
+                !state.board.collides(state.piece(), state.px, state.py + 1))
+                state.step(Action::SoftDrop);
 
             // --- Timing ---
             advance(timer, 0.016);
@@ -87,20 +88,9 @@ namespace almondnamespace::tetris
 
             while (acc >= STEP_S) {
                 acc -= STEP_S;
-                if (!collides(state, state.px, state.py + 1, state.rot)) {
-                    ++state.py;
-                }
-                else {
-                    place(state);
-                    clear_lines(state);
-                    state.shape = state.dist(state.rng);
-                    state.rot = 0;
-                    state.px = GRID_W / 2 - 2;
-                    state.py = 0;
-                    if (collides(state, state.px, state.py, state.rot)) {
-                        game_over = true;
-                        return false;
-                    }
+                if (state.step(Action::SoftDrop).gameOver) {
+                    game_over = true;
+                    return false;
                 }
             }
 
@@ -122,22 +112,8 @@ namespace almondnamespace::tetris
         static constexpr double STEP_S = 30.0;
 
         // === State ===
-        struct State {
-            gamecore::grid_t<int> grid;
-            int shape, rot;
-            int px, py;
-            std::mt19937_64 rng;
-            std::uniform_int_distribution<int> dist;
-            double accumulator = 0.0;
-
-            State()
-                : grid(gamecore::make_grid<int>(GRID_W, GRID_H, 0))
-                , shape(0), rot(0), px(GRID_W / 2 - 2), py(0)
-                , rng{ std::random_device{}() }
-                , dist(0, 6) {
-                shape = dist(rng);
-            }
-        } state;
+        using Game = tetris::Game<GRID_W, GRID_H>;
+        Game state{};
 
         time::Timer timer{};
         double acc = 0.0;
@@ -145,45 +121,6 @@ namespace almondnamespace::tetris
 
         static inline SpriteRegistry registry;
 
-        // === Tetromino definitions ===
-        static constexpr std::array<std::array<std::array<int, 16>, 4>, 7> TETRAMINOS = { {
-                // I
-                {{{0,1,0,0,  0,1,0,0,  0,1,0,0,  0,1,0,0},
-                  {0,0,0,0,  1,1,1,1,  0,0,0,0,  0,0,0,0},
-                  {0,0,1,0,  0,0,1,0,  0,0,1,0,  0,0,1,0},
-                  {0,0,0,0,  0,0,0,0,  1,1,1,1,  0,0,0,0}}},
-                  // O
-                  {{{0,0,0,0,  0,1,1,0,  0,1,1,0,  0,0,0,0},
-                    {0,0,0,0,  0,1,1,0,  0,1,1,0,  0,0,0,0},
-                    {0,0,0,0,  0,1,1,0,  0,1,1,0,  0,0,0,0},
-                    {0,0,0,0,  0,1,1,0,  0,1,1,0,  0,0,0,0}}},
-                    // T
-                    {{{0,0,0,0,  1,1,1,0,  0,1,0,0,  0,0,0,0},
-                      {0,0,1,0,  0,1,1,0,  0,0,1,0,  0,0,0,0},
-                      {0,0,0,0,  0,1,0,0,  1,1,1,0,  0,0,0,0},
-                      {0,1,0,0,  1,1,0,0,  0,1,0,0,  0,0,0,0}}},
-                      // S
-                      {{{0,0,0,0,  0,1,1,0,  1,1,0,0,  0,0,0,0},
-                        {0,1,0,0,  0,1,1,0,  0,0,1,0,  0,0,0,0},
-                        {0,0,0,0,  0,1,1,0,  1,1,0,0,  0,0,0,0},
-                        {0,1,0,0,  0,1,1,0,  0,0,1,0,  0,0,0,0}}},
-                        // Z
-                        {{{0,0,0,0,  1,1,0,0,  0,1,1,0,  0,0,0,0},
-                          {0,0,1,0,  0,1,1,0,  0,1,0,0,  0,0,0,0},
-                          {0,0,0,0,  1,1,0,0,  0,1,1,0,  0,0,0,0},
-                          {0,0,1,0,  0,1,1,0,  0,1,0,0,  0,0,0,0}}},
-                          // J
-                          {{{0,0,0,0,  1,0,0,0,  1,1,1,0,  0,0,0,0},
-                            {0,0,1,1,  0,0,1,0,  0,0,1,0,  0,0,0,0},
-                            {0,0,0,0,  1,1,1,0,  0,0,1,0,  0,0,0,0},
-                            {0,0,1,0,  0,0,1,0,  0,1,1,0,  0,0,0,0}}},
-                            // L
-                            {{{0,0,0,0,  0,0,1,0,  1,1,1,0,  0,0,0,0},
-                              {0,0,1,0,  0,0,1,0,  0,0,1,1,  0,0,0,0},
-                              {0,0,0,0,  1,1,1,0,  1,0,0,0,  0,0,0,0},
-                              {0,1,1,0,  0,0,1,0,  0,0,1,0,  0,0,0,0}}}
-                        } };
-
         // === Helpers ===
         inline bool setup_sprites() {
             const auto blockImg = a_loadImage("assets/atestimage.ppm", true);
@@ -220,53 +157,6 @@ namespace almondnamespace::tetris
             return true;
         }
 
-        inline bool collides(const State& s, int nx, int ny, int r) {
-            for (int i = 0; i < 4; ++i)
-                for (int j = 0; j < 4; ++j) {
-                    int v = TETRAMINOS[s.shape][r][i * 4 + j];
-                    if (!v) continue;
-                    int gx = nx + j;
-                    int gy = ny + i;
-                    if (!gamecore::in_bounds(GRID_W, GRID_H, gx, gy) ||
-                        gamecore::at(s.grid, GRID_W, GRID_H, gx, gy)) return true;
-                }
-            return false;
-        }
-
-        inline void place(State& s) {
-            for (int i = 0; i < 4; ++i)
-                for (int j = 0; j < 4; ++j) {
-                    if (TETRAMINOS[s.shape][s.rot][i * 4 + j]) {
-                        int gx = s.px + j;
-                        int gy = s.py + i;
-                        if (gamecore::in_bounds(GRID_W, GRID_H, gx, gy))
-                            gamecore::at(s.grid, GRID_W, GRID_H, gx, gy) = s.shape + 1;
-                    }
-                }
-        }
-
-        inline void clear_lines(State& s) {
-            for (int y = GRID_H - 1; y >= 0; --y) {
-                bool full = true;
-                for (int x = 0; x < GRID_W; ++x) {
-                    if (!gamecore::at(s.grid, GRID_W, GRID_H, x, y)) {
-                        full = false;
-                        break;
-                    }
-                }
-                if (full) {
-                    for (int ny = y; ny > 0; --ny)
-                        for (int x = 0; x < GRID_W; ++x)
-                            gamecore::at(s.grid, GRID_W, GRID_H, x, ny) =
-                            gamecore::at(s.grid, GRID_W, GRID_H, x, ny - 1);
-
-                    for (int x = 0; x < GRID_W; ++x)
-                        gamecore::at(s.grid, GRID_W, GRID_H, x, 0) = 0;
-                    ++y; // re-check after shifting
-                }
-            }
-        }
-
         inline void draw(std::shared_ptr<core::Context> ctx) {
             float cw = float(ctx->get_width_safe()) / GRID_W;
             float ch = float(ctx->get_height_safe()) / GRID_H;
@@ -280,24 +170,22 @@ namespace almondnamespace::tetris
             auto& atlasVec = atlasmanager::get_atlas_vector();
             std::span<const TextureAtlas* const> atlasSpan(atlasVec.data(), atlasVec.size());
 
-            // Placed blocks
+            // Placed blocks: set bits only
             for (int y = 0; y < GRID_H; ++y) {
-                float py = y * ch;
-                for (int x = 0; x < GRID_W; ++x) {
-                    if (gamecore::at(state.grid, GRID_W, GRID_H, x, y)) {
-                        ctx->draw_sprite_safe(handle, atlasSpan, x * cw, py, cw, ch);
-                    }
+                const float py = y * ch;
+                for (std::uint64_t bits = state.board.rows[std::size_t(y)]; bits; bits &= bits - 1) {
+                    const int x = std::countr_zero(bits);
+                    ctx->draw_sprite_safe(handle, atlasSpan, x * cw, py, cw, ch);
                 }
             }
 
             // Falling tetromino
-            for (int i = 0; i < 4; ++i) {
-                for (int j = 0; j < 4; ++j) {
-                    if (TETRAMINOS[state.shape][state.rot][i * 4 + j]) {
-                        float dx = (state.px + j) * cw;
-                        float dy = (state.py + i) * ch;
-                        ctx->draw_sprite_safe(handle, atlasSpan, dx, dy, cw, ch);
-                    }
+            const PieceMask& piece = state.piece();
+            for (int i = piece.minRow; i <= piece.maxRow; ++i) {
+                for (unsigned bits = piece.rows[std::size_t(i)]; bits; bits &= bits - 1) {
+                    const float dx = (state.px + std::countr_zero(bits)) * cw;
+                    const float dy = (state.py + i) * ch;
+                    ctx->draw_sprite_safe(handle, atlasSpan, dx, dy, cw, ch);
                 }
             }
         }
@@ -0,0 +1,302 @@
+﻿/**************************************************************
+ *   █████╗ ██╗     ███╗   ███╗   ███╗   ██╗    ██╗██████╗    *
+ *  ██╔══██╗██║     ████╗ ████║ ██╔═══██╗████╗  ██║██╔══██╗   *
+ *  ███████║██║     ██╔████╔██║ ██║   ██║██╔██╗ ██║██║  ██║   *
+ *  ██╔══██║██║     ██║╚██╔╝██║ ██║   ██║██║╚██╗██║██║  ██║   *
+ *  ██║  ██║███████╗██║ ╚═╝ ██║ ╚██████╔╝██║ ╚████║██████╔╝   *
+ *  ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝    *
+ *                                                            *
+ *   This file is part of the Almond Project.                 *
+ *   AlmondShell - Modular C++ Framework                      *
+ *                                                            *
+ *   SPDX-License-Identifier: LicenseRef-MIT-NoSell           *
+ *                                                            *
+ *   Provided "AS IS", without warranty of any kind.          *
+ *   Use permitted for Non-Commercial Purposes ONLY,          *
+ *   without prior commercial licensing agreement.            *
+ *                                                            *
+ *   Redistribution Allowed with This Notice and              *
+ *   LICENSE file. No obligation to disclose modifications.   *
+ *                                                            *
+ *   See LICENSE file for full terms.                         *
+ *                                                            *
+ **************************************************************/
+ // atextureresidency.hpp
+#pragma once
+
+#include "aplatform.hpp"
+#include "aengineconfig.hpp"
+
+#include "aatlastexture.hpp"
+#include "acommandline.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace almondnamespace::residency
+{
+    class ResidencyManager;
+
+    namespace detail
+    {
+        inline std::mutex registryMutex;
+        inline std::vector<ResidencyManager*> managers;
+    }
+
+    inline void forget_everywhere(const TextureAtlas* atlas);
+
+    // What a backend holds for an atlas: no texture at all, or a texture
+    // holding the atlas pixels as of `version`.
+    struct GpuCopy
+    {
+        bool present = false;
+        u64 version = 0;
+    };
+
+    // Tracks which atlases a backend holds in video memory and evicts the
+    // least recently drawn ones once the VRAM budget is exceeded. Evicted
+    // atlases keep their CPU `pixel_data`, so the next draw simply re-uploads
+    // them; re-uploads are spread across frames by a per-frame upload budget
+    // so bringing a scene back does not stall a single frame.
+    //
+    // One manager per backend, shared by every window (context) of that
+    // backend: the VRAM budget and the upload allowance are per backend, not
+    // per window. `begin_frame()` runs on the backend's render thread (where
+    // texture deletion is legal) and is the only place the eviction callback
+    // fires. Every window calls it, but the LRU clock only advances when a
+    // window comes back for its next frame, so one tick covers all windows. Destroyed atlases are forgotten by every manager automatically
+    // (see `atlas_released_hook`).
+    class ResidencyManager
+    {
+    public:
+        using Key = const TextureAtlas*;
+        using EvictFn = std::function<void(Key)>;
+
+        static constexpr std::size_t DefaultUploadBudgetBytes = 16u * 1024u * 1024u;
+
+        ResidencyManager(std::string backend, EvictFn evictor)
+            : backendName(std::move(backend)), evict(std::move(evictor))
+        {
+            std::scoped_lock lock(detail::registryMutex);
+            detail::managers.push_back(this);
+            atlas_released_hook.store(&forget_everywhere, std::memory_order_release);
+        }
+
+        ~ResidencyManager()
+        {
+            std::scoped_lock lock(detail::registryMutex);
+            std::erase(detail::managers, this);
+        }
+
+        ResidencyManager(const ResidencyManager&) = delete;
+        ResidencyManager& operator=(const ResidencyManager&) = delete;
+
+        // 0 = follow `cli::vram_budget_mb` (which may itself be 0 = unlimited).
+        void set_budget_bytes(std::size_t bytes) noexcept
+        {
+            std::scoped_lock lock(mutex);
+            budgetOverride = bytes;
+        }
+
+        void set_upload_budget_bytes(std::size_t bytes) noexcept
+        {
+            std::scoped_lock lock(mutex);
+            uploadBudget = bytes;
+        }
+
+        [[nodiscard]] static std::size_t atlas_bytes(const TextureAtlas& atlas) noexcept
+        {
+            return static_cast<std::size_t>(atlas.width) * atlas.height * 4u;
+        }
+
+        // Called by each window before it draws. The first window to come
+        // back for another frame starts a new backend tick: resets the upload
+        // allowance and evicts LRU atlases that were not drawn last tick
+        // until the budget is met. Other windows just join the current tick.
+        void begin_frame(const void* window)
+        {
+            std::vector<Key> victims;
+            std::vector<std::string> victimNames; // copied while the atlases are still tracked
+            std::vector<Key> released;
+            {
+                std::scoped_lock lock(mutex);
+                if (std::find(tickWindows.begin(), tickWindows.end(), window) == tickWindows.end()) {
+                    tickWindows.push_back(window);
+                    return;
+                }
+                tickWindows.assign(1, window);
+                released.swap(forgotten);
+                ++frame;
+                uploadedThisFrame = 0;
+                uploadsThisFrame = 0;
+
+                const std::size_t budget = effective_budget();
+                while (budget && residentBytes > budget && !lru.empty()) {
+                    const Entry& oldest = lru.back();
+                    if (oldest.lastUsedFrame + 1 >= frame)
+                        break; // everything left was drawn last tick; over budget but in use
+                    residentBytes -= oldest.bytes;
+                    victims.push_back(oldest.atlas);
+                    if (core::cli::trace_residency)
+                        victimNames.push_back(oldest.atlas->name);
+                    index.erase(oldest.atlas);
+                    lru.pop_back();
+                    ++evictionCount;
+                }
+            }
+
+            // The atlases behind these keys are gone; only free their textures.
+            for (Key atlas : released)
+                if (evict) evict(atlas);
+
+            // Keys only from here on: an atlas may be destroyed as soon as
+            // the lock is released.
+            for (Key atlas : victims)
+                if (evict) evict(atlas);
+            for (const std::string& name : victimNames)
+                std::cerr << "[Residency] " << backendName << " evicted atlas '" << name << "'\n";
+        }
+
+        // Bytes an upload from `fromVersion` sends: the dirty rect when the
+        // atlas still knows what changed, otherwise the whole atlas.
+        [[nodiscard]] static std::size_t update_bytes(const TextureAtlas& atlas, u64 fromVersion)
+        {
+            if (const auto dirty = atlas.dirty_since(fromVersion))
+                return static_cast<std::size_t>(dirty->rect.width) * dirty->rect.height * 4u;
+            return atlas_bytes(atlas);
+        }
+
+        // Draw-path entry point. A missing texture is uploaded if this tick's
+        // staging allowance permits; otherwise returns false and the caller
+        // skips the draw. A present but stale texture is charged only for
+        // its dirty bytes and, when the allowance is spent, is drawn as-is
+        // and refreshed on a later tick, so a resident atlas is never dropped.
+        template <typename UploadFn>
+        bool acquire(const TextureAtlas& atlas, GpuCopy copy, UploadFn&& upload)
+        {
+            if (!copy.present) {
+                if (!reserve_upload(atlas_bytes(atlas)))
+                    return false;
+                upload();
+            }
+            else if (copy.version != atlas.version) {
+                if (reserve_upload(update_bytes(atlas, copy.version)))
+                    upload();
+            }
+            mark_used(&atlas, atlas_bytes(atlas));
+            return true;
+        }
+
+        void mark_used(Key atlas, std::size_t bytes)
+        {
+            std::scoped_lock lock(mutex);
+            auto it = index.find(atlas);
+            if (it == index.end()) {
+                lru.push_front({ atlas, bytes, frame });
+                index.emplace(atlas, lru.begin());
+                residentBytes += bytes;
+                return;
+            }
+            auto node = it->second;
+            residentBytes = residentBytes - node->bytes + bytes;
+            node->bytes = bytes;
+            node->lastUsedFrame = frame;
+            lru.splice(lru.begin(), lru, node);
+        }
+
+        // The first upload of a tick is always allowed so a single atlas
+        // larger than the allowance can still make progress.
+        bool reserve_upload(std::size_t bytes)
+        {
+            std::scoped_lock lock(mutex);
+            if (uploadsThisFrame > 0 && uploadedThisFrame + bytes > uploadBudget)
+                return false;
+            uploadedThisFrame += bytes;
+            ++uploadsThisFrame;
+            return true;
+        }
+
+        // Stops tracking an atlas that was destroyed or overwritten; its
+        // texture is freed at the next begin_frame(). The key is never
+        // dereferenced again.
+        void forget(Key atlas)
+        {
+            std::scoped_lock lock(mutex);
+            auto it = index.find(atlas);
+            if (it == index.end())
+                return;
+            residentBytes -= it->second->bytes;
+            lru.erase(it->second);
+            index.erase(it);
+            forgotten.push_back(atlas);
+        }
+
+        void clear()
+        {
+            std::scoped_lock lock(mutex);
+            lru.clear();
+            index.clear();
+            forgotten.clear();
+            residentBytes = 0;
+        }
+
+        [[nodiscard]] std::size_t resident_bytes() const
+        {
+            std::scoped_lock lock(mutex);
+            return residentBytes;
+        }
+
+        [[nodiscard]] std::uint64_t evictions() const
+        {
+            std::scoped_lock lock(mutex);
+            return evictionCount;
+        }
+
+    private:
+        struct Entry
+        {
+            Key atlas = nullptr;
+            std::size_t bytes = 0;
+            std::uint64_t lastUsedFrame = 0;
+        };
+
+        std::size_t effective_budget() const noexcept
+        {
+            if (budgetOverride)
+                return budgetOverride;
+            return static_cast<std::size_t>((std::max)(0, core::cli::vram_budget_mb)) * 1024u * 1024u;
+        }
+
+        std::string backendName;
+        EvictFn evict;
+
+        mutable std::mutex mutex;
+        std::list<Entry> lru; // front = most recently used
+        std::unordered_map<Key, std::list<Entry>::iterator> index;
+        std::vector<Key> forgotten; // released atlases awaiting texture cleanup
+        std::vector<const void*> tickWindows; // windows that began the current tick
+        std::size_t residentBytes = 0;
+        std::size_t budgetOverride = 0;
+        std::size_t uploadBudget = DefaultUploadBudgetBytes;
+        std::size_t uploadedThisFrame = 0;
+        std::size_t uploadsThisFrame = 0;
+        std::uint64_t frame = 1;
+        std::uint64_t evictionCount = 0;
+    };
+
+    inline void forget_everywhere(const TextureAtlas* atlas)
+    {
+        std::scoped_lock lock(detail::registryMutex);
+        for (ResidencyManager* manager : detail::managers)
+            manager->forget(atlas);
+    }
+}
@@ -38,9 +38,7 @@
 
 #if defined(ALMOND_USING_VULKAN)
 
-#define STB_IMAGE_IMPLEMENTATION
-
-#include <src/stb/stb_image.h>
+#include "../src/stb/stb_image.h"
 /*
 #include <GLFW/glfw3.h>
 #include <vulkan/vulkan.h>
@@ -12,7 +12,10 @@ export import "aapplicationmodule.hpp";
 export import "aenduserapplication.hpp";
 export import "awindowdata.hpp";
 export import "acontext.hpp";
+export import "adrawlist.hpp";
 export import "acontextmultiplexer.hpp";
 export import "acontextwindow.hpp";
 export import "ainput.hpp";
+export import "aframepacer.hpp";
+export import "afixedtimestep.hpp";
 export import "aversion.hpp";
@@ -10,6 +10,7 @@ export import "asfmlcontext.hpp";
 #endif
 #ifdef ALMOND_USING_SOFTWARE_RENDERER
 export import "asoftrenderer_context.hpp";
+export import "asoftrenderer_headless.hpp";
 #endif
 #ifdef ALMOND_USING_RAYLIB
 export import "araylibcontext.hpp";
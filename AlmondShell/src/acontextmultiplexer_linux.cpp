@@ -20,6 +20,8 @@
 #if defined(ALMOND_USING_SOFTWARE_RENDERER)
 #include "asoftrenderer_context.hpp"
 #endif
+#include "acommandline.hpp"
+#include "aframepacer.hpp"
 
 #include <X11/Xatom.h>
 #include <X11/extensions/Xrandr.h>
@@ -1188,6 +1190,8 @@ namespace almondnamespace::core
             return;
         }
 
+        time::FramePacer pacer{ cli::target_fps };
+
         while (running.load(std::memory_order_acquire) && win.running)
         {
             bool keepRunning = true;
@@ -1206,9 +1210,11 @@ namespace almondnamespace::core
                 break;
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            pacer.end_frame(ctx->presentIsVsynced);
         }
 
+        pacer.histogram().print_summary(ctx->backendName);
+
         if (ctx->cleanup)
         {
             ctx->cleanup_safe();
@@ -22,6 +22,7 @@
 #include "araylibcontext.hpp"
 #include "asoftrenderer_context.hpp"
 #include "acommandline.hpp"
+#include "aframepacer.hpp"
 
 #include <stdexcept>
 #include <algorithm>
@@ -1092,7 +1093,9 @@ namespace almondnamespace::core
             return;
         }
 
-        // Main per-window loop
+        // Main per-window loop, paced to the target rate unless the
+        // backend's present already waits on vblank
+        time::FramePacer pacer{ cli::target_fps };
         while (running && win.running) {
             bool keepRunning = true;
 
@@ -1111,9 +1114,11 @@ namespace almondnamespace::core
                 break;
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
+            pacer.end_frame(ctx->presentIsVsynced);
         }
 
+        pacer.histogram().print_summary(ctx->backendName);
+
         // Cleanup
         if (ctx->cleanup) {
             ctx->cleanup_safe();
@@ -163,7 +163,81 @@ namespace almondnamespace::core
             };
             init_menu();
 
-            std::unordered_map<almondnamespace::core::Context*, std::chrono::steady_clock::time_point> lastFrameTimes;
+            almondnamespace::time::FramePacer pacer{ cli::target_fps };
+            almondnamespace::time::FixedTimestep fixedStep{ static_cast<double>(cli::tick_rate) };
+
+            auto find_window = [&](const std::shared_ptr<almondnamespace::core::Context>& ctx) {
+                auto* win = mgr.findWindowByHWND(ctx->hwnd);
+                if (!win)
+                    win = mgr.findWindowByContext(ctx);
+                return win;
+            };
+
+            // Active scenes run frame() once per loop against a recording
+            // context; every context then replays the resulting draw list on
+            // its own render thread. Keyboard and mouse buttons are global
+            // input state, so they reach the scene from any window. The mouse
+            // position is per window: the recording context follows the window
+            // the pointer is over (the first live window otherwise), and the
+            // frame is recorded at that window's size.
+            std::shared_ptr<almondnamespace::core::Context> recordingCtx;
+            almondnamespace::core::Context* recordingSource = nullptr;
+            std::size_t lastDrawCount = 0;
+
+            auto pointer_inside = [](const almondnamespace::core::Context& ctx) {
+                int mx = -1, my = -1;
+                ctx.get_mouse_position_safe(mx, my);
+                return mx >= 0 && my >= 0 && mx < ctx.get_width_safe() && my < ctx.get_height_safe();
+            };
+
+            auto record_scene_frame = [&](const auto& backendContexts)
+                -> std::shared_ptr<const almondnamespace::core::DrawList> {
+                std::shared_ptr<almondnamespace::core::Context> ctx;
+                almondnamespace::core::WindowData* win = nullptr;
+                bool hovered = false;
+                for (auto& [_, contexts] : backendContexts) {
+                    for (auto& candidate : contexts) {
+                        if (!candidate) continue;
+                        auto* candidateWin = find_window(candidate);
+                        if (!candidateWin) continue;
+                        hovered = pointer_inside(*candidate);
+                        if (!ctx || hovered) {
+                            ctx = candidate;
+                            win = candidateWin;
+                        }
+                        if (hovered) break;
+                    }
+                    if (hovered) break;
+                }
+                if (!ctx)
+                    return nullptr;
+
+                if (recordingSource != ctx.get()) {
+                    recordingCtx = almondnamespace::core::make_recording_context(ctx);
+                    recordingSource = ctx.get();
+                }
+                recordingCtx->width = ctx->width;
+                recordingCtx->height = ctx->height;
+
+                auto list = std::make_shared<almondnamespace::core::DrawList>();
+                list->reserve(lastDrawCount);
+                bool sceneRunning = true;
+                {
+                    almondnamespace::core::DrawListRecorder recorder(*list,
+                        ctx->get_width_safe(), ctx->get_height_safe());
+                    sceneRunning = g_activeScene->frame(recordingCtx, win);
+                }
+                lastDrawCount = list->size();
+
+                if (!sceneRunning) {
+                    g_activeScene->unload();
+                    g_activeScene.reset();
+                    g_sceneID = SceneID::Menu;
+                    init_menu();
+                    return nullptr;
+                }
+                return list;
+            };
 
             bool running = true;
 
@@ -173,27 +247,30 @@ namespace almondnamespace::core
                     break;
                 }
 
+                // Simulation advances once per loop at the fixed tick rate, no
+                // matter how many contexts render the active scene below.
+                fixedStep.advance([&](double dt) {
+                    if (g_activeScene) g_activeScene->update(dt);
+                });
+                if (g_activeScene)
+                    g_activeScene->setInterpolationAlpha(fixedStep.alpha());
+                const float dtSeconds = static_cast<float>(fixedStep.frame_seconds());
+
                 auto backendContexts = collect_backend_contexts();
+
+                std::shared_ptr<const almondnamespace::core::DrawList> sceneDraws;
+                if (g_activeScene && g_sceneID != SceneID::Menu && g_sceneID != SceneID::Exit)
+                    sceneDraws = record_scene_frame(backendContexts);
+
                 for (auto& [type, contexts] : backendContexts) {
                     auto update_on_ctx = [&](std::shared_ptr<almondnamespace::core::Context> ctx) -> bool {
                         if (!ctx) return true;
-                        auto* win = mgr.findWindowByHWND(ctx->hwnd);
-                        if (!win)
-                            win = mgr.findWindowByContext(ctx);
+                        auto* win = find_window(ctx);
                         if (!win)
                             return true; // window not ready yet
 
                         bool ctxRunning = win->running;
 
-                        const auto now = std::chrono::steady_clock::now();
-                        const auto rawCtx = ctx.get();
-                        float dtSeconds = 0.0f;
-                        auto [timeIt, inserted] = lastFrameTimes.emplace(rawCtx, now);
-                        if (!inserted) {
-                            dtSeconds = std::chrono::duration<float>(now - timeIt->second).count();
-                            timeIt->second = now;
-                        }
-
                         auto begin_scene = [&](auto makeScene, SceneID id) {
                             auto clear_commands = [](const std::shared_ptr<almondnamespace::core::Context>& context) {
                                 if (context && context->windowData) {
@@ -287,14 +364,10 @@ namespace almondnamespace::core
                         case SceneID::Game2048:
                         case SceneID::Sandsim:
                         case SceneID::Cellular:
-                            if (g_activeScene) {
-                                ctxRunning = g_activeScene->frame(ctx, win);
-                                if (!ctxRunning) {
-                                    g_activeScene->unload();
-                                    g_activeScene.reset();
-                                    g_sceneID = SceneID::Menu;
-                                    init_menu();
-                                }
+                            if (sceneDraws) {
+                                win->commandQueue.enqueue([ctx, sceneDraws]() {
+                                    sceneDraws->replay(*ctx);
+                                });
                             }
                             break;
                         case SceneID::Exit:
@@ -302,10 +375,6 @@ namespace almondnamespace::core
                             break;
                         }
 
-                        if (!ctxRunning) {
-                            lastFrameTimes.erase(rawCtx);
-                        }
-
                         return ctxRunning;
                     };
 
@@ -337,9 +406,11 @@ namespace almondnamespace::core
 #endif
                 }
 
-                std::this_thread::sleep_for(std::chrono::milliseconds(16));
+                pacer.end_frame();
             }
 
+            pacer.histogram().print_summary("engine loop");
+
             if (g_activeScene) {
                 g_activeScene->unload();
                 g_activeScene.reset();
@@ -389,6 +460,63 @@ namespace almondnamespace::core
             return 0;
         }
 
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+        std::unique_ptr<almondnamespace::scene::Scene> MakeSceneByName(std::string_view name)
+        {
+            using namespace almondnamespace;
+            if (name == "snake") return std::make_unique<snake::SnakeScene>();
+            if (name == "tetris") return std::make_unique<tetris::TetrisScene>();
+            if (name == "pacman") return std::make_unique<pacman::PacmanScene>();
+            if (name == "sokoban") return std::make_unique<sokoban::SokobanScene>();
+            if (name == "match3") return std::make_unique<match3::Match3Scene>();
+            if (name == "sliding") return std::make_unique<sliding::SlidingScene>();
+            if (name == "minesweeper") return std::make_unique<minesweeper::MinesweeperScene>();
+            if (name == "2048") return std::make_unique<game2048::Game2048Scene>();
+            if (name == "sandsim") return std::make_unique<sandsim::SandSimScene>();
+            if (name == "cellular") return std::make_unique<cellular::CellularScene>();
+            return nullptr;
+        }
+
+        int RunHeadless()
+        {
+            auto scene = MakeSceneByName(cli::headless_scene);
+            if (!scene) {
+                std::cerr << "[Headless] Unknown scene '" << cli::headless_scene
+                    << "' (snake, tetris, pacman, sokoban, match3, sliding, minesweeper, 2048, sandsim, cellular)\n";
+                return -1;
+            }
+
+            almondnamespace::anativecontext::HeadlessRunConfig config{};
+            config.width = cli::window_width;
+            config.height = cli::window_height;
+            config.frames = cli::headless_frames;
+            config.captureDir = cli::headless_capture_dir;
+            config.captureEvery = cli::headless_capture_every;
+            config.captureExtension = "." + cli::headless_capture_format;
+
+            almondnamespace::anativecontext::HeadlessRunReport report{};
+            try {
+                report = almondnamespace::anativecontext::run_headless(*scene, config);
+            }
+            catch (const std::exception& ex) {
+                std::cerr << "[Headless] " << ex.what() << '\n';
+                return -1;
+            }
+
+            if (report.frames.empty()) {
+                std::cerr << "[Headless] No frames were rendered.\n";
+                return -1;
+            }
+
+            std::cout << "[Headless] " << cli::headless_scene << ": " << report.frames.size() << " frames"
+                << (report.sceneExited ? " (scene exited early)" : "")
+                << ", avg " << report.average_frame_ms() << " ms"
+                << ", p50 " << report.percentile_frame_ms(0.50) << " ms"
+                << ", p99 " << report.percentile_frame_ms(0.99) << " ms\n";
+            return 0;
+        }
+#endif
+
 #if defined(_WIN32)
         int RunEngineMainLoopInternal(HINSTANCE hInstance, int nCmdShow)
         {
@@ -493,6 +621,18 @@ namespace almondnamespace::core
 
     void RunEngine()
     {
+        if (!cli::headless_scene.empty()) {
+#if defined(ALMOND_USING_SOFTWARE_RENDERER)
+            const int result = RunHeadless();
+            if (result != 0) {
+                std::cerr << "[Engine] Headless run terminated with code " << result << "\n";
+            }
+#else
+            std::cerr << "[Engine] --headless requires the software renderer backend.\n";
+#endif
+            return;
+        }
+
 #if defined(_WIN32)
     #if defined(RUN_CODE_INSPECTOR)
         using namespace almondnamespace;
@@ -37,10 +37,120 @@ namespace almondnamespace::font
 
             return buffer;
         }
+
+        constexpr std::array<std::pair<int, int>, 2> kBakedRanges{ {
+            {32, 126},        // Basic Latin
+            {160, 255}        // Latin-1 Supplement
+        } };
+
+        // Distance fields cannot go through stbtt_PackFontRanges, so each
+        // glyph is generated on its own and shelf-packed into the texture.
+        template <typename BakedGlyph>
+        bool bake_sdf_glyphs(const stbtt_fontinfo& font,
+            float scale,
+            const SdfParams& sdf,
+            std::vector<std::pair<char32_t, BakedGlyph>>& out_glyphs,
+            FontMetrics& out_metrics,
+            Texture& out_texture)
+        {
+            struct Field
+            {
+                char32_t codepoint = 0;
+                unsigned char* pixels = nullptr;
+                int width = 0;
+                int height = 0;
+                int xoff = 0;
+                int yoff = 0;
+                int x = 0;
+                int y = 0;
+                float advance = 0.0f;
+            };
+
+            constexpr int pack_width = 1024;
+            constexpr int gap = 1;
+            std::vector<Field> fields;
+            int pen_x = 0;
+            int pen_y = 0;
+            int row_height = 0;
+
+            for (const auto& [first, last] : kBakedRanges)
+            {
+                for (int cp = first; cp <= last; ++cp)
+                {
+                    Field f{};
+                    f.codepoint = static_cast<char32_t>(cp);
+                    f.pixels = stbtt_GetCodepointSDF(&font, scale, cp, sdf.padding, sdf.edge,
+                        sdf.pixel_dist_scale(), &f.width, &f.height, &f.xoff, &f.yoff);
+                    int advance = 0;
+                    int lsb = 0;
+                    stbtt_GetCodepointHMetrics(&font, cp, &advance, &lsb);
+                    f.advance = static_cast<float>(advance) * scale;
+
+                    if (f.pixels)
+                    {
+                        if (pen_x + f.width > pack_width)
+                        {
+                            pen_x = 0;
+                            pen_y += row_height + gap;
+                            row_height = 0;
+                        }
+                        f.x = pen_x;
+                        f.y = pen_y;
+                        pen_x += f.width + gap;
+                        row_height = (std::max)(row_height, f.height);
+                    }
+                    fields.push_back(f);
+                }
+            }
+
+            const int used_height = pen_y + row_height;
+            if (used_height <= 0)
+                return false;
+
+            out_texture.width = static_cast<std::uint32_t>(pack_width);
+            out_texture.height = static_cast<std::uint32_t>(used_height);
+            out_texture.channels = 4;
+            out_texture.pixels.assign(static_cast<std::size_t>(pack_width) * used_height * 4, 0);
+            for (std::size_t i = 0; i < out_texture.pixels.size(); i += 4)
+            {
+                out_texture.pixels[i + 0] = 255;
+                out_texture.pixels[i + 1] = 255;
+                out_texture.pixels[i + 2] = 255;
+            }
+
+            out_glyphs.reserve(fields.size());
+            for (Field& f : fields)
+            {
+                for (int row = 0; row < f.height && f.pixels; ++row)
+                {
+                    const std::size_t dst_row = (static_cast<std::size_t>(f.y + row) * pack_width + f.x) * 4;
+                    for (int col = 0; col < f.width; ++col)
+                        out_texture.pixels[dst_row + static_cast<std::size_t>(col) * 4 + 3] = f.pixels[row * f.width + col];
+                }
+                if (f.pixels)
+                    stbtt_FreeSDF(f.pixels, nullptr);
+
+                BakedGlyph baked{};
+                baked.glyph.size_px = { static_cast<float>(f.width), static_cast<float>(f.height) };
+                baked.glyph.offset_px = { static_cast<float>(f.xoff), static_cast<float>(f.yoff) };
+                baked.glyph.advance = f.advance;
+                baked.x0 = f.x;
+                baked.y0 = f.y;
+                baked.x1 = f.x + f.width;
+                baked.y1 = f.y + f.height;
+
+                out_metrics.maxAdvance = (std::max)(out_metrics.maxAdvance, f.advance);
+                if (f.codepoint == U' ')
+                    out_metrics.spaceAdvance = f.advance;
+                out_glyphs.emplace_back(f.codepoint, std::move(baked));
+            }
+            return true;
+        }
     }
 
     bool FontRenderer::load_and_bake_font(const std::string& ttf_path,
         float size_pt,
+        const FontLoadOptions& options,
         std::vector<std::pair<char32_t, BakedGlyph>>& out_glyphs,
         FontMetrics& out_metrics,
         std::unordered_map<std::uint64_t, float>& out_kerning,
@@ -90,125 +200,135 @@ namespace almondnamespace::font
         out_metrics.lineGap = static_cast<float>(raw_line_gap) * scale;
         out_metrics.lineHeight = out_metrics.ascent + out_metrics.descent + out_metrics.lineGap;
 
-        constexpr int pack_width = 1024;
-        constexpr int pack_height = 1024;
-        std::vector<unsigned char> mono_bitmap(static_cast<std::size_t>(pack_width) * pack_height, 0);
-
-        stbtt_pack_context pack_context{};
-        if (!stbtt_PackBegin(&pack_context, mono_bitmap.data(), pack_width, pack_height, pack_width, 1, nullptr))
+        if (options.signedDistanceField)
         {
-            std::cerr << "[FontRenderer] Failed to begin packing for font '" << ttf_path << "'\n";
-            return false;
+            if (!bake_sdf_glyphs(font, scale, options.sdf, out_glyphs, out_metrics, out_texture))
+            {
+                std::cerr << "[FontRenderer] Distance-field bake for font '" << ttf_path << "' is empty\n";
+                return false;
+            }
         }
-        stbtt_PackSetOversampling(&pack_context, 2, 2);
+        else
+        {
+            constexpr int pack_width = 1024;
+            constexpr int pack_height = 1024;
+            std::vector<unsigned char> mono_bitmap(static_cast<std::size_t>(pack_width) * pack_height, 0);
 
-        const std::array<std::pair<int, int>, 2> ranges_info{ {
-            {32, 126},        // Basic Latin
-            {160, 255}        // Latin-1 Supplement
-        } };
+            stbtt_pack_context pack_context{};
+            if (!stbtt_PackBegin(&pack_context, mono_bitmap.data(), pack_width, pack_height, pack_width, 1, nullptr))
+            {
+                std::cerr << "[FontRenderer] Failed to begin packing for font '" << ttf_path << "'\n";
+                return false;
+            }
+            stbtt_PackSetOversampling(&pack_context, 2, 2);
 
-        std::size_t total_chars = 0;
-        for (const auto& range : ranges_info)
-            total_chars += static_cast<std::size_t>(range.second - range.first + 1);
+            const auto& ranges_info = kBakedRanges;
 
-        std::vector<stbtt_packedchar> packed_chars(total_chars);
-        std::vector<stbtt_pack_range> pack_ranges(ranges_info.size());
+            std::size_t total_chars = 0;
+            for (const auto& range : ranges_info)
+                total_chars += static_cast<std::size_t>(range.second - range.first + 1);
 
-        std::size_t packed_offset = 0;
-        for (std::size_t i = 0; i < ranges_info.size(); ++i)
-        {
-            const auto [first_codepoint, last_codepoint] = ranges_info[i];
-            const int glyph_count = last_codepoint - first_codepoint + 1;
-
-            pack_ranges[i].font_size = size_pt;
-            pack_ranges[i].first_unicode_codepoint_in_range = first_codepoint;
-            pack_ranges[i].array_of_unicode_codepoints = nullptr;
-            pack_ranges[i].num_chars = glyph_count;
-            pack_ranges[i].chardata_for_range = packed_chars.data() + packed_offset;
-            pack_ranges[i].h_oversample = 2;
-            pack_ranges[i].v_oversample = 2;
-
-            packed_offset += static_cast<std::size_t>(glyph_count);
-        }
+            std::vector<stbtt_packedchar> packed_chars(total_chars);
+            std::vector<stbtt_pack_range> pack_ranges(ranges_info.size());
 
-        if (!stbtt_PackFontRanges(&pack_context, font_buffer.data(), 0, pack_ranges.data(), static_cast<int>(pack_ranges.size())))
-        {
-            stbtt_PackEnd(&pack_context);
-            std::cerr << "[FontRenderer] Failed to pack glyph ranges for font '" << ttf_path << "'\n";
-            return false;
-        }
+            std::size_t packed_offset = 0;
+            for (std::size_t i = 0; i < ranges_info.size(); ++i)
+            {
+                const auto [first_codepoint, last_codepoint] = ranges_info[i];
+                const int glyph_count = last_codepoint - first_codepoint + 1;
+
+                pack_ranges[i].font_size = size_pt;
+                pack_ranges[i].first_unicode_codepoint_in_range = first_codepoint;
+                pack_ranges[i].array_of_unicode_codepoints = nullptr;
+                pack_ranges[i].num_chars = glyph_count;
+                pack_ranges[i].chardata_for_range = packed_chars.data() + packed_offset;
+                pack_ranges[i].h_oversample = 2;
+                pack_ranges[i].v_oversample = 2;
+
+                packed_offset += static_cast<std::size_t>(glyph_count);
+            }
 
-        stbtt_PackEnd(&pack_context);
+            if (!stbtt_PackFontRanges(&pack_context, font_buffer.data(), 0, pack_ranges.data(), static_cast<int>(pack_ranges.size())))
+            {
+                stbtt_PackEnd(&pack_context);
+                std::cerr << "[FontRenderer] Failed to pack glyph ranges for font '" << ttf_path << "'\n";
+                return false;
+            }
 
-        int max_x1 = 0;
-        int max_y1 = 0;
-        for (const auto& packed : packed_chars)
-        {
-            max_x1 = (std::max)(max_x1, static_cast<int>(packed.x1));
-            max_y1 = (std::max)(max_y1, static_cast<int>(packed.y1));
-        }
+            stbtt_PackEnd(&pack_context);
 
-        if (max_x1 <= 0 || max_y1 <= 0)
-        {
-            std::cerr << "[FontRenderer] Packed bitmap for font '" << ttf_path << "' is empty\n";
-            return false;
-        }
+            int max_x1 = 0;
+            int max_y1 = 0;
+            for (const auto& packed : packed_chars)
+            {
+                max_x1 = (std::max)(max_x1, static_cast<int>(packed.x1));
+                max_y1 = (std::max)(max_y1, static_cast<int>(packed.y1));
+            }
+
+            if (max_x1 <= 0 || max_y1 <= 0)
+            {
+                std::cerr << "[FontRenderer] Packed bitmap for font '" << ttf_path << "' is empty\n";
+                return false;
+            }
 
-        max_x1 = (std::min)(max_x1, pack_width);
-        max_y1 = (std::min)(max_y1, pack_height);
+            max_x1 = (std::min)(max_x1, pack_width);
+            max_y1 = (std::min)(max_y1, pack_height);
 
-        out_texture.width = static_cast<std::uint32_t>(max_x1);
-        out_texture.height = static_cast<std::uint32_t>(max_y1);
-        out_texture.channels = 4;
-        out_texture.pixels.assign(static_cast<std::size_t>(out_texture.width) * out_texture.height * 4, 0);
+            out_texture.width = static_cast<std::uint32_t>(max_x1);
+            out_texture.height = static_cast<std::uint32_t>(max_y1);
+            out_texture.channels = 4;
+            out_texture.pixels.assign(static_cast<std::size_t>(out_texture.width) * out_texture.height * 4, 0);
 
-        for (std::uint32_t y = 0; y < out_texture.height; ++y)
-        {
-            for (std::uint32_t x = 0; x < out_texture.width; ++x)
+            for (std::uint32_t y = 0; y < out_texture.height; ++y)
             {
-                const unsigned char alpha = mono_bitmap[static_cast<std::size_t>(y) * pack_width + x];
-                const std::size_t idx = (static_cast<std::size_t>(y) * out_texture.width + x) * 4;
-                out_texture.pixels[idx + 0] = 255;
-                out_texture.pixels[idx + 1] = 255;
-                out_texture.pixels[idx + 2] = 255;
-                out_texture.pixels[idx + 3] = alpha;
+                for (std::uint32_t x = 0; x < out_texture.width; ++x)
+                {
+                    const unsigned char alpha = mono_bitmap[static_cast<std::size_t>(y) * pack_width + x];
+                    const std::size_t idx = (static_cast<std::size_t>(y) * out_texture.width + x) * 4;
+                    out_texture.pixels[idx + 0] = 255;
+                    out_texture.pixels[idx + 1] = 255;
+                    out_texture.pixels[idx + 2] = 255;
+                    out_texture.pixels[idx + 3] = alpha;
+                }
             }
-        }
 
-        out_glyphs.reserve(total_chars);
-        packed_offset = 0;
-        for (std::size_t range_index = 0; range_index < ranges_info.size(); ++range_index)
-        {
-            const auto [first_codepoint, last_codepoint] = ranges_info[range_index];
-            const int glyph_count = last_codepoint - first_codepoint + 1;
-            const stbtt_packedchar* range_chars = packed_chars.data() + packed_offset;
-
-            for (int glyph_index = 0; glyph_index < glyph_count; ++glyph_index)
+            out_glyphs.reserve(total_chars);
+            packed_offset = 0;
+            for (std::size_t range_index = 0; range_index < ranges_info.size(); ++range_index)
             {
-                const stbtt_packedchar& packed = range_chars[glyph_index];
+                const auto [first_codepoint, last_codepoint] = ranges_info[range_index];
+                const int glyph_count = last_codepoint - first_codepoint + 1;
+                const stbtt_packedchar* range_chars = packed_chars.data() + packed_offset;
 
-                BakedGlyph baked{};
-                baked.glyph.size_px = {
-                    static_cast<float>(packed.x1 - packed.x0),
-                    static_cast<float>(packed.y1 - packed.y0)
-                };
-                baked.glyph.offset_px = { packed.xoff, packed.yoff };
-                baked.glyph.advance = packed.xadvance;
-                baked.x0 = packed.x0;
-                baked.y0 = packed.y0;
-                baked.x1 = packed.x1;
-                baked.y1 = packed.y1;
-
-                out_metrics.maxAdvance = (std::max)(out_metrics.maxAdvance, baked.glyph.advance);
-                if (first_codepoint + glyph_index == 32)
+                for (int glyph_index = 0; glyph_index < glyph_count; ++glyph_index)
                 {
-                    out_metrics.spaceAdvance = baked.glyph.advance;
+                    const stbtt_packedchar& packed = range_chars[glyph_index];
+
+                    // x0..x1 spans the oversampled bitmap; xoff..xoff2 is its
+                    // footprint on screen, which is what the glyph is drawn at.
+                    BakedGlyph baked{};
+                    baked.glyph.size_px = {
+                        packed.xoff2 - packed.xoff,
+                        packed.yoff2 - packed.yoff
+                    };
+                    baked.glyph.offset_px = { packed.xoff, packed.yoff };
+                    baked.glyph.advance = packed.xadvance;
+                    baked.x0 = packed.x0;
+                    baked.y0 = packed.y0;
+                    baked.x1 = packed.x1;
+                    baked.y1 = packed.y1;
+
+                    out_metrics.maxAdvance = (std::max)(out_metrics.maxAdvance, baked.glyph.advance);
+                    if (first_codepoint + glyph_index == 32)
+                    {
+                        out_metrics.spaceAdvance = baked.glyph.advance;
+                    }
+
+                    out_glyphs.emplace_back(static_cast<char32_t>(first_codepoint + glyph_index), std::move(baked));
                 }
 
-                out_glyphs.emplace_back(static_cast<char32_t>(first_codepoint + glyph_index), std::move(baked));
+                packed_offset += static_cast<std::size_t>(glyph_count);
             }
-
-            packed_offset += static_cast<std::size_t>(glyph_count);
         }
 
         if (!out_glyphs.empty())
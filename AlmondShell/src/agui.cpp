@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cstdlib>
 #include <cstddef>
 #include <cstdint>
@@ -75,6 +76,7 @@ namespace
     {
         std::string fontName = kDefaultFontName;
         float fontSizePt = kDefaultFontSizePt;
+        font::FontId fontId = font::InvalidFontId;
         const font::FontAsset* asset = nullptr;
         const TextureAtlas* atlas = nullptr;
         font::FontMetrics metrics{};
@@ -230,7 +232,8 @@ namespace
             return;
         }
 
-        g_resources.font.asset = g_resources.fontRenderer.get_font(g_resources.font.fontName);
+        g_resources.font.fontId = g_resources.fontRenderer.resolve_font(g_resources.font.fontName);
+        g_resources.font.asset = g_resources.fontRenderer.get_font(g_resources.font.fontId);
         if (!g_resources.font.asset)
         {
             std::cerr << "[agui] Font renderer returned no asset for '" << g_resources.font.fontName << "'\n";
@@ -285,6 +288,134 @@ namespace
     static_assert(std::is_same_v<decltype(g_frame.ctx), core::Context*>,
         "FrameState must carry core::Context* ctx");
 
+    // ─── Retained window draw lists ─────────────────────────────────
+    // Every window keeps the draw list it built last frame. Widgets hash the
+    // inputs that shape their output (position, size, text, hover/active
+    // state) into a key; while the keys match the previous frame's, the
+    // widget skips layout and drawing and the cached commands are replayed.
+    // The first mismatch keeps the cached prefix and records the rest.
+    struct GuiDrawCmd
+    {
+        SpriteHandle sprite{};
+        float x = 0.0f, y = 0.0f, w = 0.0f, h = 0.0f;
+        std::shared_ptr<const font::GlyphRun> run{}; // set for text, sprite unused
+    };
+    using GuiDrawList = std::vector<GuiDrawCmd>;
+
+    struct WidgetRecord
+    {
+        std::uint64_t key = 0;
+        std::size_t end = 0;   // one past the widget's last command
+        Vec2 extent{};         // layout result the widget needs when reused
+    };
+
+    struct RetainedWindow
+    {
+        std::shared_ptr<const GuiDrawList> commands = std::make_shared<const GuiDrawList>();
+        std::vector<WidgetRecord> widgets{};
+        std::uint64_t lastFrame = 0;
+    };
+
+    struct WindowBuild
+    {
+        RetainedWindow* window = nullptr;
+        bool recording = false;  // diverged from the cached list this frame
+        GuiDrawList pending{};
+        std::vector<WidgetRecord> widgets{};
+    };
+
+    constexpr std::uint64_t kRetainedWindowTtl = 300; // frames a window may go undrawn before eviction
+
+    thread_local std::unordered_map<std::uint64_t, RetainedWindow> g_retainedWindows{};
+    thread_local WindowBuild g_build{};
+    thread_local std::uint64_t g_guiFrame = 0;
+
+    struct WidgetKey
+    {
+        std::uint64_t value = 14695981039346656037ull;
+
+        WidgetKey& mix(std::uint64_t v) noexcept
+        {
+            value ^= v + 0x9E3779B97F4A7C15ull + (value << 6) + (value >> 2);
+            return *this;
+        }
+        WidgetKey& mix(float v) noexcept { return mix(static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(v))); }
+        WidgetKey& mix(Vec2 v) noexcept { return mix(v.x).mix(v.y); }
+        WidgetKey& mix(bool v) noexcept { return mix(static_cast<std::uint64_t>(v ? 1u : 0u)); }
+        WidgetKey& mix(std::string_view text) noexcept
+        {
+            return mix(static_cast<std::uint64_t>(std::hash<std::string_view>{}(text))).mix(static_cast<std::uint64_t>(text.size()));
+        }
+        WidgetKey& mix(const SpriteHandle& handle) noexcept
+        {
+            return mix((static_cast<std::uint64_t>(handle.id) << 32) | handle.generation)
+                .mix((static_cast<std::uint64_t>(handle.atlasIndex) << 32) | handle.localIndex);
+        }
+    };
+
+    // Returns the previous frame's record when the widget can be reused
+    // as-is; nullptr means lay out and draw (the draws are recorded).
+    const WidgetRecord* begin_widget(std::uint64_t key)
+    {
+        auto& b = g_build;
+        if (!b.window)
+            return nullptr;
+
+        const std::size_t index = b.widgets.size();
+        b.widgets.push_back({ key, 0, {} });
+        if (b.recording)
+            return nullptr;
+
+        const auto& cached = b.window->widgets;
+        if (index < cached.size() && cached[index].key == key) {
+            b.widgets.back() = cached[index];
+            return &cached[index];
+        }
+
+        const std::size_t keep = index == 0 ? 0 : cached[index - 1].end;
+        b.pending.assign(b.window->commands->begin(), b.window->commands->begin() + static_cast<std::ptrdiff_t>(keep));
+        b.recording = true;
+        return nullptr;
+    }
+
+    void end_widget(Vec2 extent = {})
+    {
+        auto& b = g_build;
+        if (!b.window || !b.recording || b.widgets.empty())
+            return;
+        b.widgets.back().end = b.pending.size();
+        b.widgets.back().extent = extent;
+    }
+
+    void replay_draw_list(core::Context& ctx, const GuiDrawList& list)
+    {
+        const auto& atlases = almondnamespace::atlasmanager::get_atlas_vector();
+        for (const auto& cmd : list) {
+            if (cmd.run)
+                font::FontRenderer::submit_run(ctx, atlases, *cmd.run, { cmd.x, cmd.y });
+            else
+                ctx.draw_sprite_safe(cmd.sprite, atlases, cmd.x, cmd.y, cmd.w, cmd.h);
+        }
+    }
+
+    // One queue entry per window; the list is shared, never copied.
+    void submit_draw_list(std::shared_ptr<const GuiDrawList> list)
+    {
+        core::Context* ctx = g_frame.ctx;
+        if (!ctx || !list || list->empty())
+            return;
+
+        if (ctx->windowData && g_frame.ctxShared) {
+            auto ctxShared = g_frame.ctxShared;
+            ctx->windowData->commandQueue.enqueue([ctxShared, list = std::move(list)]() {
+                if (ctxShared)
+                    replay_draw_list(*ctxShared, *list);
+            });
+            return;
+        }
+        replay_draw_list(*ctx, *list);
+    }
+
     //constexpr const char* kAtlasName = "__agui_builtin";
     //constexpr float kContentPadding = 8.0f;
     //constexpr float kFontScale = 1.0f;
@@ -414,6 +545,12 @@ namespace
         if (!handle.is_valid())
             return;
 
+        if (g_build.window) {
+            if (g_build.recording)
+                g_build.pending.push_back({ handle, x, y, w, h, {} });
+            return;
+        }
+
         core::Context* ctx = g_frame.ctx;
         if (!ctx)
             return;
@@ -441,6 +578,35 @@ namespace
         }
     }
 
+    // A whole shaped run goes through the command queue as one entry; the
+    // run is shared with the font cache rather than copied.
+    void draw_glyph_run(std::shared_ptr<const font::GlyphRun> run, float x, float y)
+    {
+        core::Context* ctx = g_frame.ctx;
+        if (!ctx || !run || run->quads.empty())
+            return;
+
+        if (g_build.window) {
+            if (g_build.recording)
+                g_build.pending.push_back({ {}, x, y, 0.0f, 0.0f, std::move(run) });
+            return;
+        }
+
+        if (ctx->windowData && g_frame.ctxShared) {
+            auto ctxShared = g_frame.ctxShared;
+            ctx->windowData->commandQueue.enqueue([ctxShared, run = std::move(run), x, y]() {
+                if (!ctxShared)
+                    return;
+                const auto& atlasesRT = almondnamespace::atlasmanager::get_atlas_vector();
+                font::FontRenderer::submit_run(*ctxShared, atlasesRT, *run, { x, y });
+            });
+            return;
+        }
+
+        const auto& atlases = almondnamespace::atlasmanager::get_atlas_vector();
+        font::FontRenderer::submit_run(*ctx, atlases, *run, { x, y });
+    }
+
     [[nodiscard]] bool point_in_rect(Vec2 point, float x, float y, float w, float h) noexcept
     {
         return (point.x >= x && point.x <= x + w && point.y >= y && point.y <= y + h);
@@ -596,6 +762,15 @@ namespace
         return (std::max)(baseHeight, totalHeight);
     }
 
+    [[nodiscard]] ConsoleWrapMetrics console_wrap_metrics(float width, float scale) noexcept
+    {
+        ConsoleWrapMetrics metrics{};
+        for (std::size_t ch = 0; ch < metrics.advance.size(); ++ch)
+            metrics.advance[ch] = glyph_advance(static_cast<unsigned char>(ch), scale);
+        metrics.width = width;
+        return metrics;
+    }
+
     [[nodiscard]] almondnamespace::gui::Vec2 compute_caret_position(std::string_view text, float x, float y, float width, float scale) noexcept
     {
         ensure_resources();
@@ -632,48 +807,14 @@ namespace
         if (!g_frame.ctx || !g_resources.font.asset)
             return 0.0f;
 
-        const float effectiveWidth = (std::max)(space_advance(scale), width);
-        const float lineAdvance = line_advance_amount(scale);
-        const float ascent = baseline_offset(scale);
-        const float baseHeight = base_line_height(scale);
-
-        float penX = x;
-        float baseline = y + ascent;
-        std::size_t lines = 1;
-
-        for (std::size_t i = 0; i < text.size(); ++i) {
-            const char ch = text[i];
-            if (ch == '\n') {
-                penX = x;
-                baseline += lineAdvance;
-                ++lines;
-                continue;
-            }
-
-            const auto next = next_drawable_char(text, i);
-            const float advance = glyph_advance_with_kerning(static_cast<unsigned char>(ch), next, scale);
-            if (penX + advance > x + effectiveWidth + 0.001f) {
-                penX = x;
-                baseline += lineAdvance;
-                ++lines;
-            }
-
-            if (ch != ' ' && ch != '\t') {
-                if (const auto* glyph = lookup_glyph(static_cast<unsigned char>(ch))) {
-                    const float drawW = glyph->size_px.x * scale;
-                    const float drawH = glyph->size_px.y * scale;
-                    if (glyph->handle.is_valid() && drawW > 0.0f && drawH > 0.0f) {
-                        const float offsetX = glyph->offset_px.x * scale;
-                        const float offsetY = glyph->offset_px.y * scale;
-                        draw_sprite(glyph->handle, penX + offsetX, baseline + offsetY, drawW, drawH);
-                    }
-                }
-            }
-
-            penX += advance;
-        }
-
-        return baseHeight + static_cast<float>(lines - 1) * lineAdvance;
+        font::RunLayout layout{};
+        layout.scale = scale;
+        layout.wrapWidth = (std::max)(1.0f, width);
+        layout.tabSpaces = kTabSpaces;
+        auto run = g_resources.fontRenderer.shape(g_resources.font.fontId, text, layout);
+        const float height = run->height;
+        draw_glyph_run(std::move(run), x, y);
+        return height;
     }
 
     void draw_caret(float x, float y, float height)
@@ -688,32 +829,22 @@ namespace
         if (!g_frame.ctx || !g_resources.font.asset)
             return;
 
-        const float anchorX = indent.value_or(x);
-        float penX = anchorX;
-        float baseline = y + baseline_offset(scale);
-        const float lineAdvance = line_advance_amount(scale);
-
-        for (std::size_t i = 0; i < text.size(); ++i) {
-            const char ch = text[i];
-            if (ch == '\n') {
-                penX = anchorX;
-                baseline += lineAdvance;
-                continue;
-            }
-
-            if (const auto* glyph = lookup_glyph(static_cast<unsigned char>(ch))) {
-                if (glyph->handle.is_valid()) {
-                    const float drawW = glyph->size_px.x * scale;
-                    const float drawH = glyph->size_px.y * scale;
-                    const float offsetX = glyph->offset_px.x * scale;
-                    const float offsetY = glyph->offset_px.y * scale;
-                    draw_sprite(glyph->handle, penX + offsetX, baseline + offsetY, drawW, drawH);
-                }
-            }
+        font::RunLayout layout{};
+        layout.scale = scale;
+        layout.tabSpaces = kTabSpaces;
+        draw_glyph_run(g_resources.fontRenderer.shape(g_resources.font.fontId, text, layout), indent.value_or(x), y);
+    }
 
-            const auto next = next_drawable_char(text, i);
-            penX += glyph_advance_with_kerning(static_cast<unsigned char>(ch), next, scale);
-        }
+    // Visible rows only: the log's row index finds the first one in O(log n)
+    // and wrapping was settled when each line was appended.
+    void draw_console_log(const ConsoleLog& log, std::size_t firstRow, std::size_t rowCount, float x, float y)
+    {
+        const float advance = line_advance_amount(kFontScale);
+        float penY = y;
+        log.for_each_row(firstRow, rowCount, [&](const ConsoleLog::Row& row) {
+            draw_text_line(row.text, x, penY, kFontScale);
+            penY += advance;
+        });
     }
 
     void reset_frame()
@@ -764,6 +895,7 @@ void begin_frame(const std::shared_ptr<core::Context>& ctx, float dt, Vec2 mouse
     g_frame.ctxShared = ctx;
     g_frame.ctx = rawCtx;
     g_frame.deltaTime = dt;
+    ++g_guiFrame;
 
     g_frame.caretTimer += dt;
     while (g_frame.caretTimer >= kCaretBlinkPeriod) {
@@ -809,6 +941,13 @@ void begin_frame(const std::shared_ptr<core::Context>& ctx, float dt, Vec2 mouse
 
 void end_frame() noexcept
 {
+    if (g_build.window)
+        end_window();
+
+    std::erase_if(g_retainedWindows, [](const auto& entry) {
+        return entry.second.lastFrame + kRetainedWindowTtl < g_guiFrame;
+    });
+
     g_frame.ctxShared.reset();
     g_frame.ctx = nullptr;
     g_frame.insideWindow = false;
@@ -824,15 +963,38 @@ void begin_window(std::string_view title, Vec2 position, Vec2 size) noexcept
 
     ensure_resources();
 
+    if (g_build.window)
+        end_window();
+
     g_frame.origin = position;
     g_frame.windowSize = size;
     g_frame.insideWindow = true;
     set_cursor({ position.x + kContentPadding, position.y + kContentPadding });
 
-    draw_sprite(g_resources.windowBackground, position.x, position.y, size.x, size.y);
+    const auto windowId = WidgetKey{}
+        .mix(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(g_frame.ctx)))
+        .mix(title).value;
+    RetainedWindow& window = g_retainedWindows[windowId];
+    window.lastFrame = g_guiFrame;
+    g_build.window = &window;
+    g_build.recording = false;
+
+    // A reloaded font or evicted dynamic glyphs invalidate every cached run.
+    // Reloads keep the asset's address, so the key uses its generation; the
+    // reload also brings a fresh glyph cache whose epoch restarts at 0.
+    const auto* fontAsset = g_resources.font.asset;
+    const std::uint64_t fontGeneration = fontAsset ? fontAsset->generation : 0;
+    const std::uint64_t glyphEpoch = (fontAsset && fontAsset->dynamicGlyphs) ? fontAsset->dynamicGlyphs->epoch() : 0;
+    const auto key = WidgetKey{}.mix(title).mix(position).mix(size)
+        .mix(static_cast<std::uint64_t>(g_resources.font.fontId))
+        .mix(fontGeneration).mix(glyphEpoch).value;
 
     const float titleHeight = base_line_height(kTitleScale);
-    draw_text_line(title, position.x + kContentPadding, position.y + kContentPadding, kTitleScale);
+    if (!begin_widget(key)) {
+        draw_sprite(g_resources.windowBackground, position.x, position.y, size.x, size.y);
+        draw_text_line(title, position.x + kContentPadding, position.y + kContentPadding, kTitleScale);
+        end_widget();
+    }
 
     advance_cursor({ 0.0f, titleHeight + kContentPadding });
 }
@@ -840,6 +1002,30 @@ void begin_window(std::string_view title, Vec2 position, Vec2 size) noexcept
 void end_window() noexcept
 {
     g_frame.insideWindow = false;
+
+    auto& b = g_build;
+    if (!b.window)
+        return;
+
+    RetainedWindow& window = *b.window;
+    if (!b.recording && b.widgets.size() != window.widgets.size()) {
+        // Trailing widgets disappeared: keep the prefix that still matches.
+        const std::size_t keep = b.widgets.empty() ? 0 : b.widgets.back().end;
+        b.pending.assign(window.commands->begin(), window.commands->begin() + static_cast<std::ptrdiff_t>(keep));
+        b.recording = true;
+    }
+
+    if (b.recording) {
+        window.commands = std::make_shared<const GuiDrawList>(std::move(b.pending));
+        window.widgets.swap(b.widgets);
+    }
+
+    b.window = nullptr;
+    b.recording = false;
+    b.pending.clear();
+    b.widgets.clear();
+
+    submit_draw_list(window.commands);
 }
 
 bool button(std::string_view label, Vec2 size) noexcept
@@ -859,13 +1045,16 @@ bool button(std::string_view label, Vec2 size) noexcept
         ? (g_frame.mouseDown ? g_resources.buttonActive : g_resources.buttonHover)
         : g_resources.buttonNormal;
 
-    draw_sprite(background, pos.x, pos.y, width, height);
+    if (!begin_widget(WidgetKey{}.mix(pos).mix(width).mix(height).mix(background).mix(label).value)) {
+        draw_sprite(background, pos.x, pos.y, width, height);
 
-    const float textWidth = measure_text_width(label, kFontScale);
-    const float textHeight = baseHeight;
-    const float textX = pos.x + (std::max)(0.0f, (width - textWidth) * 0.5f);
-    const float textY = pos.y + (std::max)(0.0f, (height - textHeight) * 0.5f);
-    draw_text_line(label, textX, textY, kFontScale);
+        const float textWidth = measure_text_width(label, kFontScale);
+        const float textHeight = baseHeight;
+        const float textX = pos.x + (std::max)(0.0f, (width - textWidth) * 0.5f);
+        const float textY = pos.y + (std::max)(0.0f, (height - textHeight) * 0.5f);
+        draw_text_line(label, textX, textY, kFontScale);
+        end_widget();
+    }
 
     g_frame.lastButtonBounds = WidgetBounds{ pos, { width, height } };
     advance_cursor({ 0.0f, height + kContentPadding });
@@ -889,9 +1078,12 @@ bool image_button(const SpriteHandle& sprite, Vec2 size) noexcept
         ? (g_frame.mouseDown ? g_resources.buttonActive : g_resources.buttonHover)
         : g_resources.buttonNormal;
 
-    draw_sprite(background, pos.x, pos.y, width, height);
-    if (sprite.is_valid()) {
-        draw_sprite(sprite, pos.x, pos.y, width, height);
+    if (!begin_widget(WidgetKey{}.mix(pos).mix(width).mix(height).mix(background).mix(sprite).value)) {
+        draw_sprite(background, pos.x, pos.y, width, height);
+        if (sprite.is_valid()) {
+            draw_sprite(sprite, pos.x, pos.y, width, height);
+        }
+        end_widget();
     }
 
     g_frame.lastButtonBounds = WidgetBounds{ pos, { width, height } };
@@ -935,21 +1127,6 @@ EditBoxResult edit_box(std::string& text, Vec2 size, std::size_t max_chars, bool
     const bool active = (g_activeWidget == id);
     result.active = active;
 
-    const SpriteHandle background = active ? g_resources.textFieldActive : g_resources.textField;
-    draw_sprite(background, pos.x, pos.y, width, height);
-
-    const float contentWidth = (std::max)(1.0f, width - 2.0f * kBoxInnerPadding);
-    const float contentHeight = (std::max)(1.0f, height - 2.0f * kBoxInnerPadding);
-    const float textX = pos.x + kBoxInnerPadding;
-    const float textY = pos.y + kBoxInnerPadding;
-
-    if (multiline) {
-        draw_wrapped_text(text, textX, textY, contentWidth, kFontScale);
-    }
-    else {
-        draw_text_line(text, textX, textY, kFontScale);
-    }
-
     const std::size_t limit = max_chars == 0 ? std::numeric_limits<std::size_t>::max() : max_chars;
 
     if (active) {
@@ -1008,19 +1185,42 @@ EditBoxResult edit_box(std::string& text, Vec2 size, std::size_t max_chars, bool
         }
     }
 
-    if (active && g_frame.caretVisible) {
-        const Vec2 caret = multiline
-            ? compute_caret_position(text, textX, textY, contentWidth, kFontScale)
-            : Vec2{ textX + measure_text_width(text, kFontScale), textY };
+    // Input is applied before drawing so the frame shows the edited text.
+    const bool caretShown = result.active && g_frame.caretVisible;
+    const auto key = WidgetKey{}.mix(pos).mix(width).mix(height).mix(multiline)
+        .mix(result.active).mix(caretShown).mix(std::string_view{ text }).value;
+    if (!begin_widget(key)) {
+        const SpriteHandle background = result.active ? g_resources.textFieldActive : g_resources.textField;
+        draw_sprite(background, pos.x, pos.y, width, height);
+
+        const float contentWidth = (std::max)(1.0f, width - 2.0f * kBoxInnerPadding);
+        const float contentHeight = (std::max)(1.0f, height - 2.0f * kBoxInnerPadding);
+        const float textX = pos.x + kBoxInnerPadding;
+        const float textY = pos.y + kBoxInnerPadding;
+
+        if (multiline) {
+            draw_wrapped_text(text, textX, textY, contentWidth, kFontScale);
+        }
+        else {
+            draw_text_line(text, textX, textY, kFontScale);
+        }
+
+        if (caretShown) {
+            const Vec2 caret = multiline
+                ? compute_caret_position(text, textX, textY, contentWidth, kFontScale)
+                : Vec2{ textX + measure_text_width(text, kFontScale), textY };
+
+            const float caretHeight = multiline
+                ? (std::min)(contentHeight, baseHeight)
+                : baseHeight;
 
-        const float caretHeight = multiline
-            ? (std::min)(contentHeight, baseHeight)
-            : baseHeight;
+            const float caretRight = textX + (std::max)(1.0f, contentWidth) - 1.0f;
+            const float caretX = std::clamp(caret.x, textX, caretRight);
+            const float caretY = std::clamp(caret.y, textY, textY + (std::max)(0.0f, contentHeight - caretHeight));
+            draw_caret(caretX, caretY, caretHeight);
+        }
 
-        const float caretRight = textX + (std::max)(1.0f, contentWidth) - 1.0f;
-        const float caretX = std::clamp(caret.x, textX, caretRight);
-        const float caretY = std::clamp(caret.y, textY, textY + (std::max)(0.0f, contentHeight - caretHeight));
-        draw_caret(caretX, caretY, caretHeight);
+        end_widget();
     }
 
     advance_cursor({ 0.0f, height + kContentPadding });
@@ -1035,6 +1235,11 @@ void text_box(std::string_view text, Vec2 size) noexcept
     ensure_resources();
 
     const Vec2 pos = g_frame.cursor;
+    if (const WidgetRecord* cached = begin_widget(WidgetKey{}.mix(pos).mix(size).mix(text).value)) {
+        advance_cursor({ 0.0f, cached->extent.y + kContentPadding });
+        return;
+    }
+
     const float baseHeight = base_line_height(kFontScale);
     const float minWidth = space_advance(kFontScale) * 4.0f;
     float width = static_cast<float>(size.x);
@@ -1058,6 +1263,7 @@ void text_box(std::string_view text, Vec2 size) noexcept
 
     draw_sprite(g_resources.panelBackground, pos.x, pos.y, width, height);
     draw_wrapped_text(text, pos.x + kBoxInnerPadding, pos.y + kBoxInnerPadding, contentWidth, kFontScale);
+    end_widget({ width, height });
 
     advance_cursor({ 0.0f, height + kContentPadding });
 }
@@ -1080,27 +1286,63 @@ ConsoleWindowResult console_window(const ConsoleWindowOptions& options) noexcept
     const float logHeight = (std::max)(0.0f, options.size.y - 3.0f * kContentPadding - base_line_height(kFontScale));
     const Vec2 logPos = g_frame.cursor;
 
-    if (availableWidth > 0.0f && logHeight > 0.0f) {
-        draw_sprite(g_resources.consoleBackground, logPos.x, logPos.y, availableWidth, logHeight);
+    if (options.log) {
+        ConsoleLog& log = *options.log;
+        log.drain_pending();
+
+        const float contentWidth = (std::max)(1.0f, availableWidth - 2.0f * kBoxInnerPadding);
+        log.set_wrap(console_wrap_metrics(contentWidth, kFontScale));
+
+        const float rowAdvance = line_advance_amount(kFontScale);
+        const float rowsHeight = (std::max)(0.0f, logHeight - 2.0f * kBoxInnerPadding);
+        const std::size_t visibleRows = rowAdvance > 0.0f ? static_cast<std::size_t>(rowsHeight / rowAdvance) : 0;
+        const std::size_t totalRows = log.total_rows();
+        result.max_scroll_rows = totalRows > visibleRows ? totalRows - visibleRows : 0;
+        const std::size_t firstRow = result.max_scroll_rows - (std::min)(options.scroll_rows, result.max_scroll_rows);
+
+        // The log's version stands in for its text, so the key is O(1).
+        const auto key = WidgetKey{}.mix(logPos).mix(availableWidth).mix(logHeight)
+            .mix(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(&log)))
+            .mix(log.version()).mix(static_cast<std::uint64_t>(firstRow)).value;
+        if (!begin_widget(key)) {
+            if (availableWidth > 0.0f && logHeight > 0.0f) {
+                draw_sprite(g_resources.consoleBackground, logPos.x, logPos.y, availableWidth, logHeight);
+            }
+            draw_console_log(log, firstRow, visibleRows, logPos.x + kBoxInnerPadding, logPos.y + kBoxInnerPadding);
+            end_widget();
+        }
     }
-
-    const float contentWidth = (std::max)(1.0f, availableWidth - 2.0f * kBoxInnerPadding);
-    float penY = logPos.y + kBoxInnerPadding;
-    const float maxY = logPos.y + (std::max)(0.0f, logHeight - kBoxInnerPadding);
-
-    if (!options.lines.empty() && logHeight > 0.0f) {
-        const std::size_t count = options.lines.size();
-        const std::size_t start = (count > options.max_visible_lines)
-            ? count - options.max_visible_lines
+    else {
+        const std::size_t lineCount = options.lines.size();
+        const std::size_t firstLine = (lineCount > options.max_visible_lines)
+            ? lineCount - options.max_visible_lines
             : 0;
-        for (std::size_t i = start; i < count; ++i) {
-            const std::string& line = options.lines[i];
-            const float drawn = draw_wrapped_text(line, logPos.x + kBoxInnerPadding, penY, contentWidth, kFontScale);
-            const float paragraphGap = (std::max)(0.0f, line_advance_amount(kFontScale) - base_line_height(kFontScale));
-            penY += drawn + paragraphGap;
-            if (penY > maxY) {
-                break;
+        WidgetKey logKey{};
+        logKey.mix(logPos).mix(availableWidth).mix(logHeight);
+        for (std::size_t i = firstLine; i < lineCount; ++i)
+            logKey.mix(std::string_view{ options.lines[i] });
+
+        if (!begin_widget(logKey.value)) {
+            if (availableWidth > 0.0f && logHeight > 0.0f) {
+                draw_sprite(g_resources.consoleBackground, logPos.x, logPos.y, availableWidth, logHeight);
             }
+
+            const float contentWidth = (std::max)(1.0f, availableWidth - 2.0f * kBoxInnerPadding);
+            float penY = logPos.y + kBoxInnerPadding;
+            const float maxY = logPos.y + (std::max)(0.0f, logHeight - kBoxInnerPadding);
+
+            if (!options.lines.empty() && logHeight > 0.0f) {
+                for (std::size_t i = firstLine; i < lineCount; ++i) {
+                    const std::string& line = options.lines[i];
+                    const float drawn = draw_wrapped_text(line, logPos.x + kBoxInnerPadding, penY, contentWidth, kFontScale);
+                    const float paragraphGap = (std::max)(0.0f, line_advance_amount(kFontScale) - base_line_height(kFontScale));
+                    penY += drawn + paragraphGap;
+                    if (penY > maxY) {
+                        break;
+                    }
+                }
+            }
+            end_widget();
         }
     }
 
@@ -1121,7 +1363,10 @@ void label(std::string_view text) noexcept
     if (!g_frame.insideWindow || !g_frame.ctx)
         return;
 
-    draw_text_line(text, g_frame.cursor.x, g_frame.cursor.y, kFontScale);
+    if (!begin_widget(WidgetKey{}.mix(g_frame.cursor).mix(text).value)) {
+        draw_text_line(text, g_frame.cursor.x, g_frame.cursor.y, kFontScale);
+        end_widget();
+    }
     advance_cursor({ 0.0f, line_advance_amount(kFontScale) });
 }
 